@@ -41,6 +41,9 @@ class HybridScanManager: NSObject, ObservableObject {
     private var arSession: ARSession?
     private var objectCaptureSession: ObjectCaptureSession?
     private var lidarData: LiDARData?
+    private var lidarMesh: MDLMesh?  // Surface fused from the LiDAR scan
+    private let ingestor = LiDARFrameIngestor()  // Depth frames, fused off the main thread
+    private var showsLiveDepth = false  // Per-frame point counts are shown only inside the scan window
     private var photogrammetryInput: URL?
 
     // Point cloud buffers
@@ -66,7 +69,6 @@ class HybridScanManager: NSObject, ObservableObject {
         var points: [SIMD3<Float>]
         var normals: [SIMD3<Float>]
         var confidence: [Float]
-        var colors: [SIMD3<Float>]
         var timestamp: Date
 
         var qualityScore: Double {
@@ -92,8 +94,16 @@ class HybridScanManager: NSObject, ObservableObject {
             return
         }
 
+        // Frames are delivered straight to the ingestor's serial queue
         arSession = ARSession()
-        arSession?.delegate = self
+        arSession?.delegate = ingestor
+        arSession?.delegateQueue = ingestor.queue
+        ingestor.onFrameIngested = { [weak self] pointCount in
+            Task { @MainActor in
+                guard let self, self.showsLiveDepth else { return }
+                self.lidarPointCount = pointCount
+            }
+        }
     }
 
     // MARK: - Public API
@@ -120,9 +130,15 @@ class HybridScanManager: NSObject, ObservableObject {
             try await enhanceWithAI()
         }
 
-        // Phase 4: Photogrammetry (Final high-quality mesh)
+        // Phase 4: Photogrammetry (Final high-quality mesh); without photos
+        // the surface fused from the LiDAR scan is the model
         currentPhase = .photogrammetry
-        let finalMesh = try await runPhotogrammetry()
+        let finalMesh: URL
+        if config.usePhotogrammetry {
+            finalMesh = try await runPhotogrammetry()
+        } else {
+            finalMesh = try exportLiDARMesh()
+        }
 
         // Phase 5: Mesh Optimization
         currentPhase = .meshOptimization
@@ -141,15 +157,36 @@ class HybridScanManager: NSObject, ObservableObject {
         configuration.sceneReconstruction = .meshWithClassification
         configuration.frameSemantics = [.sceneDepth, .smoothedSceneDepth]
 
+        // Confidence levels are 0 (low), 1 (medium), 2 (high)
+        ingestor.begin(minConfidence: UInt8(min(max((config.confidenceThreshold * 2).rounded(.up), 0), 2)))
+        showsLiveDepth = true
         arSession?.run(configuration)
 
-        // Scan for 3-5 seconds to accumulate LiDAR data
-        try await Task.sleep(for: .seconds(3))
+        // Scan for 3-5 seconds to accumulate LiDAR data; frames are only
+        // fused inside this window, so the volume stops growing afterwards
+        do {
+            defer { stopDepthCapture() }
+            try await Task.sleep(for: .seconds(3))
+        }
+
+        // The surface fused from every frame is the scan result
+        if let fused = fusedLiDARData() {
+            lidarData = fused
+            lidarPointCount = fused.points.count
+        }
+        lidarMesh = fusedLiDARMesh()
 
         print("✅ LiDAR scan complete: \(lidarPointCount) points")
         estimatedQuality = lidarData?.qualityScore ?? 0.0
     }
 
+    /// Close the scan window: later frames are ignored and the session stops
+    private func stopDepthCapture() {
+        showsLiveDepth = false
+        ingestor.finish()
+        arSession?.pause()
+    }
+
     // MARK: - Phase 2: Photo Capture
 
     private func capturePhotos() async throws {
@@ -271,6 +308,24 @@ class HybridScanManager: NSObject, ObservableObject {
         throw ScanError.photogrammetryFailed(nil)
     }
 
+    /// Write the fused LiDAR surface next to the images directory
+    private func exportLiDARMesh() throws -> URL {
+        guard let photogrammetryInput else {
+            throw ScanError.noImagesDirectory
+        }
+        guard let lidarMesh else {
+            throw ScanError.invalidMesh
+        }
+
+        let outputFile = photogrammetryInput.deletingLastPathComponent().appendingPathComponent("lidar_model.usdz")
+        let asset = MDLAsset()
+        asset.add(lidarMesh)
+        try asset.export(to: outputFile)
+
+        print("✅ LiDAR mesh exported: \(lidarMesh.vertexCount) vertices")
+        return outputFile
+    }
+
     // MARK: - Phase 5: Mesh Optimization
 
     private func optimizeMesh(_ url: URL) async throws -> URL {
@@ -363,18 +418,60 @@ class HybridScanManager: NSObject, ObservableObject {
     }
 }
 
-// MARK: - ARSessionDelegate
+// MARK: - LiDAR Ingestion
+
+/// Fuses AR depth frames on a serial background queue, which the session
+/// delivers frames to, so neither unprojection nor TSDF integration runs on
+/// the main thread. Frames are taken only between begin() and finish()
+final class LiDARFrameIngestor: NSObject, ARSessionDelegate, @unchecked Sendable {
+
+    let queue = DispatchQueue(label: "lidar.ingest", qos: .userInitiated)
 
-extension HybridScanManager: ARSessionDelegate {
+    /// Depth samples fused from the latest frame, called on `queue`
+    var onFrameIngested: ((Int) -> Void)?
+
+    // Owned by `queue`
+    private let fusion = TsdfBridge(voxelSize: 0.005, truncation: 0.02)  // Every depth frame, fused
+    private var isCapturing = false
+    private var minConfidence: UInt8 = 1
+
+    /// Empty the volume and start taking frames
+    func begin(minConfidence: UInt8) {
+        queue.sync {
+            fusion.reset()
+            self.minConfidence = minConfidence
+            isCapturing = true
+        }
+    }
+
+    /// Stop taking frames; returns once the frame in flight is fused
+    func finish() {
+        queue.sync {
+            isCapturing = false
+        }
+    }
+
+    /// Surface samples of the fused volume; release with TsdfBridge.cleanupSurfaceResult
+    func extractSurface(minWeight: Float) -> UnsafeMutablePointer<TsdfSurfaceResult>? {
+        queue.sync {
+            fusion.extractSurface(withMinWeight: minWeight)
+        }
+    }
+
+    /// Marching cubes mesh of the fused volume; release with TsdfBridge.cleanupMeshResult
+    func extractMesh(minWeight: Float) -> UnsafeMutablePointer<TsdfMeshResult>? {
+        queue.sync {
+            fusion.extractMesh(withMinWeight: minWeight)
+        }
+    }
 
     func session(_ session: ARSession, didUpdate frame: ARFrame) {
-        // Extract LiDAR depth data
-        guard let depthData = frame.sceneDepth else { return }
+        guard isCapturing, let depthData = frame.sceneDepth else { return }
 
-        extractLiDARData(from: depthData, frame: frame)
+        ingest(depthData, frame: frame)
     }
 
-    private func extractLiDARData(from sceneDepth: ARDepthData, frame: ARFrame) {
+    private func ingest(_ sceneDepth: ARDepthData, frame: ARFrame) {
         let depthMap = sceneDepth.depthMap
 
         // Safe unwrap of confidenceMap - might be nil on some devices
@@ -399,52 +496,146 @@ extension HybridScanManager: ARSessionDelegate {
             return
         }
 
+        // Intrinsics refer to the captured color image; rescale to the depth map
+        let camera = frame.camera
+        let scale = Float(width) / Float(camera.imageResolution.width)
+        var intrinsics = camera.intrinsics
+        intrinsics.columns.0.x *= scale
+        intrinsics.columns.1.y *= scale
+        intrinsics.columns.2.x *= scale
+        intrinsics.columns.2.y *= scale
+
+        let depthRowBytes = UInt(CVPixelBufferGetBytesPerRow(depthMap))
+        let confidenceRowBytes = UInt(CVPixelBufferGetBytesPerRow(confidenceMap))
+
+        // Fuse into the TSDF volume so no frame is thrown away; this is the
+        // frame's only unprojection
+        let samples = fusion.integrateDepth(
+            depthPtr,
+            depthRowBytes: depthRowBytes,
+            confidence: confidencePtr,
+            confidenceRowBytes: confidenceRowBytes,
+            width: UInt(width),
+            height: UInt(height),
+            intrinsics: intrinsics,
+            pose: camera.transform,
+            minConfidence: minConfidence
+        )
+        guard samples > 0 else {
+            return
+        }
+
+        // Live feedback only: the scan result is the fused surface, taken
+        // from the volume when the window closes
+        onFrameIngested?(Int(samples))
+    }
+}
+
+// MARK: - TSDF Fusion
+
+extension HybridScanManager {
+
+    /// Surface samples of the TSDF volume fused from every LiDAR frame so far
+    /// Normals come from the distance field and point into observed free space
+    private func fusedLiDARData(minWeight: Float = 2) -> LiDARData? {
+        guard let result = ingestor.extractSurface(minWeight: minWeight) else {
+            return nil
+        }
+
+        defer {
+            TsdfBridge.cleanupSurfaceResult(result)
+        }
+
+        // TsdfSurfaceResult layout: points, normals, weights, pointCount, success, errorMessage
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let count = resultPtr.load(fromByteOffset: pointerStride * 3, as: Int.self)
+        let success = resultPtr.load(fromByteOffset: pointerStride * 3 + MemoryLayout<Int>.stride, as: Bool.self)
+
+        guard success, count > 0,
+              let pointData = resultPtr.load(as: UnsafeMutablePointer<Float>?.self),
+              let normalData = resultPtr.load(fromByteOffset: pointerStride, as: UnsafeMutablePointer<Float>?.self),
+              let weightData = resultPtr.load(fromByteOffset: pointerStride * 2, as: UnsafeMutablePointer<Float>?.self) else {
+            return nil
+        }
+
         var points: [SIMD3<Float>] = []
         var normals: [SIMD3<Float>] = []
         var confidence: [Float] = []
-        var colors: [SIMD3<Float>] = []
-
-        let camera = frame.camera
-        let viewMatrix = camera.viewMatrix(for: .portrait)
-        let projectionMatrix = camera.projectionMatrix(for: .portrait, viewportSize: CGSize(width: width, height: height), zNear: 0.001, zFar: 100)
-
-        // Sample every Nth pixel for performance
-        let stride = 4
-
-        for y in stride(from: 0, to: height, by: stride) {
-            for x in stride(from: 0, to: width, by: stride) {
-                let index = y * width + x
-                let depth = depthPtr[index]
-                let conf = Float(confidencePtr[index]) / 255.0
-
-                // Filter by confidence threshold
-                guard conf >= config.confidenceThreshold else { continue }
-
-                // Convert to 3D point
-                let u = Float(x) / Float(width)
-                let v = Float(y) / Float(height)
-
-                let point = camera.unprojectPoint(
-                    SIMD3<Float>(u, v, depth),
-                    ontoPlaneWithTransform: viewMatrix.inverse
-                )
-
-                points.append(point)
-                normals.append(SIMD3<Float>(0, 1, 0)) // Placeholder
-                confidence.append(conf)
-                colors.append(SIMD3<Float>(1, 1, 1)) // Placeholder
-            }
+        points.reserveCapacity(count)
+        normals.reserveCapacity(count)
+        confidence.reserveCapacity(count)
+        for i in 0..<count {
+            points.append(SIMD3<Float>(pointData[i * 3], pointData[i * 3 + 1], pointData[i * 3 + 2]))
+            normals.append(SIMD3<Float>(normalData[i * 3], normalData[i * 3 + 1], normalData[i * 3 + 2]))
+            confidence.append(min(weightData[i] / 8, 1))
         }
 
-        lidarData = LiDARData(
+        return LiDARData(
             points: points,
             normals: normals,
             confidence: confidence,
-            colors: colors,
             timestamp: Date()
         )
+    }
+
+    /// Marching cubes mesh of the same volume, with per-vertex normals
+    private func fusedLiDARMesh(minWeight: Float = 2) -> MDLMesh? {
+        guard let result = ingestor.extractMesh(minWeight: minWeight) else {
+            return nil
+        }
+
+        defer {
+            TsdfBridge.cleanupMeshResult(result)
+        }
+
+        // TsdfMeshResult layout: vertices, indices, vertexCount, indexCount, success, errorMessage, normals
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let vertexCount = resultPtr.load(fromByteOffset: pointerStride * 2, as: Int.self)
+        let indexCount = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride, as: Int.self)
+        let success = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride * 2, as: Bool.self)
+        let normalsOffset = pointerStride * 2 + MemoryLayout<Int>.stride * 3 + pointerStride
+
+        guard success, indexCount > 0,
+              let vertexData = resultPtr.load(as: UnsafeMutablePointer<Float>?.self),
+              let indexData = resultPtr.load(fromByteOffset: pointerStride, as: UnsafeMutablePointer<UInt32>?.self),
+              let normalData = resultPtr.load(fromByteOffset: normalsOffset, as: UnsafeMutablePointer<Float>?.self) else {
+            return nil
+        }
+
+        // Interleave position and normal per vertex
+        var interleaved: [Float] = []
+        interleaved.reserveCapacity(vertexCount * 6)
+        for i in 0..<vertexCount {
+            interleaved.append(contentsOf: [vertexData[i * 3], vertexData[i * 3 + 1], vertexData[i * 3 + 2],
+                                            normalData[i * 3], normalData[i * 3 + 1], normalData[i * 3 + 2]])
+        }
+
+        let allocator = MDLMeshBufferDataAllocator()
+        let vertexBuffer = allocator.newBuffer(with: interleaved.withUnsafeBytes { Data($0) }, type: .vertex)
+        let indexBuffer = allocator.newBuffer(with: Data(bytes: indexData, count: indexCount * MemoryLayout<UInt32>.stride),
+                                              type: .index)
+
+        let descriptor = MDLVertexDescriptor()
+        descriptor.attributes[0] = MDLVertexAttribute(name: MDLVertexAttributePosition, format: .float3, offset: 0, bufferIndex: 0)
+        descriptor.attributes[1] = MDLVertexAttribute(name: MDLVertexAttributeNormal, format: .float3, offset: 12, bufferIndex: 0)
+        descriptor.layouts[0] = MDLVertexBufferLayout(stride: 24)
+
+        let submesh = MDLSubmesh(
+            indexBuffer: indexBuffer,
+            indexCount: indexCount,
+            indexType: .uInt32,
+            geometryType: .triangles,
+            material: nil
+        )
 
-        lidarPointCount = points.count
+        return MDLMesh(
+            vertexBuffer: vertexBuffer,
+            vertexCount: vertexCount,
+            descriptor: descriptor,
+            submeshes: [submesh]
+        )
     }
 }
 
@@ -627,6 +627,12 @@ class MeshAnalyzer: ObservableObject {
         return result.simplifiedMesh
     }
 
+    /// LOD chain behind the last auto-simplification; its levels share one
+    /// vertex buffer, so switching between them costs no simplification
+    var lodChain: QuadricErrorMetrics.LODChain? {
+        meshSimplifier.lodChain
+    }
+
     /// Get simplification progress
     var simplificationProgress: Double {
         meshSimplifier.progress
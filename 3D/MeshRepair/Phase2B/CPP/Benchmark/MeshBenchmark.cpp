@@ -0,0 +1,678 @@
+//
+//  MeshBenchmark.cpp
+//  3D
+//
+//  Google Benchmark harness for the Phase2B mesh core
+//
+//  Usage:
+//    mesh_benchmark [benchmark flags] [--depth=N] [--long] [file.ply ...]
+//
+//  PLY files with faces run MeshFix repair, Taubin smoothing, QEM
+//  simplification (single target and LOD chain) and vertex clustering
+//  (in memory and streamed from the file); PLY files with normals and no
+//  faces run k-NN search, PCA normals, normal orientation, Poisson
+//  reconstruction and sparse voxel repair. Without files a synthetic set
+//  of 10k-1M element inputs is used (--long adds 2M and 5M), plus
+//  synthetic depth maps for LiDAR frame unprojection and TSDF fusion, and
+//  voxel shells for bit-packed morphology. MeshFix reports per-stage
+//  throughput from RepairReport in triangles per second.
+//
+
+#include "DepthUnprojection.hpp"
+#include "KdTree.hpp"
+#include "MeshClustering.hpp"
+#include "MeshFixWrapper.hpp"
+#include "MeshSimplification.hpp"
+#include "MeshSmoothing.hpp"
+#include "NormalEstimation.hpp"
+#include "PoissonWrapper.hpp"
+#include "SparseVoxelGrid.hpp"
+#include "TsdfVolume.hpp"
+#include "VoxelMorphology.hpp"
+#include "VoxelSurface.hpp"
+#include "PlyFile.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace mesh;
+
+// Inputs must outlive the registered benchmarks
+std::deque<MeshData> inputs;
+
+// ============================================================
+// PLY Inputs
+// ============================================================
+
+struct PlyVertex {
+    float values[6];  // x y z nx ny nz
+};
+
+struct PlyFace {
+    unsigned int count;
+    unsigned int* indices;
+};
+
+/// Vertices (with normals when the file has nx, ny and nz) and faces,
+/// fan-triangulated, read through the vendored PoissonRecon PlyFile
+MeshData loadPly(const std::string& path) {
+    using PoissonRecon::PlyFile;
+    using PoissonRecon::PlyProperty;
+
+    std::vector<std::string> elements;
+    int fileType = 0;
+    float version = 0.0f;
+    std::unique_ptr<PlyFile> ply(PlyFile::Read(path, elements, fileType, version));
+    if (!ply) {
+        throw std::runtime_error("Could not open PLY file: " + path);
+    }
+
+    MeshData mesh;
+    for (std::string& name : elements) {
+        size_t count = 0;
+        ply->get_element_description(name, count);
+
+        if (name == "vertex") {
+            const char* names[6] = {"x", "y", "z", "nx", "ny", "nz"};
+            bool hasNormals = true;
+            for (int a = 0; a < 6; ++a) {
+                const PlyProperty property(names[a], PLY_FLOAT, PLY_FLOAT,
+                                           static_cast<int>(offsetof(PlyVertex, values) + a * sizeof(float)));
+                if (!ply->get_property(name, &property)) {
+                    if (a < 3) {
+                        throw std::runtime_error("PLY vertices lack x, y or z");
+                    }
+                    hasNormals = false;
+                }
+            }
+            mesh.vertices.reserve(count * 3);
+            if (hasNormals) {
+                mesh.normals.reserve(count * 3);
+            }
+            for (size_t v = 0; v < count; ++v) {
+                PlyVertex vertex = {{0, 0, 0, 0, 0, 0}};
+                ply->get_element(&vertex);
+                mesh.addVertex(Point3D(vertex.values[0], vertex.values[1], vertex.values[2]));
+                if (hasNormals) {
+                    mesh.normals.push_back(vertex.values[3]);
+                    mesh.normals.push_back(vertex.values[4]);
+                    mesh.normals.push_back(vertex.values[5]);
+                }
+            }
+        } else if (name == "face") {
+            PlyProperty property("vertex_indices", PLY_UINT, PLY_UINT,
+                                 static_cast<int>(offsetof(PlyFace, indices)), 1, PLY_UINT,
+                                 PLY_UINT, static_cast<int>(offsetof(PlyFace, count)));
+            if (!ply->get_property(name, &property)) {
+                property.name = "vertex_index";
+                if (!ply->get_property(name, &property)) {
+                    throw std::runtime_error("PLY faces lack vertex_indices");
+                }
+            }
+            mesh.indices.reserve(count * 3);
+            for (size_t f = 0; f < count; ++f) {
+                PlyFace face = {0, nullptr};
+                ply->get_element(&face);
+                const std::unique_ptr<unsigned int, decltype(&std::free)> owned(face.indices, &std::free);
+                for (unsigned int k = 2; k < face.count; ++k) {
+                    mesh.addTriangle(face.indices[0], face.indices[k - 1], face.indices[k]);
+                }
+            }
+        } else {
+            ply->get_other_element(name, count);
+        }
+    }
+
+    return mesh;
+}
+
+// ============================================================
+// Synthetic Inputs
+// ============================================================
+
+/// Wavy grid of roughly `triangles` triangles with a small hole every
+/// 64 cells and one floater triangle per hole
+MeshData makeGridMesh(size_t triangles) {
+    const size_t n = std::max<size_t>(8, static_cast<size_t>(std::sqrt(triangles / 2.0)));
+    MeshData mesh;
+    mesh.vertices.reserve((n + 1) * (n + 1) * 3);
+    mesh.indices.reserve(n * n * 6);
+
+    for (size_t j = 0; j <= n; ++j) {
+        for (size_t i = 0; i <= n; ++i) {
+            const float x = static_cast<float>(i);
+            const float y = static_cast<float>(j);
+            mesh.addVertex(Point3D(x, y, 0.5f * std::sin(x * 0.1f) * std::cos(y * 0.1f)));
+        }
+    }
+
+    auto id = [n](size_t i, size_t j) { return static_cast<uint32_t>(j * (n + 1) + i); };
+    size_t holes = 0;
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t i = 0; i < n; ++i) {
+            const bool hole = (i % 64) >= 30 && (i % 64) < 33 && (j % 64) >= 30 && (j % 64) < 33;
+            if (hole) {
+                holes += (i % 64) == 30 && (j % 64) == 30;
+                continue;
+            }
+            mesh.addTriangle(id(i, j), id(i + 1, j), id(i + 1, j + 1));
+            mesh.addTriangle(id(i, j), id(i + 1, j + 1), id(i, j + 1));
+        }
+    }
+
+    for (size_t h = 0; h < holes; ++h) {
+        const uint32_t base = static_cast<uint32_t>(mesh.vertexCount());
+        const float x = static_cast<float>(h % n);
+        mesh.addVertex(Point3D(x, -10.0f, 0.0f));
+        mesh.addVertex(Point3D(x + 1.0f, -10.0f, 0.0f));
+        mesh.addVertex(Point3D(x, -9.0f, 0.0f));
+        mesh.addTriangle(base, base + 1, base + 2);
+    }
+
+    return mesh;
+}
+
+/// Fibonacci-sphere point cloud with exact outward normals
+MeshData makeSphereCloud(size_t points) {
+    MeshData cloud;
+    cloud.vertices.reserve(points * 3);
+    cloud.normals.reserve(points * 3);
+
+    const float golden = static_cast<float>(M_PI * (3.0 - std::sqrt(5.0)));
+    for (size_t i = 0; i < points; ++i) {
+        const float y = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(points);
+        const float r = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        const float theta = golden * static_cast<float>(i);
+        const Point3D p(r * std::cos(theta), y, r * std::sin(theta));
+        cloud.addVertex(p);
+        cloud.normals.push_back(p.x);
+        cloud.normals.push_back(p.y);
+        cloud.normals.push_back(p.z);
+    }
+
+    return cloud;
+}
+
+/// Depth map of a wavy wall about 1.5 m away, with confidence levels
+/// cycling through low/medium/high
+void makeDepthMap(size_t width, size_t height, std::vector<float>& depth, std::vector<uint8_t>& confidence) {
+    depth.resize(width * height);
+    confidence.resize(width * height);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            const float u = static_cast<float>(x) / static_cast<float>(width);
+            const float v = static_cast<float>(y) / static_cast<float>(height);
+            depth[y * width + x] = 1.5f + 0.1f * std::sin(u * 12.0f) * std::cos(v * 9.0f);
+            confidence[y * width + x] = static_cast<uint8_t>((x + y) % 3);
+        }
+    }
+}
+
+/// Closed spherical shell with a one-voxel slot filling an n^3 volume
+BitVolume makeShellVolume(size_t n) {
+    BitVolume volume(n, n, n);
+    const float center = 0.5f * static_cast<float>(n);
+    const float radius = 0.4f * static_cast<float>(n);
+    for (size_t x = 0; x < n; ++x) {
+        for (size_t y = 0; y < n; ++y) {
+            for (size_t z = 0; z < n; ++z) {
+                const float dx = static_cast<float>(x) - center;
+                const float dy = static_cast<float>(y) - center;
+                const float dz = static_cast<float>(z) - center;
+                const float r = std::sqrt(dx * dx + dy * dy + dz * dz);
+                if (std::fabs(r - radius) < 1.5f && !(dz > 0.9f * radius && x == n / 2)) {
+                    volume.set(x, y, z);
+                }
+            }
+        }
+    }
+    return volume;
+}
+
+// ============================================================
+// Benchmarks
+// ============================================================
+
+void reportRate(benchmark::State& state, const char* name, double items, double ms) {
+    if (ms > 0.0) {
+        state.counters[name] = benchmark::Counter(items / (ms / 1000.0));
+    }
+}
+
+void BM_MeshFixRepair(benchmark::State& state, const MeshData* input) {
+    MeshFixWrapper wrapper;
+    MeshFixWrapper::Configuration config;
+    config.verbose = false;
+
+    MeshFixWrapper::RepairReport total;
+    MeshFixWrapper::RepairReport report;
+    for (auto _ : state) {
+        MeshData output = wrapper.repair(*input, config, report);
+        benchmark::DoNotOptimize(output.indices.data());
+
+        total.edgeTableMs += report.edgeTableMs;
+        total.nonManifoldMs += report.nonManifoldMs;
+        total.holeDetectionMs += report.holeDetectionMs;
+        total.holeFillingMs += report.holeFillingMs;
+        total.componentsMs += report.componentsMs;
+        total.vertexCompactionMs += report.vertexCompactionMs;
+        total.peakBytes = std::max(total.peakBytes, report.peakBytes);
+    }
+
+    const double triangles = static_cast<double>(input->triangleCount()) * static_cast<double>(state.iterations());
+    state.SetItemsProcessed(static_cast<int64_t>(triangles));
+    reportRate(state, "edges/s", triangles, total.edgeTableMs);
+    reportRate(state, "manifold/s", triangles, total.nonManifoldMs);
+    reportRate(state, "holeDetect/s", triangles, total.holeDetectionMs);
+    reportRate(state, "holeFill/s", triangles, total.holeFillingMs);
+    reportRate(state, "components/s", triangles, total.componentsMs);
+    reportRate(state, "compact/s", triangles, total.vertexCompactionMs);
+    state.counters["holesFilled"] = report.holesFilled;
+    state.counters["peakMB"] = static_cast<double>(total.peakBytes) / (1024.0 * 1024.0);
+}
+
+void BM_TaubinSmooth(benchmark::State& state, const MeshData* input, SmoothingParams::Weighting weighting) {
+    SmoothingParams params;
+    params.iterations = 5;
+    params.weighting = weighting;
+
+    MallocBuffer<float> vertices;
+    for (auto _ : state) {
+        state.PauseTiming();
+        vertices.assign(input->vertices.begin(), input->vertices.end());
+        state.ResumeTiming();
+
+        smoothTaubin(vertices.data(), input->vertexCount(), 3 * sizeof(float),
+                     input->indices.data(), input->indices.size(), params);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->vertexCount()) * state.iterations());
+}
+
+void BM_SimplifyQuadric(benchmark::State& state, const MeshData* input, size_t divisor,
+                        SimplifyParams::Strategy strategy) {
+    SimplifyParams params;
+    params.targetTriangles = std::max<size_t>(input->triangleCount() / divisor, 1);
+    params.strategy = strategy;
+
+    SimplifyStats stats;
+    size_t outputTriangles = 0;
+    for (auto _ : state) {
+        MeshData output = simplifyQuadric(input->vertices.data(), input->vertexCount(),
+                                          input->indices.data(), input->indices.size(), params, &stats);
+        outputTriangles = output.triangleCount();
+        benchmark::DoNotOptimize(output.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->triangleCount()) * state.iterations());
+    state.counters["outTriangles"] = static_cast<double>(outputTriangles);
+    state.counters["rejected"] = static_cast<double>(stats.rejected);
+    state.counters["rounds"] = static_cast<double>(stats.rounds);
+    state.counters["maxError"] = stats.maxError;
+}
+
+void BM_SimplifyQuadricChain(benchmark::State& state, const MeshData* input) {
+    const std::vector<float> ratios = {1.0f, 0.5f, 0.25f, 0.1f};
+    SimplifyParams params;
+
+    SimplifyStats stats;
+    size_t sharedVertices = 0;
+    for (auto _ : state) {
+        LodChain chain = simplifyQuadricChain(input->vertices.data(), input->vertexCount(),
+                                              input->indices.data(), input->indices.size(), ratios, params, &stats);
+        sharedVertices = chain.vertices.size() / 3;
+        benchmark::DoNotOptimize(chain.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->triangleCount()) * state.iterations());
+    state.counters["sharedVertices"] = static_cast<double>(sharedVertices);
+    state.counters["maxError"] = stats.maxError;
+}
+
+void BM_VertexClustering(benchmark::State& state, const MeshData* input, uint32_t resolution) {
+    ClusterParams params;
+    params.gridResolution = resolution;
+
+    ClusterStats stats;
+    size_t outputTriangles = 0;
+    for (auto _ : state) {
+        MeshData output = simplifyVertexClustering(input->vertices.data(), input->vertexCount(),
+                                                   input->indices.data(), input->indices.size(), params, &stats);
+        outputTriangles = output.triangleCount();
+        benchmark::DoNotOptimize(output.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->triangleCount()) * state.iterations());
+    state.counters["outTriangles"] = static_cast<double>(outputTriangles);
+    state.counters["cells"] = static_cast<double>(stats.occupiedCells);
+}
+
+void BM_VertexClusteringPly(benchmark::State& state, const std::string& path, const MeshData* input,
+                            uint32_t resolution) {
+    ClusterParams params;
+    params.gridResolution = resolution;
+
+    ClusterStats stats;
+    size_t outputTriangles = 0;
+    for (auto _ : state) {
+        MeshData output = simplifyVertexClusteringPly(path, params, &stats);
+        outputTriangles = output.triangleCount();
+        benchmark::DoNotOptimize(output.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->triangleCount()) * state.iterations());
+    state.counters["outTriangles"] = static_cast<double>(outputTriangles);
+    state.counters["cells"] = static_cast<double>(stats.occupiedCells);
+}
+
+void BM_PoissonReconstruct(benchmark::State& state, const MeshData* input, int depth) {
+    PoissonWrapper wrapper;
+    PoissonWrapper::Configuration config;
+    config.depth = depth;
+    config.verbose = false;
+
+    OrientedPointView view;
+    view.points = input->vertices.data();
+    view.normals = input->normals.data();
+    view.count = input->vertexCount();
+
+    size_t outputTriangles = 0;
+    for (auto _ : state) {
+        MeshData output = wrapper.reconstruct(view, config);
+        outputTriangles = output.triangleCount();
+        benchmark::DoNotOptimize(output.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->vertexCount()) * state.iterations());
+    state.counters["outTriangles"] = static_cast<double>(outputTriangles);
+}
+
+void BM_KNearestNeighbors(benchmark::State& state, const MeshData* input, size_t k) {
+    for (auto _ : state) {
+        KdTree tree;
+        tree.build(input->vertices.data(), input->vertexCount());
+        NeighborGraph graph = tree.queryAll(k);
+        benchmark::DoNotOptimize(graph.indices.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->vertexCount()) * state.iterations());
+}
+
+void BM_EstimateNormals(benchmark::State& state, const MeshData* input, size_t k) {
+    KdTree tree;
+    tree.build(input->vertices.data(), input->vertexCount());
+    const NeighborGraph graph = tree.queryAll(k);
+
+    for (auto _ : state) {
+        NormalEstimate estimate = estimateNormals(input->vertices.data(), input->vertexCount(),
+                                                  3 * sizeof(float), graph);
+        benchmark::DoNotOptimize(estimate.normals.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->vertexCount()) * state.iterations());
+}
+
+void BM_OrientNormals(benchmark::State& state, const MeshData* input, size_t k) {
+    KdTree tree;
+    tree.build(input->vertices.data(), input->vertexCount());
+    const NeighborGraph graph = tree.queryAll(k);
+    const NormalEstimate estimate = estimateNormals(input->vertices.data(), input->vertexCount(),
+                                                    3 * sizeof(float), graph);
+
+    MallocBuffer<float> normals;
+    for (auto _ : state) {
+        state.PauseTiming();
+        normals.assign(estimate.normals.begin(), estimate.normals.end());
+        state.ResumeTiming();
+
+        orientNormals(input->vertices.data(), input->vertexCount(), 3 * sizeof(float), graph, normals.data());
+        benchmark::DoNotOptimize(normals.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->vertexCount()) * state.iterations());
+}
+
+/// VoxelMeshRepair's pipeline: rasterize, threshold, dilate, close,
+/// marching cubes
+void BM_SparseVoxelMesh(benchmark::State& state, const MeshData* input, int resolution) {
+    Point3D lo(INFINITY, INFINITY, INFINITY);
+    Point3D hi(-INFINITY, -INFINITY, -INFINITY);
+    for (size_t i = 0; i < input->vertexCount(); ++i) {
+        const Point3D p = input->getVertex(i);
+        lo = Point3D(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+        hi = Point3D(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+    }
+    const Point3D extent = hi - lo;
+    const float voxelSize = std::max(extent.x, std::max(extent.y, extent.z)) / static_cast<float>(resolution);
+
+    size_t memory = 0;
+    size_t triangles = 0;
+    for (auto _ : state) {
+        SparseVoxelGrid grid(voxelSize, lo);
+        grid.rasterize(input->vertices.data(), input->vertexCount());
+        grid.threshold(0.5f);
+        grid.dilate(1, 0.55f);
+
+        int32_t offset[3];
+        BitVolume volume = grid.occupancyVolume(2, offset);
+        volume.close(1);
+        volume.fillInterior();
+        const Point3D volumeOrigin(lo.x + static_cast<float>(offset[0]) * voxelSize,
+                                   lo.y + static_cast<float>(offset[1]) * voxelSize,
+                                   lo.z + static_cast<float>(offset[2]) * voxelSize);
+        MeshData surface = extractVoxelSurface(volume, voxelSize, volumeOrigin);
+        benchmark::DoNotOptimize(surface.indices.data());
+        memory = grid.memoryBytes() + volume.memoryBytes();
+        triangles = surface.triangleCount();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(input->vertexCount()) * state.iterations());
+    state.counters["MB"] = static_cast<double>(memory) / (1024.0 * 1024.0);
+    state.counters["triangles"] = static_cast<double>(triangles);
+}
+
+/// Closing that seals the slot, then cavity filling of the sealed shell
+void BM_CloseAndFillVolume(benchmark::State& state, size_t n) {
+    const BitVolume shell = makeShellVolume(n);
+    size_t filled = 0;
+    for (auto _ : state) {
+        BitVolume volume = shell;
+        volume.close(2);
+        filled = volume.fillInterior();
+        benchmark::DoNotOptimize(volume.row(0, 0));
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(n * n * n) * state.iterations());
+    state.counters["filled"] = static_cast<double>(filled);
+}
+
+void BM_UnprojectDepthMap(benchmark::State& state, size_t width, size_t height) {
+    std::vector<float> depth;
+    std::vector<uint8_t> confidence;
+    makeDepthMap(width, height, depth, confidence);
+
+    DepthUnprojectionParams params;
+    params.intrinsics.fx = params.intrinsics.fy = 0.8f * static_cast<float>(width);
+    params.intrinsics.cx = 0.5f * static_cast<float>(width);
+    params.intrinsics.cy = 0.5f * static_cast<float>(height);
+
+    DepthFrameRing ring(4);
+    for (auto _ : state) {
+        const DepthFrame& frame = ring.ingest(depth.data(), width * sizeof(float),
+                                              confidence.data(), width,
+                                              width, height, params, 0.0);
+        benchmark::DoNotOptimize(frame.points.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(width * height) * state.iterations());
+}
+
+/// Fuse a sequence of depth maps taken while the camera slides sideways,
+/// so every frame allocates some new blocks and revisits the rest
+void BM_TsdfIntegrate(benchmark::State& state, size_t width, size_t height) {
+    std::vector<float> depth;
+    std::vector<uint8_t> confidence;
+    makeDepthMap(width, height, depth, confidence);
+
+    DepthUnprojectionParams params;
+    params.intrinsics.fx = params.intrinsics.fy = 0.8f * static_cast<float>(width);
+    params.intrinsics.cx = 0.5f * static_cast<float>(width);
+    params.intrinsics.cy = 0.5f * static_cast<float>(height);
+    params.minConfidence = 0;
+
+    TsdfVolume volume;
+    size_t frame = 0;
+    size_t blocks = 0;
+    for (auto _ : state) {
+        params.pose[12] = 0.01f * static_cast<float>(frame++ % 100);
+        blocks += volume.integrate(depth.data(), width * sizeof(float), confidence.data(), width,
+                                   width, height, params);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(width * height) * state.iterations());
+    state.counters["blocks/frame"] = static_cast<double>(blocks) / static_cast<double>(state.iterations());
+    state.counters["MB"] = static_cast<double>(volume.memoryBytes()) / (1024.0 * 1024.0);
+}
+
+void registerMesh(const std::string& name, MeshData mesh, int depth) {
+    inputs.push_back(std::move(mesh));
+    const MeshData* input = &inputs.back();
+
+    if (input->triangleCount() > 0) {
+        benchmark::RegisterBenchmark(("MeshFixRepair/" + name).c_str(), BM_MeshFixRepair, input)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("TaubinSmooth/" + name + "/uniform").c_str(),
+                                     BM_TaubinSmooth, input, SmoothingParams::Weighting::Uniform)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("TaubinSmooth/" + name + "/cotangent").c_str(),
+                                     BM_TaubinSmooth, input, SmoothingParams::Weighting::Cotangent)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("SimplifyQuadric/" + name + "/5pct").c_str(),
+                                     BM_SimplifyQuadric, input, size_t(20), SimplifyParams::Strategy::Greedy)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("SimplifyQuadric/" + name + "/5pct/batched").c_str(),
+                                     BM_SimplifyQuadric, input, size_t(20), SimplifyParams::Strategy::Batched)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("SimplifyQuadricChain/" + name + "/100-50-25-10").c_str(),
+                                     BM_SimplifyQuadricChain, input)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("VertexClustering/" + name + "/res64").c_str(),
+                                     BM_VertexClustering, input, uint32_t(64))
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+    } else if (input->normals.size() == input->vertices.size() && input->vertexCount() > 0) {
+        benchmark::RegisterBenchmark(("KNearestNeighbors/" + name + "/k12").c_str(),
+                                     BM_KNearestNeighbors, input, size_t(12))
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("EstimateNormals/" + name + "/k12").c_str(),
+                                     BM_EstimateNormals, input, size_t(12))
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("OrientNormals/" + name + "/k12").c_str(),
+                                     BM_OrientNormals, input, size_t(12))
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("SparseVoxelMesh/" + name + "/res128").c_str(),
+                                     BM_SparseVoxelMesh, input, 128)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("PoissonReconstruct/" + name + "/depth" + std::to_string(depth)).c_str(),
+                                     BM_PoissonReconstruct, input, depth)
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+    } else {
+        std::cerr << "Skipping " << name << ": no faces and no normals" << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    int depth = 8;
+    bool longRun = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--depth=", 8) == 0) {
+            depth = std::atoi(argv[i] + 8);
+        } else if (std::strcmp(argv[i], "--long") == 0) {
+            longRun = true;
+        } else if (argv[i][0] == '-') {
+            std::cerr << "Unknown flag " << argv[i] << std::endl;
+            return 1;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (files.empty()) {
+        // ARKit sceneDepth resolution, then VGA and full color-camera size
+        for (const auto& size : std::vector<std::pair<size_t, size_t>>{{256, 192}, {640, 480}, {1920, 1440}}) {
+            benchmark::RegisterBenchmark(("UnprojectDepthMap/" + std::to_string(size.first) + "x" +
+                                          std::to_string(size.second)).c_str(),
+                                         BM_UnprojectDepthMap, size.first, size.second)
+                ->Unit(benchmark::kMicrosecond)
+                ->UseRealTime();
+        }
+        benchmark::RegisterBenchmark("TsdfIntegrate/256x192", BM_TsdfIntegrate, size_t(256), size_t(192))
+            ->Unit(benchmark::kMillisecond)
+            ->UseRealTime();
+        for (size_t n : {128, 512}) {
+            benchmark::RegisterBenchmark(("CloseAndFillVolume/" + std::to_string(n)).c_str(), BM_CloseAndFillVolume, n)
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        }
+        std::vector<size_t> meshSizes = {10000, 100000, 1000000};
+        std::vector<size_t> cloudSizes = {10000, 100000};
+        if (longRun) {
+            // Scan-sized inputs, off by default to keep routine runs short
+            meshSizes.insert(meshSizes.end(), {2000000, 5000000});
+            cloudSizes.insert(cloudSizes.end(), {2000000, 5000000});
+        }
+        for (size_t triangles : meshSizes) {
+            registerMesh("grid" + std::to_string(triangles), makeGridMesh(triangles), depth);
+        }
+        for (size_t points : cloudSizes) {
+            registerMesh("sphere" + std::to_string(points), makeSphereCloud(points), depth);
+        }
+    } else {
+        for (const std::string& file : files) {
+            try {
+                registerMesh(file, loadPly(file), depth);
+                if (inputs.back().triangleCount() > 0) {
+                    benchmark::RegisterBenchmark(("VertexClusteringPly/" + file + "/res64").c_str(),
+                                                 BM_VertexClusteringPly, file, &inputs.back(), uint32_t(64))
+                        ->Unit(benchmark::kMillisecond)
+                        ->UseRealTime();
+                }
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
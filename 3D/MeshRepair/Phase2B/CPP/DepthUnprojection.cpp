@@ -0,0 +1,183 @@
+//
+//  DepthUnprojection.cpp
+//  3D
+//
+//  Depth-map unprojection kernel and frame ring
+//
+
+#include "DepthUnprojection.hpp"
+#include "Parallel.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace mesh {
+
+namespace {
+
+// Neighbors whose depth differs by more than this fraction are treated as
+// lying across a silhouette and left out of the normal
+constexpr float DiscontinuityRatio = 0.1f;
+
+// Grid rows per parallel task
+constexpr size_t RowGrain = 8;
+
+} // namespace
+
+DepthFrameRing::DepthFrameRing(size_t capacity) : _frames(capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("DepthFrameRing capacity must be positive");
+    }
+}
+
+void DepthFrameRing::clear() {
+    _next = 0;
+    _count = 0;
+    _sequence = 0;
+}
+
+const DepthFrame& DepthFrameRing::frame(size_t age) const {
+    if (age >= _count) {
+        throw std::out_of_range("DepthFrameRing age out of range");
+    }
+    return _frames[(_next + _frames.size() - 1 - age) % _frames.size()];
+}
+
+const DepthFrame& DepthFrameRing::ingest(const float* depth, size_t depthRowBytes,
+                                         const uint8_t* confidence, size_t confidenceRowBytes,
+                                         size_t width, size_t height,
+                                         const DepthUnprojectionParams& params, double timestamp) {
+    const size_t step = std::max<size_t>(params.step, 1);
+    const size_t gridWidth = (width + step - 1) / step;
+    const size_t gridHeight = (height + step - 1) / step;
+    const size_t cells = gridWidth * gridHeight;
+
+    // Sized once per resolution; later frames reuse the allocations
+    _x.resize(cells);
+    _y.resize(cells);
+    _z.resize(cells);
+    _depth.resize(cells);
+    _keep.resize(cells);
+    _rowOffsets.resize(gridHeight + 1);
+    _rayX.resize(gridWidth);
+
+    DepthFrame& out = _frames[_next];
+    out.points.resize(cells * DepthFrame::PointStride);
+    out.normals.resize(cells * DepthFrame::PointStride);
+    out.confidence.resize(cells);
+    std::copy(params.pose, params.pose + 16, out.pose);
+    out.viewpoint[0] = params.pose[12];
+    out.viewpoint[1] = params.pose[13];
+    out.viewpoint[2] = params.pose[14];
+    out.timestamp = timestamp;
+    out.sequence = _sequence;
+
+    const DepthIntrinsics& k = params.intrinsics;
+    const float* m = params.pose;
+    for (size_t i = 0; i < gridWidth; ++i) {
+        _rayX[i] = (static_cast<float>(i * step) - k.cx) / k.fx;
+    }
+
+    // Pass 1: unproject every sampled pixel and mark the ones to keep
+    // A pixel's camera-space point is d * (rayX, rayY, -1); rayX varies along
+    // the row and rayY is constant, so world = d * (R.col0 * rayX + b) + t
+    parallelForChunks(gridHeight, [&](size_t rowBegin, size_t rowEnd) {
+        for (size_t row = rowBegin; row < rowEnd; ++row) {
+            const size_t v = row * step;
+            const float* depthRow = reinterpret_cast<const float*>(
+                reinterpret_cast<const unsigned char*>(depth) + v * depthRowBytes);
+            const float rayY = -(static_cast<float>(v) - k.cy) / k.fy;
+            const float bx = m[4] * rayY - m[8];
+            const float by = m[5] * rayY - m[9];
+            const float bz = m[6] * rayY - m[10];
+
+            float* x = _x.data() + row * gridWidth;
+            float* y = _y.data() + row * gridWidth;
+            float* z = _z.data() + row * gridWidth;
+            float* d = _depth.data() + row * gridWidth;
+            uint8_t* keep = _keep.data() + row * gridWidth;
+            const float* rayX = _rayX.data();
+
+            for (size_t i = 0; i < gridWidth; ++i) {
+                const float s = depthRow[i * step];
+                const bool valid = s > params.minDepth && s <= params.maxDepth;
+                d[i] = valid ? s : 0.0f;
+                keep[i] = valid ? 1 : 0;
+            }
+            for (size_t i = 0; i < gridWidth; ++i) {
+                x[i] = d[i] * (m[0] * rayX[i] + bx) + m[12];
+                y[i] = d[i] * (m[1] * rayX[i] + by) + m[13];
+                z[i] = d[i] * (m[2] * rayX[i] + bz) + m[14];
+            }
+            if (confidence) {
+                const uint8_t* confidenceRow = confidence + v * confidenceRowBytes;
+                for (size_t i = 0; i < gridWidth; ++i) {
+                    keep[i] &= confidenceRow[i * step] >= params.minConfidence ? 1 : 0;
+                }
+            }
+
+            uint32_t kept = 0;
+            for (size_t i = 0; i < gridWidth; ++i) {
+                kept += keep[i];
+            }
+            _rowOffsets[row + 1] = kept;
+        }
+    }, RowGrain);
+
+    // Pass 2: row offsets into the compacted output
+    _rowOffsets[0] = 0;
+    for (size_t row = 0; row < gridHeight; ++row) {
+        _rowOffsets[row + 1] += _rowOffsets[row];
+    }
+    out.pointCount = _rowOffsets[gridHeight];
+
+    // Pass 3: normals from grid neighbors; kept pixels are compacted into the frame
+    const float vx = m[12], vy = m[13], vz = m[14];
+    parallelForChunks(gridHeight, [&](size_t rowBegin, size_t rowEnd) {
+        for (size_t row = rowBegin; row < rowEnd; ++row) {
+            const uint8_t* keep = _keep.data() + row * gridWidth;
+            const uint8_t* confidenceRow = confidence ? confidence + row * step * confidenceRowBytes : nullptr;
+            size_t write = _rowOffsets[row];
+
+            for (size_t i = 0; i < gridWidth; ++i) {
+                if (!keep[i]) continue;
+                const size_t c = row * gridWidth + i;
+                const float d = _depth[c];
+                const Point3D p(_x[c], _y[c], _z[c]);
+
+                auto neighbor = [&](size_t cell, const Point3D& fallback) {
+                    const float nd = _depth[cell];
+                    return nd > 0.0f && std::fabs(nd - d) <= DiscontinuityRatio * d
+                        ? Point3D(_x[cell], _y[cell], _z[cell]) : fallback;
+                };
+                const Point3D left = i > 0 ? neighbor(c - 1, p) : p;
+                const Point3D right = i + 1 < gridWidth ? neighbor(c + 1, p) : p;
+                const Point3D up = row > 0 ? neighbor(c - gridWidth, p) : p;
+                const Point3D down = row + 1 < gridHeight ? neighbor(c + gridWidth, p) : p;
+
+                const Point3D toCamera(vx - p.x, vy - p.y, vz - p.z);
+                Point3D n = (right - left).cross(down - up);
+                if (n.dot(n) <= 1e-20f) {
+                    n = toCamera;
+                } else if (n.dot(toCamera) < 0.0f) {
+                    n = n * -1.0f;
+                }
+                n = n.normalized();
+
+                float* point = out.points.data() + write * DepthFrame::PointStride;
+                float* normal = out.normals.data() + write * DepthFrame::PointStride;
+                point[0] = p.x; point[1] = p.y; point[2] = p.z; point[3] = 0.0f;
+                normal[0] = n.x; normal[1] = n.y; normal[2] = n.z; normal[3] = 0.0f;
+                out.confidence[write] = confidenceRow
+                    ? std::min(confidenceRow[i * step] * 0.5f, 1.0f) : 1.0f;
+                write++;
+            }
+        }
+    }, RowGrain);
+
+    _next = (_next + 1) % _frames.size();
+    _count = std::min(_count + 1, _frames.size());
+    _sequence++;
+    return out;
+}
+
+} // namespace mesh
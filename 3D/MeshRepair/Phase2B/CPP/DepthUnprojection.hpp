@@ -0,0 +1,100 @@
+//
+//  DepthUnprojection.hpp
+//  3D
+//
+//  Depth-map unprojection for LiDAR frame ingestion
+//  Whole rows are unprojected in branch-free lane loops, filtered by
+//  confidence and compacted into a preallocated ring of frame buffers;
+//  normals come from the depth grid itself, facing the camera
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+
+namespace mesh {
+
+/// Pinhole intrinsics in depth-map pixels
+/// (scale the color-image intrinsics by depthWidth / imageWidth)
+struct DepthIntrinsics {
+    float fx = 1.0f;
+    float fy = 1.0f;
+    float cx = 0.0f;
+    float cy = 0.0f;
+};
+
+struct DepthUnprojectionParams {
+    DepthIntrinsics intrinsics;
+    float pose[16] = {1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1};
+                                // Camera-to-world, column-major (simd_float4x4 layout);
+                                // the camera looks down -z with +y up (ARKit convention)
+    uint8_t minConfidence = 1;  // ARConfidenceLevel: 0 low, 1 medium, 2 high
+    size_t step = 1;            // Sample every step-th pixel in x and y
+    float minDepth = 0.0f;      // Meters; depths outside (minDepth, maxDepth] are skipped
+    float maxDepth = 5.0f;
+};
+
+/// Points of one unprojected depth map, in world space
+/// Point and normal buffers hold 4 floats per point, matching the layout of
+/// SIMD3<Float> (16-byte stride); the fourth float is padding. Buffers are
+/// sized for the whole sampled grid and the first pointCount entries are valid
+struct DepthFrame {
+    MallocBuffer<float> points;
+    MallocBuffer<float> normals;       // Unit length, facing the camera
+    MallocBuffer<float> confidence;    // Confidence level / 2, in [0, 1]
+    size_t pointCount = 0;
+    float viewpoint[3] = {0, 0, 0};    // Camera position, shared by every point
+    float pose[16] = {};
+    double timestamp = 0.0;
+    uint64_t sequence = 0;             // Ingest order, starting at 0
+
+    static constexpr size_t PointStride = 4;
+};
+
+/// Fixed-capacity ring of depth frames; ingesting overwrites the oldest
+/// Frame buffers and scratch grids are allocated once per depth-map size and
+/// reused, so steady-state ingestion does not allocate
+class DepthFrameRing {
+public:
+    explicit DepthFrameRing(size_t capacity);
+
+    /// Unproject one depth map into the next slot and return it
+    /// `depth` is Float32 meters and `confidence` UInt8 levels (may be null to
+    /// keep every valid depth); row strides are in bytes
+    const DepthFrame& ingest(const float* depth, size_t depthRowBytes,
+                             const uint8_t* confidence, size_t confidenceRowBytes,
+                             size_t width, size_t height,
+                             const DepthUnprojectionParams& params, double timestamp);
+
+    size_t capacity() const {
+        return _frames.size();
+    }
+
+    /// Frames currently held, at most capacity()
+    size_t size() const {
+        return _count;
+    }
+
+    /// Frame by age: 0 is the most recent
+    const DepthFrame& frame(size_t age) const;
+
+    /// Total frames ingested, including overwritten ones
+    uint64_t framesIngested() const {
+        return _sequence;
+    }
+
+    void clear();
+
+private:
+    std::vector<DepthFrame> _frames;
+    size_t _next = 0;
+    size_t _count = 0;
+    uint64_t _sequence = 0;
+
+    // Scratch over the sampled grid, structure of arrays
+    std::vector<float> _x, _y, _z, _depth;
+    std::vector<uint8_t> _keep;
+    std::vector<uint32_t> _rowOffsets;
+    std::vector<float> _rayX;
+};
+
+} // namespace mesh
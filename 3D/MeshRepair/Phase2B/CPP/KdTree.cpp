@@ -0,0 +1,210 @@
+//
+//  KdTree.cpp
+//  3D
+//
+//  k-d tree construction and nearest-neighbor search
+//
+
+#include "KdTree.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace mesh {
+
+// ============================================================
+// Construction
+// ============================================================
+
+void KdTree::build(const float* points, size_t count, size_t stride) {
+    _nodes.clear();
+    _ids.resize(count);
+    _x.resize(count);
+    _y.resize(count);
+    _z.resize(count);
+
+    if (count == 0) {
+        return;
+    }
+
+    auto coordinate = [&](uint32_t id, int axis) {
+        const float* p = reinterpret_cast<const float*>(
+            reinterpret_cast<const unsigned char*>(points) + size_t(id) * stride);
+        return p[axis];
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        _ids[i] = static_cast<uint32_t>(i);
+    }
+
+    // Split each range at the median of its widest axis; children are
+    // created depth-first so every subtree's nodes stay close together
+    _nodes.reserve(2 * (count / LeafSize + 1));
+    _nodes.push_back(Node{0.0f, 0, static_cast<uint32_t>(count), 0, 0, 0});
+
+    std::vector<uint32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const uint32_t nodeIndex = stack.back();
+        stack.pop_back();
+
+        const uint32_t begin = _nodes[nodeIndex].begin;
+        const uint32_t end = _nodes[nodeIndex].end;
+        if (end - begin <= LeafSize) {
+            continue;
+        }
+
+        float lo[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                       std::numeric_limits<float>::max()};
+        float hi[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                       std::numeric_limits<float>::lowest()};
+        for (uint32_t i = begin; i < end; ++i) {
+            for (int a = 0; a < 3; ++a) {
+                const float c = coordinate(_ids[i], a);
+                lo[a] = std::min(lo[a], c);
+                hi[a] = std::max(hi[a], c);
+            }
+        }
+
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (hi[a] - lo[a] > hi[axis] - lo[axis]) {
+                axis = a;
+            }
+        }
+
+        const uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(_ids.begin() + begin, _ids.begin() + mid, _ids.begin() + end,
+                         [&](uint32_t a, uint32_t b) { return coordinate(a, axis) < coordinate(b, axis); });
+
+        const uint32_t left = static_cast<uint32_t>(_nodes.size());
+        _nodes.push_back(Node{0.0f, begin, mid, 0, 0, 0});
+        _nodes.push_back(Node{0.0f, mid, end, 0, 0, 0});
+
+        Node& node = _nodes[nodeIndex];
+        node.split = coordinate(_ids[mid], axis);
+        node.axis = static_cast<uint8_t>(axis);
+        node.left = left;
+        node.right = left + 1;
+
+        stack.push_back(left + 1);
+        stack.push_back(left);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        _x[i] = coordinate(_ids[i], 0);
+        _y[i] = coordinate(_ids[i], 1);
+        _z[i] = coordinate(_ids[i], 2);
+    }
+}
+
+// ============================================================
+// Queries
+// ============================================================
+
+size_t KdTree::search(float qx, float qy, float qz, size_t k,
+                      uint32_t* indices, float* distancesSquared) const {
+    size_t found = 0;
+    float worst = std::numeric_limits<float>::max();
+
+    // (node, squared distance from query to the node's splitting plane side)
+    struct Pending {
+        uint32_t node;
+        float distanceSquared;
+    };
+    Pending stack[64];
+    size_t depth = 0;
+    stack[depth++] = Pending{0, 0.0f};
+
+    while (depth > 0) {
+        const Pending pending = stack[--depth];
+        if (found == k && pending.distanceSquared >= worst) {
+            continue;
+        }
+
+        const Node& node = _nodes[pending.node];
+        if (node.left == 0) {
+            for (uint32_t i = node.begin; i < node.end; ++i) {
+                const float dx = _x[i] - qx;
+                const float dy = _y[i] - qy;
+                const float dz = _z[i] - qz;
+                const float d = dx * dx + dy * dy + dz * dz;
+                if (found == k && d >= worst) {
+                    continue;
+                }
+
+                // Insertion into the sorted result arrays
+                size_t slot = found < k ? found++ : k - 1;
+                while (slot > 0 && distancesSquared[slot - 1] > d) {
+                    distancesSquared[slot] = distancesSquared[slot - 1];
+                    indices[slot] = indices[slot - 1];
+                    slot--;
+                }
+                distancesSquared[slot] = d;
+                indices[slot] = _ids[i];
+                if (found == k) {
+                    worst = distancesSquared[k - 1];
+                }
+            }
+            continue;
+        }
+
+        const float q = node.axis == 0 ? qx : (node.axis == 1 ? qy : qz);
+        const float delta = q - node.split;
+        const uint32_t nearChild = delta < 0.0f ? node.left : node.right;
+        const uint32_t farChild = delta < 0.0f ? node.right : node.left;
+
+        // Far side first so the near side is popped next
+        stack[depth++] = Pending{farChild, std::max(pending.distanceSquared, delta * delta)};
+        stack[depth++] = Pending{nearChild, pending.distanceSquared};
+    }
+
+    return found;
+}
+
+size_t KdTree::query(const Point3D& query, size_t k, uint32_t* indices, float* distancesSquared) const {
+    if (k == 0 || _nodes.empty()) {
+        return 0;
+    }
+    return search(query.x, query.y, query.z, k, indices, distancesSquared);
+}
+
+NeighborGraph KdTree::queryAll(size_t k) const {
+    NeighborGraph graph;
+    const size_t count = size();
+    graph.k = count > 1 ? std::min(k, count - 1) : 0;
+    if (graph.k == 0) {
+        return graph;
+    }
+
+    const size_t rowWidth = graph.k;
+    graph.indices.resize(count * rowWidth);
+    graph.distancesSquared.resize(count * rowWidth);
+
+    // Walk points in tree order so neighboring queries touch the same leaves
+    parallelForChunks(count, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> ids(rowWidth + 1);
+        std::vector<float> distances(rowWidth + 1);
+
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t self = _ids[i];
+            const size_t found = search(_x[i], _y[i], _z[i], rowWidth + 1, ids.data(), distances.data());
+
+            // Drop the point itself; with coincident duplicates it may have
+            // been crowded out, in which case the farthest result goes
+            uint32_t* rowIds = graph.indices.data() + size_t(self) * rowWidth;
+            float* rowDistances = graph.distancesSquared.data() + size_t(self) * rowWidth;
+            size_t written = 0;
+            for (size_t j = 0; j < found && written < rowWidth; ++j) {
+                if (ids[j] == self) continue;
+                rowIds[written] = ids[j];
+                rowDistances[written] = distances[j];
+                written++;
+            }
+        }
+    }, 256);
+
+    return graph;
+}
+
+} // namespace mesh
@@ -0,0 +1,73 @@
+//
+//  KdTree.hpp
+//  3D
+//
+//  k-d tree over a point cloud for k-nearest-neighbor queries
+//  Batch queries for every indexed point run in parallel
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+
+namespace mesh {
+
+/// k nearest neighbors of every point, stored as fixed-width rows
+/// Row i holds the neighbors of point i sorted by ascending distance,
+/// never including i itself
+struct NeighborGraph {
+    size_t k = 0;
+    MallocBuffer<uint32_t> indices;          // pointCount * k
+    MallocBuffer<float> distancesSquared;    // pointCount * k
+
+    size_t pointCount() const {
+        return k > 0 ? indices.size() / k : 0;
+    }
+
+    const uint32_t* neighbors(size_t point) const {
+        return indices.data() + point * k;
+    }
+
+    const float* distances(size_t point) const {
+        return distancesSquared.data() + point * k;
+    }
+};
+
+class KdTree {
+public:
+    static constexpr size_t LeafSize = 16;
+
+    /// Build over `count` points of 3 floats, `stride` bytes apart
+    /// Coordinates are copied, so the source buffer may be released afterwards
+    void build(const float* points, size_t count, size_t stride = 3 * sizeof(float));
+
+    size_t size() const {
+        return _ids.size();
+    }
+
+    /// Up to k nearest indexed points to `query`, ascending by distance
+    /// Writes the results to indices/distancesSquared, returns how many
+    size_t query(const Point3D& query, size_t k, uint32_t* indices, float* distancesSquared) const;
+
+    /// k nearest neighbors of every indexed point, excluding the point itself
+    /// k is clamped to size() - 1
+    NeighborGraph queryAll(size_t k) const;
+
+private:
+    struct Node {
+        float split;
+        uint32_t begin;    // Range in tree order
+        uint32_t end;
+        uint32_t left;     // Child node indices, 0 for leaves
+        uint32_t right;
+        uint8_t axis;
+    };
+
+    // Search the tree, keeping the k best in ascending insertion-sorted arrays
+    size_t search(float qx, float qy, float qz, size_t k, uint32_t* indices, float* distancesSquared) const;
+
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _ids;      // Original index of each point in tree order
+    std::vector<float> _x, _y, _z;   // Coordinates in tree order (leaves are contiguous)
+};
+
+} // namespace mesh
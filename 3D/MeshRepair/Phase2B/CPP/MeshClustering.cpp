@@ -0,0 +1,643 @@
+//
+//  MeshClustering.cpp
+//  3D
+//
+//  Morton-keyed grid, radix sort into cells, cell quadrics and triangle
+//  remapping for vertex clustering, in memory or streamed from PLY
+//
+
+#include "MeshClustering.hpp"
+#include "MeshSimplification.hpp"
+#include "Parallel.hpp"
+#include "PlyFile.h"
+#include "VoxelBlocks.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace mesh {
+
+namespace {
+
+constexpr uint32_t kMaxCells = 1u << 21;
+constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+/// Spread the low 21 bits of `v` so that two zero bits follow each one
+uint64_t spreadBits(uint64_t v) {
+    v &= 0x1FFFFF;
+    v = (v | v << 32) & 0x1F00000000FFFFull;
+    v = (v | v << 16) & 0x1F0000FF0000FFull;
+    v = (v | v << 8) & 0x100F00F00F00F00Full;
+    v = (v | v << 4) & 0x10C30C30C30C30C3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+/// Significant bits of the grid's Morton keys
+unsigned int mortonBits(const ClusterGrid& grid) {
+    unsigned int bits = 0;
+    while ((1u << bits) < std::max({grid.cells[0], grid.cells[1], grid.cells[2]})) {
+        ++bits;
+    }
+    return 3 * bits;
+}
+
+/// Sort `order` by cell key, `keys` alongside; scratch is freed afterwards
+void sortByCell(MallocBuffer<uint64_t>& keys, MallocBuffer<uint32_t>& order, const ClusterGrid& grid) {
+    MallocBuffer<uint64_t> keysTmp;
+    MallocBuffer<uint32_t> orderTmp;
+    radixSortPairs(keys, order, keysTmp, orderTmp, mortonBits(grid));
+}
+
+/// Add the area-weighted plane of triangle (p0, p1, p2); degenerate
+/// triangles add nothing
+void addPlane(Quadric& quadric, const Point3D& p0, const Point3D& p1, const Point3D& p2) {
+    const Point3D n = (p1 - p0).cross(p2 - p0);
+    const float length = n.length();
+    if (length > 0.0f) {
+        const Point3D unit = n / length;
+        quadric += Quadric(unit.x, unit.y, unit.z, -unit.dot(p0), 0.5 * length);
+    }
+}
+
+/// Representative of the cell holding `mean`: the quadric optimum nearest
+/// the mean, which may stray half a cell past the cell's faces, no more.
+/// Otherwise the mean itself, and false
+bool placeInCell(const ClusterGrid& grid, const Quadric& quadric, const Point3D& mean, Point3D& position) {
+    const Point3D optimum = quadric.optimumNear(mean);
+    const Point3D center = grid.cellCenter(mean);
+    if (std::abs(optimum.x - center.x) <= grid.cellSize &&
+        std::abs(optimum.y - center.y) <= grid.cellSize &&
+        std::abs(optimum.z - center.z) <= grid.cellSize) {
+        position = optimum;
+        return true;
+    }
+    position = mean;
+    return false;
+}
+
+struct CellTriangle {
+    uint32_t v[3];
+
+    bool operator<(const CellTriangle& other) const {
+        return v[0] != other.v[0] ? v[0] < other.v[0] : v[1] != other.v[1] ? v[1] < other.v[1] : v[2] < other.v[2];
+    }
+    bool operator==(const CellTriangle& other) const {
+        return v[0] == other.v[0] && v[1] == other.v[1] && v[2] == other.v[2];
+    }
+};
+
+// ============================================================
+// Streaming state
+// ============================================================
+
+constexpr uint32_t kReferenced = 0x80000000u;
+
+/// Input vertex as kept while faces stream past: 16 bytes, the only
+/// per-input storage of the streaming path
+struct StreamVertex {
+    float p[3];
+    uint32_t cell;                  // Slot in the cell table, kReferenced once counted
+};
+
+struct StreamCell {
+    uint64_t key;
+    Quadric quadric;
+    double sum[3];
+    uint32_t members;               // Referenced vertices
+};
+
+/// Triangles are indexed by their first two cells; the few sharing that
+/// pair are chained through `next`
+struct StreamTriangle {
+    CellTriangle tri;
+    uint32_t copies;
+    uint32_t next;                  // Next triangle with the same v[0], v[1], or kNone
+};
+
+/// Face as returned by PlyFile: a malloc'd index list
+struct PlyFace {
+    unsigned int count;
+    unsigned int* indices;
+};
+
+} // namespace
+
+// ============================================================
+// Grid
+// ============================================================
+
+ClusterGrid ClusterGrid::fit(const Point3D& lo, const Point3D& hi, uint32_t resolution, float cellSize) {
+    const float extent[3] = {hi.x - lo.x, hi.y - lo.y, hi.z - lo.z};
+    const float longest = std::max({extent[0], extent[1], extent[2]});
+
+    ClusterGrid grid;
+    grid.origin = lo;
+    if (cellSize > 0.0f) {
+        grid.cellSize = cellSize;
+    } else {
+        grid.cellSize = longest > 0.0f ? longest / static_cast<float>(std::max(resolution, 1u)) : 1.0f;
+    }
+    for (int a = 0; a < 3; ++a) {
+        const double cells = std::floor(static_cast<double>(extent[a]) / grid.cellSize) + 1.0;
+        if (!(cells <= kMaxCells)) {
+            throw std::invalid_argument("Clustering grid exceeds 2^21 cells per axis");
+        }
+        grid.cells[a] = static_cast<uint32_t>(cells);
+    }
+    return grid;
+}
+
+uint64_t ClusterGrid::cellKey(const Point3D& p) const {
+    const float coord[3] = {p.x - origin.x, p.y - origin.y, p.z - origin.z};
+    uint64_t key = 0;
+    for (int a = 0; a < 3; ++a) {
+        const float cell = std::floor(coord[a] / cellSize);
+        const uint32_t index = cell > 0.0f ? std::min(static_cast<uint32_t>(cell), cells[a] - 1) : 0;
+        key |= spreadBits(index) << a;
+    }
+    return key;
+}
+
+Point3D ClusterGrid::cellCenter(const Point3D& p) const {
+    const float coord[3] = {p.x - origin.x, p.y - origin.y, p.z - origin.z};
+    float center[3];
+    for (int a = 0; a < 3; ++a) {
+        const float cell = std::floor(coord[a] / cellSize);
+        const uint32_t index = cell > 0.0f ? std::min(static_cast<uint32_t>(cell), cells[a] - 1) : 0;
+        center[a] = (static_cast<float>(index) + 0.5f) * cellSize;
+    }
+    return Point3D(origin.x + center[0], origin.y + center[1], origin.z + center[2]);
+}
+
+// ============================================================
+// Public API
+// ============================================================
+
+MeshData simplifyVertexClustering(const float* vertices, size_t vertexCount,
+                                  const uint32_t* indices, size_t indexCount,
+                                  const ClusterParams& params,
+                                  ClusterStats* stats) {
+    const size_t triangleCount = indexCount / 3;
+    if (vertexCount >= kNone || triangleCount * 3 > 0xFFFFFFFFull) {
+        throw std::length_error("Mesh too large for 32-bit clustering indices");
+    }
+
+    ClusterStats local;
+    MeshData result;
+
+    MallocBuffer<uint8_t> used(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        if (indices[i] >= vertexCount) {
+            throw std::out_of_range("Triangle index out of range");
+        }
+        used[indices[i]] = 1;
+    }
+
+    auto position = [&](size_t v) {
+        return Point3D(vertices[v * 3], vertices[v * 3 + 1], vertices[v * 3 + 2]);
+    };
+
+    // Bounds of the referenced vertices, reduced over chunks
+    const size_t boundsGrain = 65536;
+    const size_t boundsChunks = (vertexCount + boundsGrain - 1) / boundsGrain;
+    const float inf = std::numeric_limits<float>::infinity();
+    MallocBuffer<Point3D> chunkLo(boundsChunks, Point3D(inf, inf, inf));
+    MallocBuffer<Point3D> chunkHi(boundsChunks, Point3D(-inf, -inf, -inf));
+    parallelFor(boundsChunks, [&](size_t chunk) {
+        Point3D lo = chunkLo[chunk];
+        Point3D hi = chunkHi[chunk];
+        for (size_t v = chunk * boundsGrain, end = std::min(vertexCount, v + boundsGrain); v < end; ++v) {
+            if (used[v]) {
+                const Point3D p = position(v);
+                lo = Point3D(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+                hi = Point3D(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+            }
+        }
+        chunkLo[chunk] = lo;
+        chunkHi[chunk] = hi;
+    }, 1);
+    Point3D lo(inf, inf, inf);
+    Point3D hi(-inf, -inf, -inf);
+    for (size_t chunk = 0; chunk < boundsChunks; ++chunk) {
+        lo = Point3D(std::min(lo.x, chunkLo[chunk].x), std::min(lo.y, chunkLo[chunk].y), std::min(lo.z, chunkLo[chunk].z));
+        hi = Point3D(std::max(hi.x, chunkHi[chunk].x), std::max(hi.y, chunkHi[chunk].y), std::max(hi.z, chunkHi[chunk].z));
+    }
+    if (!(lo.x <= hi.x)) {
+        if (stats) {
+            *stats = local;
+        }
+        return result;
+    }
+    if (!std::isfinite(lo.x) || !std::isfinite(lo.y) || !std::isfinite(lo.z) ||
+        !std::isfinite(hi.x) || !std::isfinite(hi.y) || !std::isfinite(hi.z)) {
+        throw std::invalid_argument("Non-finite vertex position");
+    }
+    const ClusterGrid grid = ClusterGrid::fit(lo, hi, params.gridResolution, params.cellSize);
+
+    // Referenced vertices sorted by cell key; every cell is one run
+    MallocBuffer<uint32_t> order;
+    order.reserve(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (used[v]) {
+            order.push_back(static_cast<uint32_t>(v));
+        }
+    }
+    MallocBuffer<uint64_t> keys(order.size());
+    parallelFor(order.size(), [&](size_t i) {
+        keys[i] = grid.cellKey(position(order[i]));
+    }, 4096);
+    sortByCell(keys, order, grid);
+
+    size_t cellCount = order.size() > 0 ? 1 : 0;
+    for (size_t i = 1; i < order.size(); ++i) {
+        cellCount += keys[i] != keys[i - 1] ? 1 : 0;
+    }
+    MallocBuffer<uint32_t> cellStart(cellCount + 1, 0);
+    MallocBuffer<uint32_t> cellOf(vertexCount, kNone);
+    for (size_t i = 0, cell = 0; i < order.size(); ++i) {
+        if (i > 0 && keys[i] != keys[i - 1]) {
+            cellStart[++cell] = static_cast<uint32_t>(i);
+        }
+        cellOf[order[i]] = static_cast<uint32_t>(cell);
+    }
+    cellStart[cellCount] = static_cast<uint32_t>(order.size());
+    local.occupiedCells = cellCount;
+
+    // Triangles touching each cell, in CSR form; a triangle is listed once
+    // per distinct cell among its corners
+    MallocBuffer<uint32_t> faceStart(cellCount + 1, 0);
+    auto forEachCell = [&](size_t t, auto&& fn) {
+        const uint32_t c0 = cellOf[indices[t * 3]];
+        const uint32_t c1 = cellOf[indices[t * 3 + 1]];
+        const uint32_t c2 = cellOf[indices[t * 3 + 2]];
+        fn(c0);
+        if (c1 != c0) {
+            fn(c1);
+        }
+        if (c2 != c0 && c2 != c1) {
+            fn(c2);
+        }
+    };
+    MallocBuffer<uint32_t> cellFaces;
+    if (params.quadricPositions) {
+        for (size_t t = 0; t < triangleCount; ++t) {
+            forEachCell(t, [&](uint32_t c) { ++faceStart[c + 1]; });
+        }
+        for (size_t c = 0; c < cellCount; ++c) {
+            faceStart[c + 1] += faceStart[c];
+        }
+        cellFaces.resize(faceStart[cellCount]);
+        MallocBuffer<uint32_t> cursor;
+        cursor.assign(faceStart.begin(), faceStart.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            forEachCell(t, [&](uint32_t c) { cellFaces[cursor[c]++] = static_cast<uint32_t>(t); });
+        }
+    }
+
+    // One representative per cell
+    MallocBuffer<Point3D> cellPosition(cellCount);
+    MallocBuffer<uint8_t> fallback(cellCount, 0);
+    parallelFor(cellCount, [&](size_t c) {
+        double sum[3] = {0.0, 0.0, 0.0};
+        for (uint32_t i = cellStart[c]; i < cellStart[c + 1]; ++i) {
+            const Point3D p = position(order[i]);
+            sum[0] += p.x;
+            sum[1] += p.y;
+            sum[2] += p.z;
+        }
+        const double members = static_cast<double>(cellStart[c + 1] - cellStart[c]);
+        const Point3D mean(static_cast<float>(sum[0] / members), static_cast<float>(sum[1] / members),
+                           static_cast<float>(sum[2] / members));
+        cellPosition[c] = mean;
+        if (!params.quadricPositions) {
+            return;
+        }
+
+        Quadric quadric;
+        for (uint32_t i = faceStart[c]; i < faceStart[c + 1]; ++i) {
+            const uint32_t* tri = indices + static_cast<size_t>(cellFaces[i]) * 3;
+            addPlane(quadric, position(tri[0]), position(tri[1]), position(tri[2]));
+        }
+        fallback[c] = placeInCell(grid, quadric, mean, cellPosition[c]) ? 0 : 1;
+    }, 256);
+    for (size_t c = 0; c < cellCount; ++c) {
+        local.centroidCells += fallback[c];
+    }
+
+    // Remapped triangles, rotated to start at their smallest cell so equal
+    // triangles compare equal while keeping their winding
+    const size_t grain = 16384;
+    std::vector<std::vector<CellTriangle>> chunkTriangles((triangleCount + grain - 1) / grain);
+    parallelForChunks(triangleCount, [&](size_t begin, size_t end) {
+        std::vector<CellTriangle>& out = chunkTriangles[begin / grain];
+        for (size_t t = begin; t < end; ++t) {
+            CellTriangle tri;
+            bool keep = true;
+            for (int c = 0; c < 3; ++c) {
+                tri.v[c] = cellOf[indices[t * 3 + c]];
+                keep = keep && cellStart[tri.v[c] + 1] - cellStart[tri.v[c]] >= params.minClusterSize;
+            }
+            if (!keep || tri.v[0] == tri.v[1] || tri.v[1] == tri.v[2] || tri.v[2] == tri.v[0]) {
+                continue;
+            }
+            while (tri.v[0] > tri.v[1] || tri.v[0] > tri.v[2]) {
+                tri = CellTriangle{{tri.v[1], tri.v[2], tri.v[0]}};
+            }
+            out.push_back(tri);
+        }
+    }, grain);
+    std::vector<CellTriangle> triangles;
+    for (std::vector<CellTriangle>& chunk : chunkTriangles) {
+        triangles.insert(triangles.end(), chunk.begin(), chunk.end());
+        std::vector<CellTriangle>().swap(chunk);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    const size_t unique = static_cast<size_t>(std::unique(triangles.begin(), triangles.end()) - triangles.begin());
+    local.duplicateTriangles = triangles.size() - unique;
+    triangles.resize(unique);
+
+    // Compact to the cells still referenced, keeping Morton order
+    MallocBuffer<uint32_t> remap(cellCount, kNone);
+    for (const CellTriangle& tri : triangles) {
+        remap[tri.v[0]] = 0;
+        remap[tri.v[1]] = 0;
+        remap[tri.v[2]] = 0;
+    }
+    uint32_t next = 0;
+    for (size_t c = 0; c < cellCount; ++c) {
+        if (remap[c] != kNone) {
+            remap[c] = next++;
+        }
+    }
+    result.vertices.resize(static_cast<size_t>(next) * 3);
+    for (size_t c = 0; c < cellCount; ++c) {
+        if (remap[c] != kNone) {
+            result.setVertex(remap[c], cellPosition[c]);
+        }
+    }
+    result.indices.resize(triangles.size() * 3);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        for (int c = 0; c < 3; ++c) {
+            result.indices[t * 3 + c] = remap[triangles[t].v[c]];
+        }
+    }
+
+    if (stats) {
+        *stats = local;
+    }
+    return result;
+}
+
+// ============================================================
+// Streaming
+// ============================================================
+
+MeshData simplifyVertexClusteringPly(const std::string& path, const ClusterParams& params,
+                                     ClusterStats* stats) {
+    using PoissonRecon::PlyFile;
+    using PoissonRecon::PlyProperty;
+
+    std::vector<std::string> elements;
+    int fileType = 0;
+    float version = 0.0f;
+    std::unique_ptr<PlyFile> ply(PlyFile::Read(path, elements, fileType, version));
+    if (!ply) {
+        throw std::runtime_error("Could not open PLY file: " + path);
+    }
+
+    ClusterStats local;
+    MeshData result;
+    MallocBuffer<StreamVertex> vertices;
+    ClusterGrid grid;
+    BlockHashMap cellIndex;             // Morton key -> cell slot
+    MallocBuffer<StreamCell> cells;
+    BlockHashMap triangleIndex;         // v[0] << 32 | v[1] -> first triangle
+    MallocBuffer<StreamTriangle> triangles;
+    bool haveVertices = false;
+
+    for (std::string& name : elements) {
+        size_t count = 0;
+        ply->get_element_description(name, count);
+
+        if (name == "vertex") {
+            if (count >= kNone) {
+                throw std::length_error("Mesh too large for 32-bit clustering indices");
+            }
+            for (int a = 0; a < 3; ++a) {
+                const PlyProperty property(std::string(1, static_cast<char>('x' + a)), PLY_FLOAT,
+                                           PLY_FLOAT,
+                                           static_cast<int>(offsetof(StreamVertex, p) + a * sizeof(float)));
+                if (!ply->get_property(name, &property)) {
+                    throw std::runtime_error("PLY vertices lack x, y or z");
+                }
+            }
+            vertices.resize(count);
+            const float inf = std::numeric_limits<float>::infinity();
+            Point3D lo(inf, inf, inf);
+            Point3D hi(-inf, -inf, -inf);
+            for (size_t v = 0; v < count; ++v) {
+                StreamVertex& vertex = vertices[v];
+                ply->get_element(&vertex);
+                lo = Point3D(std::min(lo.x, vertex.p[0]), std::min(lo.y, vertex.p[1]), std::min(lo.z, vertex.p[2]));
+                hi = Point3D(std::max(hi.x, vertex.p[0]), std::max(hi.y, vertex.p[1]), std::max(hi.z, vertex.p[2]));
+            }
+            haveVertices = true;
+            if (count == 0) {
+                continue;
+            }
+            if (!std::isfinite(lo.x) || !std::isfinite(lo.y) || !std::isfinite(lo.z) ||
+                !std::isfinite(hi.x) || !std::isfinite(hi.y) || !std::isfinite(hi.z)) {
+                throw std::invalid_argument("Non-finite vertex position");
+            }
+
+            // Cells are keyed by Morton code; slots stay dense and below
+            // kReferenced so the flag fits beside them
+            grid = ClusterGrid::fit(lo, hi, params.gridResolution, params.cellSize);
+            for (StreamVertex& vertex : vertices) {
+                const uint64_t key = grid.cellKey(Point3D(vertex.p[0], vertex.p[1], vertex.p[2]));
+                bool inserted = false;
+                const uint32_t slot = cellIndex.insert(key, static_cast<uint32_t>(cells.size()), inserted);
+                if (inserted) {
+                    if ((params.maxCells > 0 && cells.size() >= params.maxCells) || slot >= kReferenced) {
+                        throw std::length_error("Clustering grid exceeds the cell budget");
+                    }
+                    StreamCell cell;
+                    cell.key = key;
+                    cell.sum[0] = cell.sum[1] = cell.sum[2] = 0.0;
+                    cell.members = 0;
+                    cells.push_back(cell);
+                }
+                vertex.cell = slot;
+            }
+        } else if (name == "face") {
+            if (!haveVertices) {
+                throw std::runtime_error("PLY faces precede their vertices");
+            }
+            PlyProperty property("vertex_indices", PLY_UINT, PLY_UINT,
+                                 static_cast<int>(offsetof(PlyFace, indices)), 1, PLY_UINT,
+                                 PLY_UINT, static_cast<int>(offsetof(PlyFace, count)));
+            if (!ply->get_property(name, &property)) {
+                property.name = "vertex_index";
+                if (!ply->get_property(name, &property)) {
+                    throw std::runtime_error("PLY faces lack vertex_indices");
+                }
+            }
+
+            // Polygons are fan-triangulated; each triangle adds its plane to
+            // its distinct cells and is counted into the triangle table
+            auto corner = [&](unsigned int index) -> StreamVertex& {
+                if (index >= vertices.size()) {
+                    throw std::out_of_range("Triangle index out of range");
+                }
+                StreamVertex& vertex = vertices[index];
+                if (!(vertex.cell & kReferenced)) {
+                    StreamCell& cell = cells[vertex.cell];
+                    cell.sum[0] += vertex.p[0];
+                    cell.sum[1] += vertex.p[1];
+                    cell.sum[2] += vertex.p[2];
+                    ++cell.members;
+                    vertex.cell |= kReferenced;
+                }
+                return vertex;
+            };
+            for (size_t f = 0; f < count; ++f) {
+                PlyFace face = {0, nullptr};
+                ply->get_element(&face);
+                const std::unique_ptr<unsigned int, decltype(&std::free)> owned(face.indices, &std::free);
+                for (unsigned int k = 2; k < face.count; ++k) {
+                    const StreamVertex* corners[3] = {&corner(face.indices[0]), &corner(face.indices[k - 1]),
+                                                      &corner(face.indices[k])};
+                    CellTriangle tri;
+                    for (int c = 0; c < 3; ++c) {
+                        tri.v[c] = corners[c]->cell & ~kReferenced;
+                    }
+                    if (params.quadricPositions) {
+                        Quadric plane;
+                        addPlane(plane, Point3D(corners[0]->p[0], corners[0]->p[1], corners[0]->p[2]),
+                                 Point3D(corners[1]->p[0], corners[1]->p[1], corners[1]->p[2]),
+                                 Point3D(corners[2]->p[0], corners[2]->p[1], corners[2]->p[2]));
+                        cells[tri.v[0]].quadric += plane;
+                        if (tri.v[1] != tri.v[0]) {
+                            cells[tri.v[1]].quadric += plane;
+                        }
+                        if (tri.v[2] != tri.v[0] && tri.v[2] != tri.v[1]) {
+                            cells[tri.v[2]].quadric += plane;
+                        }
+                    }
+                    if (tri.v[0] == tri.v[1] || tri.v[1] == tri.v[2] || tri.v[2] == tri.v[0]) {
+                        continue;
+                    }
+                    while (tri.v[0] > tri.v[1] || tri.v[0] > tri.v[2]) {
+                        tri = CellTriangle{{tri.v[1], tri.v[2], tri.v[0]}};
+                    }
+                    // Cell slots stay below kReferenced, so the pair key never
+                    // sets bit 63
+                    if (triangles.size() >= kNone - 1) {
+                        throw std::length_error("Mesh too large for 32-bit clustering indices");
+                    }
+                    const uint32_t slot = static_cast<uint32_t>(triangles.size());
+                    bool inserted = false;
+                    uint32_t t = triangleIndex.insert(static_cast<uint64_t>(tri.v[0]) << 32 | tri.v[1], slot, inserted);
+                    if (!inserted) {
+                        while (!(triangles[t].tri == tri) && triangles[t].next != kNone) {
+                            t = triangles[t].next;
+                        }
+                        if (triangles[t].tri == tri) {
+                            ++triangles[t].copies;
+                            continue;
+                        }
+                        triangles[t].next = slot;
+                    }
+                    triangles.push_back(StreamTriangle{tri, 1, kNone});
+                }
+            }
+            // Nothing after the faces is needed
+            break;
+        } else {
+            ply->get_other_element(name, count);
+        }
+    }
+    vertices = MallocBuffer<StreamVertex>();
+
+    // Triangles touching under-populated cells are dropped; the cells left
+    // referenced become output vertices in Morton order
+    MallocBuffer<uint32_t> remap(cells.size(), kNone);
+    size_t kept = 0;
+    for (const StreamTriangle& entry : triangles) {
+        bool keep = true;
+        for (int c = 0; c < 3; ++c) {
+            keep = keep && cells[entry.tri.v[c]].members >= params.minClusterSize;
+        }
+        if (keep) {
+            for (int c = 0; c < 3; ++c) {
+                remap[entry.tri.v[c]] = 0;
+            }
+            local.duplicateTriangles += entry.copies - 1;
+            triangles[kept++] = entry;
+        }
+    }
+    triangles.resize(kept);
+
+    MallocBuffer<uint64_t> keys;
+    MallocBuffer<uint32_t> order;
+    for (uint32_t c = 0; c < cells.size(); ++c) {
+        if (remap[c] != kNone) {
+            keys.push_back(cells[c].key);
+            order.push_back(c);
+        }
+    }
+    sortByCell(keys, order, grid);
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        remap[order[i]] = i;
+    }
+
+    result.vertices.resize(order.size() * 3);
+    for (uint32_t c = 0; c < cells.size(); ++c) {
+        const StreamCell& cell = cells[c];
+        if (cell.members == 0) {
+            continue;
+        }
+        ++local.occupiedCells;
+        const double members = static_cast<double>(cell.members);
+        const Point3D mean(static_cast<float>(cell.sum[0] / members), static_cast<float>(cell.sum[1] / members),
+                           static_cast<float>(cell.sum[2] / members));
+        Point3D position = mean;
+        if (params.quadricPositions && !placeInCell(grid, cell.quadric, mean, position)) {
+            ++local.centroidCells;
+        }
+        if (remap[c] != kNone) {
+            result.setVertex(remap[c], position);
+        }
+    }
+
+    // Same triangle order as the in-memory path: rotated to the smallest
+    // output vertex, sorted
+    std::vector<CellTriangle> output(triangles.size());
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        CellTriangle tri{{remap[triangles[t].tri.v[0]], remap[triangles[t].tri.v[1]], remap[triangles[t].tri.v[2]]}};
+        while (tri.v[0] > tri.v[1] || tri.v[0] > tri.v[2]) {
+            tri = CellTriangle{{tri.v[1], tri.v[2], tri.v[0]}};
+        }
+        output[t] = tri;
+    }
+    std::sort(output.begin(), output.end());
+    result.indices.resize(output.size() * 3);
+    for (size_t t = 0; t < output.size(); ++t) {
+        for (int c = 0; c < 3; ++c) {
+            result.indices[t * 3 + c] = output[t].v[c];
+        }
+    }
+
+    if (stats) {
+        *stats = local;
+    }
+    return result;
+}
+
+} // namespace mesh
@@ -0,0 +1,73 @@
+//
+//  MeshClustering.hpp
+//  3D
+//
+//  Vertex clustering simplification (Rossignac & Borrel 1993) with quadric
+//  representatives (Lindstrom 2000). Vertices are bucketed by the Morton
+//  code of their grid cell and radix sorted, so every cell is a contiguous
+//  run; cell quadrics are summed in parallel over a cell-to-triangle CSR,
+//  and the remapped triangles are deduplicated by sorting. A streaming
+//  variant reads PLY files too large to load, keeping only per-cell state
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+#include <string>
+
+namespace mesh {
+
+/// Uniform grid of cubic cells anchored at `origin`
+struct ClusterGrid {
+    Point3D origin;
+    float cellSize = 1.0f;
+    uint32_t cells[3] = {1, 1, 1};      // Per axis, at most 2^21
+
+    /// Grid over the box [lo, hi]: `resolution` cells along its longest
+    /// axis, or cells of `cellSize` when that is > 0. Throws
+    /// std::invalid_argument if an axis would need more than 2^21 cells
+    static ClusterGrid fit(const Point3D& lo, const Point3D& hi, uint32_t resolution, float cellSize = 0.0f);
+
+    /// Morton code of the cell holding `p` (clamped into the grid)
+    uint64_t cellKey(const Point3D& p) const;
+
+    /// Center of the cell holding `p` (clamped into the grid)
+    Point3D cellCenter(const Point3D& p) const;
+};
+
+struct ClusterParams {
+    uint32_t gridResolution = 32;   // Cells along the longest bounding box axis
+    float cellSize = 0.0f;          // Cell edge length in model units; overrides gridResolution when > 0
+    uint32_t minClusterSize = 1;    // Triangles touching a cell with fewer vertices are dropped
+    bool quadricPositions = true;   // Place each cell's vertex at its quadric optimum (false: vertex mean)
+    size_t maxCells = 0;            // Streaming: cap on the cell table, std::length_error past it (0 = none)
+};
+
+struct ClusterStats {
+    size_t occupiedCells = 0;
+    size_t centroidCells = 0;       // Quadric singular or optimum outside the cell: vertex mean used
+    size_t duplicateTriangles = 0;  // Remapped triangles dropped as exact (same winding) copies
+};
+
+/// Simplify an indexed triangle mesh by merging all vertices in a grid
+/// cell into one. Triangles left with two corners in one cell disappear,
+/// copies of the same triangle are merged, windings are kept. Each cell's
+/// vertex sits at the optimum of the area-weighted plane quadrics of all
+/// triangles touching it, falling back to the mean of its vertices.
+/// Unreferenced vertices are ignored; output vertices are in Morton order
+MeshData simplifyVertexClustering(const float* vertices, size_t vertexCount,
+                                  const uint32_t* indices, size_t indexCount,
+                                  const ClusterParams& params,
+                                  ClusterStats* stats = nullptr);
+
+/// simplifyVertexClustering over the PLY file at `path` (ascii or binary,
+/// polygons fan-triangulated), read in one sequential pass with PlyFile.
+/// Faces are never stored: each one adds its plane to the quadrics of the
+/// cells it touches in a hash table and its remapped triangle to a
+/// deduplicating table, so memory follows the output size plus 16 bytes
+/// per input vertex, which the faces index. Output matches the in-memory
+/// path except that unreferenced vertices still widen the grid bounds.
+/// Throws std::runtime_error on unreadable files
+MeshData simplifyVertexClusteringPly(const std::string& path, const ClusterParams& params,
+                                     ClusterStats* stats = nullptr);
+
+} // namespace mesh
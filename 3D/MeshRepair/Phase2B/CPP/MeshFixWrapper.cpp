@@ -6,8 +6,11 @@
 //
 
 #include "MeshFixWrapper.hpp"
+#include "Parallel.hpp"
 #include <algorithm>
-#include <queue>
+#include <cmath>
+#include <chrono>
+#include <limits>
 #include <iostream>
 
 namespace mesh {
@@ -19,7 +22,27 @@ MeshFixWrapper::~MeshFixWrapper() {}
 // Main Repair Function
 // ============================================================
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point& since) {
+    const Clock::time_point now = Clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - since).count();
+    since = now;
+    return ms;
+}
+
+} // namespace
+
 MeshData MeshFixWrapper::repair(const MeshData& input, const Configuration& config) {
+    RepairReport report;
+    return repair(input, config, report);
+}
+
+MeshData MeshFixWrapper::repair(const MeshData& input, const Configuration& config, RepairReport& report) {
+    report = RepairReport();
+
     if (!input.isValid()) {
         if (config.verbose) {
             std::cerr << "MeshFix: Invalid input mesh" << std::endl;
@@ -27,7 +50,11 @@ MeshData MeshFixWrapper::repair(const MeshData& input, const Configuration& conf
         return input;
     }
 
+    const Clock::time_point start = Clock::now();
+    Clock::time_point stage = start;
+
     MeshData output = input;
+    report.inputTriangles = output.triangleCount();
 
     if (config.verbose) {
         std::cout << "MeshFix: Starting repair..." << std::endl;
@@ -35,42 +62,92 @@ MeshData MeshFixWrapper::repair(const MeshData& input, const Configuration& conf
                   << output.triangleCount() << " triangles" << std::endl;
     }
 
+    // Edge table is built once and shared by the manifold and hole stages;
+    // removed faces are only marked and compacted after hole filling
+    EdgeTable edges;
+    edges.build(output);
+    std::vector<uint8_t> removedFaces(output.triangleCount(), 0);
+    report.edgeTableMs = elapsedMs(stage);
+
     // Step 1: Remove non-manifold edges
     if (config.removeNonManifold) {
-        removeNonManifoldEdges(output);
+        report.nonManifoldTrianglesRemoved = removeNonManifoldEdges(edges, removedFaces);
         if (config.verbose) {
-            std::cout << "  After manifold repair: " << output.triangleCount() << " triangles" << std::endl;
+            std::cout << "  After manifold repair: "
+                      << output.triangleCount() - report.nonManifoldTrianglesRemoved << " triangles" << std::endl;
         }
     }
+    report.nonManifoldMs = elapsedMs(stage);
 
     // Step 2: Detect and fill holes
-    auto holes = detectHoles(output);
+    auto holes = detectHoles(output, edges, removedFaces);
+    report.holesFound = static_cast<int>(holes.size());
+    report.holeDetectionMs = elapsedMs(stage);
     if (config.verbose) {
         std::cout << "  Detected " << holes.size() << " holes" << std::endl;
     }
 
-    int filledCount = 0;
+    size_t holeBytes = 0;
     for (const auto& hole : holes) {
-        if (static_cast<int>(hole.boundaryVertices.size()) <= config.maxHoleSize) {
-            fillHole(output, hole);
-            filledCount++;
-        }
+        holeBytes += (hole.boundaryVertices.capacity() + hole.oppositeVertices.capacity()) * sizeof(uint32_t);
     }
-
-    if (config.verbose && filledCount > 0) {
-        std::cout << "  Filled " << filledCount << " holes" << std::endl;
+    report.peakBytes = input.memoryBytes() + output.memoryBytes() + edges.memoryBytes() +
+                       removedFaces.capacity() + holeBytes;
+
+    const size_t trianglesBeforeFill = output.triangleCount();
+    report.holesFilled = fillHoles(output, holes, config.maxHoleSize);
+    report.fillTrianglesAdded = output.triangleCount() - trianglesBeforeFill;
+    report.peakBytes = std::max(report.peakBytes,
+                                input.memoryBytes() + output.memoryBytes() + edges.memoryBytes() +
+                                removedFaces.capacity() + holeBytes);
+
+    if (config.verbose && report.holesFilled > 0) {
+        std::cout << "  Filled " << report.holesFilled << " holes" << std::endl;
     }
 
+    compactFaces(output, removedFaces);
+    report.holeFillingMs = elapsedMs(stage);
+
     // Step 3: Remove small disconnected components
     if (config.removeSmallComponents) {
-        removeSmallComponents(output, config.minComponentSize);
+        const size_t trianglesBefore = output.triangleCount();
+        report.componentsDropped = removeSmallComponents(output, config.minComponentSize);
+        report.componentTrianglesRemoved = trianglesBefore - output.triangleCount();
+
+        // Labels, referenced flags, sizes, keep flags and union-find parents
+        const size_t componentScratch = output.vertexCount() * (3 * sizeof(uint32_t) + 2 * sizeof(uint8_t));
+        report.peakBytes = std::max(report.peakBytes,
+                                    input.memoryBytes() + output.memoryBytes() + componentScratch);
+
         if (config.verbose) {
-            std::cout << "  After component cleanup: " << output.vertexCount() << " vertices" << std::endl;
+            std::cout << "  Removed " << report.componentsDropped << " small components" << std::endl;
+            std::cout << "  After component cleanup: " << output.triangleCount() << " triangles" << std::endl;
         }
     }
+    report.componentsMs = elapsedMs(stage);
+
+    // Step 4: Drop vertices orphaned by the removed triangles
+    const size_t bytesBeforeCompaction = output.memoryBytes();
+    report.verticesRemoved = compactVertices(output);
+    if (report.verticesRemoved > 0) {
+        // Old and new vertex buffers coexist, plus the flag and remap arrays
+        const size_t compactionScratch = (output.vertexCount() + report.verticesRemoved) *
+                                         (sizeof(uint32_t) + sizeof(uint8_t));
+        report.peakBytes = std::max(report.peakBytes,
+                                    input.memoryBytes() + bytesBeforeCompaction +
+                                    output.vertices.capacity() * sizeof(float) +
+                                    output.normals.capacity() * sizeof(float) + compactionScratch);
+    }
+    report.vertexCompactionMs = elapsedMs(stage);
+    if (config.verbose && report.verticesRemoved > 0) {
+        std::cout << "  Removed " << report.verticesRemoved << " unreferenced vertices" << std::endl;
+    }
+
+    report.outputTriangles = output.triangleCount();
+    report.totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
 
     if (config.verbose) {
-        std::cout << "MeshFix: Repair complete!" << std::endl;
+        std::cout << "MeshFix: Repair complete! (" << report.totalMs << " ms)" << std::endl;
         std::cout << "  Output: " << output.vertexCount() << " vertices, "
                   << output.triangleCount() << " triangles" << std::endl;
     }
@@ -78,129 +155,144 @@ MeshData MeshFixWrapper::repair(const MeshData& input, const Configuration& conf
     return output;
 }
 
-// ============================================================
-// Edge Map Building
-// ============================================================
-
-std::unordered_map<MeshFixWrapper::Edge, int, MeshFixWrapper::EdgeHash>
-MeshFixWrapper::buildEdgeMap(const MeshData& mesh) {
-    std::unordered_map<Edge, int, EdgeHash> edgeCount;
-
-    for (size_t i = 0; i < mesh.triangleCount(); ++i) {
-        auto tri = mesh.getTriangle(i);
-
-        edgeCount[Edge(tri.i0, tri.i1)]++;
-        edgeCount[Edge(tri.i1, tri.i2)]++;
-        edgeCount[Edge(tri.i2, tri.i0)]++;
-    }
-
-    return edgeCount;
-}
-
 // ============================================================
 // Non-Manifold Edge Removal
 // ============================================================
 
-void MeshFixWrapper::removeNonManifoldEdges(MeshData& mesh) {
-    auto edgeCount = buildEdgeMap(mesh);
-
-    // Find edges that are shared by more than 2 triangles (non-manifold)
-    std::set<Edge> nonManifoldEdges;
-    for (const auto& [edge, count] : edgeCount) {
-        if (count > 2) {
-            nonManifoldEdges.insert(edge);
+uint32_t MeshFixWrapper::liveFaceCount(const EdgeTable& edges, size_t edge,
+                                       const std::vector<uint8_t>& removedFaces) {
+    uint32_t count = 0;
+    for (const uint32_t* h = edges.halfEdgesBegin(edge); h != edges.halfEdgesEnd(edge); ++h) {
+        if (!removedFaces[*h / 3]) {
+            count++;
         }
     }
+    return count;
+}
 
-    if (nonManifoldEdges.empty()) {
-        return;
+size_t MeshFixWrapper::removeNonManifoldEdges(const EdgeTable& edges, std::vector<uint8_t>& removedFaces) {
+    // Mark triangles on edges shared by more than 2 triangles (non-manifold)
+    size_t removed = 0;
+    for (size_t e = 0; e < edges.edgeCount(); ++e) {
+        if (edges.faceCount(e) <= 2) {
+            continue;
+        }
+        for (const uint32_t* h = edges.halfEdgesBegin(e); h != edges.halfEdgesEnd(e); ++h) {
+            uint8_t& flag = removedFaces[*h / 3];
+            if (!flag) {
+                flag = 1;
+                removed++;
+            }
+        }
     }
+    return removed;
+}
 
-    // Remove triangles that contain non-manifold edges
-    std::vector<uint32_t> newIndices;
-    for (size_t i = 0; i < mesh.triangleCount(); ++i) {
-        auto tri = mesh.getTriangle(i);
-
-        bool hasNonManifold =
-            nonManifoldEdges.count(Edge(tri.i0, tri.i1)) > 0 ||
-            nonManifoldEdges.count(Edge(tri.i1, tri.i2)) > 0 ||
-            nonManifoldEdges.count(Edge(tri.i2, tri.i0)) > 0;
-
-        if (!hasNonManifold) {
-            newIndices.push_back(tri.i0);
-            newIndices.push_back(tri.i1);
-            newIndices.push_back(tri.i2);
+void MeshFixWrapper::compactFaces(MeshData& mesh, const std::vector<uint8_t>& removedFaces) {
+    // Faces past the mask (e.g. hole fills) are always kept
+    size_t kept = 0;
+    const size_t triCount = mesh.triangleCount();
+    for (size_t t = 0; t < triCount; ++t) {
+        if (t < removedFaces.size() && removedFaces[t]) {
+            continue;
+        }
+        if (kept != t) {
+            std::copy(&mesh.indices[t * 3], &mesh.indices[t * 3] + 3, &mesh.indices[kept * 3]);
         }
+        kept++;
     }
-
-    mesh.indices = newIndices;
+    mesh.indices.resize(kept * 3);
 }
 
 // ============================================================
 // Hole Detection
 // ============================================================
 
-std::vector<MeshFixWrapper::Hole> MeshFixWrapper::detectHoles(const MeshData& mesh) {
-    auto edgeCount = buildEdgeMap(mesh);
-
-    // Find boundary edges (shared by only 1 triangle)
-    std::vector<Edge> boundaryEdges;
-    for (const auto& [edge, count] : edgeCount) {
-        if (count == 1) {
-            boundaryEdges.push_back(edge);
+std::vector<MeshFixWrapper::Hole> MeshFixWrapper::detectHoles(const MeshData& mesh, const EdgeTable& edges,
+                                                              const std::vector<uint8_t>& removedFaces) {
+    const uint32_t* indices = mesh.indices.data();
+
+    // Boundary half-edges: the only remaining triangle use of an edge
+    std::vector<uint32_t> boundary;
+    std::vector<uint32_t> origins;
+    for (size_t e = 0; e < edges.edgeCount(); ++e) {
+        if (liveFaceCount(edges, e, removedFaces) != 1) continue;
+        for (const uint32_t* h = edges.halfEdgesBegin(e); h != edges.halfEdgesEnd(e); ++h) {
+            if (!removedFaces[*h / 3]) {
+                boundary.push_back(*h);
+                origins.push_back(indices[*h]);
+                break;
+            }
         }
     }
 
-    if (boundaryEdges.empty()) {
+    if (boundary.empty()) {
         return {};
     }
 
-    // Group boundary edges into holes (connected components)
-    std::unordered_map<uint32_t, std::vector<uint32_t>> adjacency;
-    for (const auto& edge : boundaryEdges) {
-        adjacency[edge.v0].push_back(edge.v1);
-        adjacency[edge.v1].push_back(edge.v0);
+    // Outgoing boundary half-edges per vertex (values index into `boundary`)
+    std::vector<uint32_t> slots(boundary.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        slots[i] = static_cast<uint32_t>(i);
     }
+    CSRAdjacency outgoing;
+    outgoing.buildGrouped(mesh.vertexCount(), origins.data(), slots.data(), boundary.size());
 
+    // Walk each loop head-to-tail so boundaryVertices come out in loop order
     std::vector<Hole> holes;
-    std::set<uint32_t> visited;
-
-    for (const auto& [startVertex, _] : adjacency) {
-        if (visited.count(startVertex)) continue;
-
-        // BFS to find connected boundary vertices
-        std::vector<uint32_t> hole;
-        std::queue<uint32_t> queue;
-        queue.push(startVertex);
-        visited.insert(startVertex);
-
-        while (!queue.empty()) {
-            uint32_t v = queue.front();
-            queue.pop();
-            hole.push_back(v);
-
-            for (uint32_t neighbor : adjacency[v]) {
-                if (!visited.count(neighbor)) {
-                    visited.insert(neighbor);
-                    queue.push(neighbor);
+    std::vector<uint8_t> visited(boundary.size(), 0);
+
+    for (size_t start = 0; start < boundary.size(); ++start) {
+        if (visited[start]) continue;
+
+        Hole h;
+        const uint32_t startVertex = origins[start];
+        size_t current = start;
+        bool closed = false;
+
+        while (true) {
+            visited[current] = 1;
+            const uint32_t he = boundary[current];
+            const uint32_t to = indices[MeshAdjacency::next(he)];
+            h.boundaryVertices.push_back(indices[he]);
+            h.oppositeVertices.push_back(indices[MeshAdjacency::prev(he)]);
+
+            if (to == startVertex) {
+                closed = true;
+                break;
+            }
+
+            size_t nextSlot = EdgeTable::npos;
+            for (const uint32_t* o = outgoing.begin(to); o != outgoing.end(to); ++o) {
+                if (!visited[*o]) {
+                    nextSlot = *o;
+                    break;
                 }
             }
+            if (nextSlot == EdgeTable::npos) {
+                break; // Open chain through a non-manifold vertex
+            }
+            current = nextSlot;
         }
 
-        if (!hole.empty()) {
-            Hole h;
-            h.boundaryVertices = hole;
-
-            // Compute hole center
-            Point3D center(0, 0, 0);
-            for (uint32_t v : hole) {
-                center = center + mesh.getVertex(v);
-            }
-            h.center = center / static_cast<float>(hole.size());
-            h.area = 0.0f; // TODO: compute actual area
+        if (!closed || h.boundaryVertices.size() < 3) {
+            continue;
+        }
 
-            holes.push_back(h);
+        // Compute hole center and vector area
+        const size_t n = h.boundaryVertices.size();
+        Point3D center(0, 0, 0);
+        Point3D vectorArea(0, 0, 0);
+        for (size_t i = 0; i < n; ++i) {
+            Point3D a = mesh.getVertex(h.boundaryVertices[i]);
+            Point3D b = mesh.getVertex(h.boundaryVertices[(i + 1) % n]);
+            center = center + a;
+            vectorArea = vectorArea + a.cross(b);
         }
+        h.center = center / static_cast<float>(n);
+        h.area = 0.5f * vectorArea.length();
+
+        holes.push_back(std::move(h));
     }
 
     return holes;
@@ -210,115 +302,324 @@ std::vector<MeshFixWrapper::Hole> MeshFixWrapper::detectHoles(const MeshData& me
 // Hole Filling
 // ============================================================
 
-void MeshFixWrapper::fillHole(MeshData& mesh, const Hole& hole) {
-    if (hole.boundaryVertices.size() < 3) {
-        return;
+namespace {
+
+// Above this many boundary vertices the O(n^3) triangulation is replaced
+// by O(n^2) ear clipping
+constexpr size_t MaxMinimumWeightHoleSize = 200;
+
+/// Liepa-style triangle weight: worst dihedral angle first, then area
+struct FillWeight {
+    float maxDihedral;
+    float area;
+
+    static FillWeight infinite() {
+        return {std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+    }
+
+    bool operator<(const FillWeight& other) const {
+        const float eps = 1e-5f;
+        if (maxDihedral < other.maxDihedral - eps) return true;
+        if (maxDihedral > other.maxDihedral + eps) return false;
+        return area < other.area;
     }
+};
 
-    triangulateHole(mesh, hole.boundaryVertices);
+Point3D triangleNormal(const Point3D& a, const Point3D& b, const Point3D& c) {
+    return (b - a).cross(c - a);
 }
 
-void MeshFixWrapper::triangulateHole(MeshData& mesh, const std::vector<uint32_t>& boundary) {
-    if (boundary.size() < 3) {
-        return;
+/// Angle between two (unnormalized) face normals, 0 for coplanar faces
+float dihedral(const Point3D& n0, const Point3D& n1) {
+    const float len = n0.length() * n1.length();
+    if (len < 1e-12f) {
+        return 0.0f;
     }
+    const float c = std::max(-1.0f, std::min(1.0f, n0.dot(n1) / len));
+    return std::acos(c);
+}
 
-    // Simple fan triangulation from first vertex
-    // For production: use ear-clipping or Delaunay triangulation
-    uint32_t centerIdx = boundary[0];
+/// Emit a fill triangle over loop positions i < m < k
+/// Reversed so the shared boundary edges run opposite to the mesh faces
+void emitFillTriangle(const std::vector<uint32_t>& loop, size_t i, size_t m, size_t k,
+                      std::vector<uint32_t>& triangles) {
+    triangles.push_back(loop[k]);
+    triangles.push_back(loop[m]);
+    triangles.push_back(loop[i]);
+}
+
+} // namespace
 
-    for (size_t i = 1; i + 1 < boundary.size(); ++i) {
-        mesh.addTriangle(centerIdx, boundary[i], boundary[i + 1]);
+int MeshFixWrapper::fillHoles(MeshData& mesh, const std::vector<Hole>& holes, int maxHoleSize) {
+    std::vector<const Hole*> fillable;
+    for (const auto& hole : holes) {
+        if (static_cast<int>(hole.boundaryVertices.size()) <= maxHoleSize) {
+            fillable.push_back(&hole);
+        }
     }
-}
 
-// ============================================================
-// Connected Components
-// ============================================================
+    // Holes are independent: triangulate them in parallel, append in order
+    std::vector<std::vector<uint32_t>> patches(fillable.size());
+    parallelFor(fillable.size(), [&](size_t i) {
+        triangulateHole(mesh, *fillable[i], patches[i]);
+    }, 1);
 
-std::vector<std::vector<uint32_t>> MeshFixWrapper::findConnectedComponents(const MeshData& mesh) {
-    // Build vertex adjacency from triangles
-    std::unordered_map<uint32_t, std::vector<uint32_t>> adjacency;
+    for (const auto& patch : patches) {
+        mesh.indices.append(patch.data(), patch.data() + patch.size());
+    }
 
-    for (size_t i = 0; i < mesh.triangleCount(); ++i) {
-        auto tri = mesh.getTriangle(i);
+    return static_cast<int>(fillable.size());
+}
 
-        adjacency[tri.i0].push_back(tri.i1);
-        adjacency[tri.i0].push_back(tri.i2);
-        adjacency[tri.i1].push_back(tri.i0);
-        adjacency[tri.i1].push_back(tri.i2);
-        adjacency[tri.i2].push_back(tri.i0);
-        adjacency[tri.i2].push_back(tri.i1);
+void MeshFixWrapper::triangulateHole(const MeshData& mesh, const Hole& hole, std::vector<uint32_t>& triangles) {
+    const size_t n = hole.boundaryVertices.size();
+    if (n < 3) {
+        return;
     }
 
-    std::vector<std::vector<uint32_t>> components;
-    std::set<uint32_t> visited;
+    triangles.reserve((n - 2) * 3);
+    if (n <= MaxMinimumWeightHoleSize) {
+        triangulateMinimumWeight(mesh, hole, triangles);
+    } else {
+        triangulateEarClipping(mesh, hole, triangles);
+    }
+}
 
-    for (const auto& [vertex, _] : adjacency) {
-        if (visited.count(vertex)) continue;
+void MeshFixWrapper::triangulateMinimumWeight(const MeshData& mesh, const Hole& hole,
+                                              std::vector<uint32_t>& triangles) {
+    // Liepa (2003): weight[i][k] is the best triangulation of loop i..k,
+    // minimizing the largest dihedral angle and then the total area
+    const std::vector<uint32_t>& loop = hole.boundaryVertices;
+    const size_t n = loop.size();
+
+    std::vector<Point3D> p(n);
+    std::vector<Point3D> outside(n);  // Normal of the mesh face on edge i -> i+1
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = mesh.getVertex(loop[i]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        // Mesh face is (loop[i], loop[i+1], opposite); the fill runs reversed
+        outside[i] = triangleNormal(p[i], p[(i + 1) % n], mesh.getVertex(hole.oppositeVertices[i]));
+    }
 
-        std::vector<uint32_t> component;
-        std::queue<uint32_t> queue;
-        queue.push(vertex);
-        visited.insert(vertex);
+    std::vector<FillWeight> weight(n * n, FillWeight{0.0f, 0.0f});
+    std::vector<uint32_t> split(n * n, 0);
+    auto at = [n](size_t i, size_t k) { return i * n + k; };
+
+    // Normal of the fill triangle on loop positions i < m < k
+    auto fillNormal = [&](size_t i, size_t m, size_t k) {
+        return triangleNormal(p[k], p[m], p[i]);
+    };
+    // Fill normal of the triangle chosen on the inner side of diagonal (i, k)
+    auto innerNormal = [&](size_t i, size_t k) {
+        return fillNormal(i, split[at(i, k)], k);
+    };
+
+    for (size_t span = 2; span < n; ++span) {
+        for (size_t i = 0; i + span < n; ++i) {
+            const size_t k = i + span;
+            FillWeight best = FillWeight::infinite();
+            uint32_t bestSplit = static_cast<uint32_t>(i + 1);
+
+            for (size_t m = i + 1; m < k; ++m) {
+                const Point3D normal = fillNormal(i, m, k);
+
+                // Reversed orientation means the fill normal should match
+                // the neighbouring face normal across every shared edge
+                float angle = 0.0f;
+                angle = std::max(angle, dihedral(normal, m == i + 1 ? outside[i] : innerNormal(i, m)));
+                angle = std::max(angle, dihedral(normal, k == m + 1 ? outside[m] : innerNormal(m, k)));
+                if (i == 0 && k == n - 1) {
+                    angle = std::max(angle, dihedral(normal, outside[n - 1]));
+                }
 
-        while (!queue.empty()) {
-            uint32_t v = queue.front();
-            queue.pop();
-            component.push_back(v);
+                const FillWeight& left = weight[at(i, m)];
+                const FillWeight& right = weight[at(m, k)];
+                FillWeight candidate{
+                    std::max(angle, std::max(left.maxDihedral, right.maxDihedral)),
+                    left.area + right.area + 0.5f * normal.length()
+                };
 
-            for (uint32_t neighbor : adjacency[v]) {
-                if (!visited.count(neighbor)) {
-                    visited.insert(neighbor);
-                    queue.push(neighbor);
+                if (candidate < best) {
+                    best = candidate;
+                    bestSplit = static_cast<uint32_t>(m);
                 }
             }
+
+            weight[at(i, k)] = best;
+            split[at(i, k)] = bestSplit;
+        }
+    }
+
+    // Trace back the optimal splits
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(0, n - 1);
+    while (!stack.empty()) {
+        auto [i, k] = stack.back();
+        stack.pop_back();
+        if (k - i < 2) continue;
+
+        const size_t m = split[at(i, k)];
+        emitFillTriangle(loop, i, m, k, triangles);
+        stack.emplace_back(i, m);
+        stack.emplace_back(m, k);
+    }
+}
+
+void MeshFixWrapper::triangulateEarClipping(const MeshData& mesh, const Hole& hole,
+                                            std::vector<uint32_t>& triangles) {
+    const std::vector<uint32_t>& loop = hole.boundaryVertices;
+    const size_t n = loop.size();
+
+    // Project onto the plane of the loop's vector area (Newell normal)
+    Point3D normal(0, 0, 0);
+    for (size_t i = 0; i < n; ++i) {
+        normal = normal + mesh.getVertex(loop[i]).cross(mesh.getVertex(loop[(i + 1) % n]));
+    }
+    normal = normal.normalized();
+    Point3D axisU = (std::fabs(normal.x) < 0.9f ? Point3D(1, 0, 0) : Point3D(0, 1, 0)).cross(normal).normalized();
+    Point3D axisV = normal.cross(axisU);
+
+    std::vector<float> u(n), v(n);
+    for (size_t i = 0; i < n; ++i) {
+        Point3D q = mesh.getVertex(loop[i]) - hole.center;
+        u[i] = q.dot(axisU);
+        v[i] = q.dot(axisV);
+    }
+
+    // With this projection the loop winds counter-clockwise
+    auto cross2 = [&](size_t a, size_t b, size_t c) {
+        return (u[b] - u[a]) * (v[c] - v[a]) - (v[b] - v[a]) * (u[c] - u[a]);
+    };
+    auto inside = [&](size_t a, size_t b, size_t c, size_t q) {
+        return cross2(a, b, q) > 0.0f && cross2(b, c, q) > 0.0f && cross2(c, a, q) > 0.0f;
+    };
+
+    std::vector<size_t> prevIdx(n), nextIdx(n);
+    for (size_t i = 0; i < n; ++i) {
+        prevIdx[i] = (i + n - 1) % n;
+        nextIdx[i] = (i + 1) % n;
+    }
+
+    size_t remaining = n;
+    size_t current = 0;
+    size_t sinceLastEar = 0;
+    while (remaining > 3) {
+        const size_t a = prevIdx[current];
+        const size_t c = nextIdx[current];
+
+        bool isEar = cross2(a, current, c) > 0.0f;
+        for (size_t q = nextIdx[c]; isEar && q != a; q = nextIdx[q]) {
+            if (inside(a, current, c, q)) {
+                isEar = false;
+            }
         }
 
-        components.push_back(component);
+        // Degenerate loops may have no strict ear left: clip anyway
+        if (isEar || sinceLastEar > remaining) {
+            triangles.push_back(loop[c]);
+            triangles.push_back(loop[current]);
+            triangles.push_back(loop[a]);
+            nextIdx[a] = c;
+            prevIdx[c] = a;
+            remaining--;
+            sinceLastEar = 0;
+            current = c;
+        } else {
+            current = c;
+            sinceLastEar++;
+        }
     }
 
-    return components;
+    const size_t a = prevIdx[current];
+    const size_t c = nextIdx[current];
+    triangles.push_back(loop[c]);
+    triangles.push_back(loop[current]);
+    triangles.push_back(loop[a]);
 }
 
-void MeshFixWrapper::removeSmallComponents(MeshData& mesh, int minSize) {
-    auto components = findConnectedComponents(mesh);
+// ============================================================
+// Connected Components
+// ============================================================
+
+std::vector<uint32_t> MeshFixWrapper::labelComponents(const MeshData& mesh) {
+    const size_t vertexCount = mesh.vertexCount();
+    const size_t triCount = mesh.triangleCount();
+    const uint32_t* indices = mesh.indices.data();
+
+    // Union the endpoints of two edges per triangle, in parallel
+    ConcurrentUnionFind sets(vertexCount);
+    parallelFor(triCount, [&](size_t t) {
+        const uint32_t* tri = indices + t * 3;
+        sets.unite(tri[0], tri[1]);
+        sets.unite(tri[1], tri[2]);
+    });
+
+    // Flatten to root labels; unreferenced vertices stay singletons
+    std::vector<uint32_t> labels(vertexCount);
+    parallelFor(vertexCount, [&](size_t v) {
+        labels[v] = sets.find(static_cast<uint32_t>(v));
+    });
+
+    return labels;
+}
 
-    if (components.size() <= 1) {
-        return; // Only one component
+size_t MeshFixWrapper::removeSmallComponents(MeshData& mesh, int minSize) {
+    const size_t vertexCount = mesh.vertexCount();
+    const size_t triCount = mesh.triangleCount();
+    if (triCount == 0) {
+        return 0;
     }
 
-    // Find largest component
-    size_t largestIdx = 0;
-    size_t largestSize = 0;
-    for (size_t i = 0; i < components.size(); ++i) {
-        if (components[i].size() > largestSize) {
-            largestSize = components[i].size();
-            largestIdx = i;
+    std::vector<uint32_t> labels = labelComponents(mesh);
+
+    // Component sizes in referenced vertices, indexed by root
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    for (size_t i = 0; i < triCount * 3; ++i) {
+        referenced[mesh.indices[i]] = 1;
+    }
+    std::vector<uint32_t> sizes(vertexCount, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        if (referenced[v]) {
+            sizes[labels[v]]++;
         }
     }
 
-    // Keep only vertices in largest component
-    std::set<uint32_t> keepVertices(
-        components[largestIdx].begin(),
-        components[largestIdx].end()
-    );
+    // Keep components of at least minSize vertices; the largest one is
+    // always kept so a small scan is never wiped out entirely
+    const uint32_t largest = static_cast<uint32_t>(
+        std::max_element(sizes.begin(), sizes.end()) - sizes.begin());
+    const uint32_t threshold = static_cast<uint32_t>(std::max(minSize, 0));
+
+    size_t dropped = 0;
+    std::vector<uint8_t> keep(vertexCount, 0);
+    for (size_t root = 0; root < vertexCount; ++root) {
+        if (sizes[root] == 0) continue;
+        if (sizes[root] >= threshold || root == largest) {
+            keep[root] = 1;
+        } else {
+            dropped++;
+        }
+    }
 
-    // Filter triangles
-    std::vector<uint32_t> newIndices;
-    for (size_t i = 0; i < mesh.triangleCount(); ++i) {
-        auto tri = mesh.getTriangle(i);
+    if (dropped == 0) {
+        return 0;
+    }
 
-        if (keepVertices.count(tri.i0) &&
-            keepVertices.count(tri.i1) &&
-            keepVertices.count(tri.i2)) {
-            newIndices.push_back(tri.i0);
-            newIndices.push_back(tri.i1);
-            newIndices.push_back(tri.i2);
+    // Filter triangles in place; all corners share one label
+    size_t kept = 0;
+    for (size_t t = 0; t < triCount; ++t) {
+        if (!keep[labels[mesh.indices[t * 3]]]) {
+            continue;
+        }
+        if (kept != t) {
+            std::copy(&mesh.indices[t * 3], &mesh.indices[t * 3] + 3, &mesh.indices[kept * 3]);
         }
+        kept++;
     }
+    mesh.indices.resize(kept * 3);
 
-    mesh.indices = newIndices;
+    return dropped;
 }
 
 } // namespace mesh
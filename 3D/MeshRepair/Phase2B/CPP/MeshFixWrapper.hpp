@@ -9,8 +9,6 @@
 #pragma once
 #include "MeshTypes.hpp"
 #include <memory>
-#include <unordered_map>
-#include <set>
 
 namespace mesh {
 
@@ -32,53 +30,75 @@ public:
         {}
     };
 
+    /// Statistics and per-stage wall times of one repair() call
+    struct RepairReport {
+        // Wall time per stage (milliseconds)
+        double edgeTableMs;
+        double nonManifoldMs;
+        double holeDetectionMs;
+        double holeFillingMs;
+        double componentsMs;
+        double vertexCompactionMs;
+        double totalMs;
+
+        size_t inputTriangles;
+        size_t outputTriangles;
+        size_t nonManifoldTrianglesRemoved;
+        size_t componentTrianglesRemoved;
+        size_t fillTrianglesAdded;
+        size_t verticesRemoved;
+
+        int holesFound;
+        int holesFilled;
+        size_t componentsDropped;
+
+        /// Peak bytes held by the mesh buffers, edge table and per-stage
+        /// scratch tracked by repair() (not a process-wide measurement)
+        size_t peakBytes;
+
+        RepairReport()
+            : edgeTableMs(0), nonManifoldMs(0), holeDetectionMs(0), holeFillingMs(0)
+            , componentsMs(0), vertexCompactionMs(0), totalMs(0)
+            , inputTriangles(0), outputTriangles(0), nonManifoldTrianglesRemoved(0)
+            , componentTrianglesRemoved(0), fillTrianglesAdded(0), verticesRemoved(0)
+            , holesFound(0), holesFilled(0), componentsDropped(0), peakBytes(0)
+        {}
+    };
+
     MeshFixWrapper();
     ~MeshFixWrapper();
 
     /// Main repair function
     MeshData repair(const MeshData& input, const Configuration& config = Configuration());
 
-private:
-    // Edge structure for manifold checking
-    struct Edge {
-        uint32_t v0, v1;
-
-        Edge(uint32_t a, uint32_t b) : v0(std::min(a, b)), v1(std::max(a, b)) {}
-
-        bool operator==(const Edge& other) const {
-            return v0 == other.v0 && v1 == other.v1;
-        }
-
-        bool operator<(const Edge& other) const {
-            if (v0 != other.v0) return v0 < other.v0;
-            return v1 < other.v1;
-        }
-    };
-
-    struct EdgeHash {
-        size_t operator()(const Edge& e) const {
-            return std::hash<uint32_t>()(e.v0) ^ (std::hash<uint32_t>()(e.v1) << 1);
-        }
-    };
+    /// Repair and fill `report` with statistics of the run
+    MeshData repair(const MeshData& input, const Configuration& config, RepairReport& report);
 
+private:
     // Hole detection and filling
     struct Hole {
-        std::vector<uint32_t> boundaryVertices;
+        std::vector<uint32_t> boundaryVertices;  // Loop order, following the boundary half-edges
+        std::vector<uint32_t> oppositeVertices;  // Third vertex of the mesh face on edge i -> i+1
         Point3D center;
-        float area;
+        float area;                              // Area of the loop's vector (Newell) normal
     };
 
-    std::vector<Hole> detectHoles(const MeshData& mesh);
-    void fillHole(MeshData& mesh, const Hole& hole);
-    void triangulateHole(MeshData& mesh, const std::vector<uint32_t>& boundary);
+    std::vector<Hole> detectHoles(const MeshData& mesh, const EdgeTable& edges,
+                                  const std::vector<uint8_t>& removedFaces);
+    int fillHoles(MeshData& mesh, const std::vector<Hole>& holes, int maxHoleSize);
+    static void triangulateHole(const MeshData& mesh, const Hole& hole, std::vector<uint32_t>& triangles);
+    static void triangulateMinimumWeight(const MeshData& mesh, const Hole& hole, std::vector<uint32_t>& triangles);
+    static void triangulateEarClipping(const MeshData& mesh, const Hole& hole, std::vector<uint32_t>& triangles);
 
-    // Manifold operations
-    void removeNonManifoldEdges(MeshData& mesh);
-    std::unordered_map<Edge, int, EdgeHash> buildEdgeMap(const MeshData& mesh);
+    // Manifold operations (mark faces in removedFaces, compacted later)
+    size_t removeNonManifoldEdges(const EdgeTable& edges, std::vector<uint8_t>& removedFaces);
+    static uint32_t liveFaceCount(const EdgeTable& edges, size_t edge,
+                                  const std::vector<uint8_t>& removedFaces);
+    void compactFaces(MeshData& mesh, const std::vector<uint8_t>& removedFaces);
 
     // Component operations
-    void removeSmallComponents(MeshData& mesh, int minSize);
-    std::vector<std::vector<uint32_t>> findConnectedComponents(const MeshData& mesh);
+    size_t removeSmallComponents(MeshData& mesh, int minSize);
+    std::vector<uint32_t> labelComponents(const MeshData& mesh);
 };
 
 } // namespace mesh
@@ -0,0 +1,1099 @@
+//
+//  MeshSimplification.cpp
+//  3D
+//
+//  Quadrics, the indexed candidate heap, the edge-collapse loop and LOD
+//  chain snapshots
+//
+
+#include "MeshSimplification.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace mesh {
+
+// ============================================================
+// Quadric
+// ============================================================
+
+Quadric::Quadric(double a, double b, double c, double d, double weight) {
+    q[0] = weight * a * a;
+    q[1] = weight * a * b;
+    q[2] = weight * a * c;
+    q[3] = weight * a * d;
+    q[4] = weight * b * b;
+    q[5] = weight * b * c;
+    q[6] = weight * b * d;
+    q[7] = weight * c * c;
+    q[8] = weight * c * d;
+    q[9] = weight * d * d;
+}
+
+double Quadric::evaluate(const Point3D& p) const {
+    const double x = p.x, y = p.y, z = p.z;
+    return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x +
+           q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y +
+           q[7] * z * z + 2.0 * q[8] * z +
+           q[9];
+}
+
+bool Quadric::optimum(Point3D& p) const {
+    // Cofactors of the symmetric 3x3 block
+    const double c00 = q[4] * q[7] - q[5] * q[5];
+    const double c01 = q[2] * q[5] - q[1] * q[7];
+    const double c02 = q[1] * q[5] - q[2] * q[4];
+    const double det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+
+    // Compared against the mean eigenvalue cubed, so the test is scale free
+    const double mean = (q[0] + q[4] + q[7]) / 3.0;
+    if (!(mean > 0.0) || !(std::abs(det) > 1e-3 * mean * mean * mean)) {
+        return false;
+    }
+
+    const double c11 = q[0] * q[7] - q[2] * q[2];
+    const double c12 = q[1] * q[2] - q[0] * q[5];
+    const double c22 = q[0] * q[4] - q[1] * q[1];
+    p.x = static_cast<float>(-(c00 * q[3] + c01 * q[6] + c02 * q[8]) / det);
+    p.y = static_cast<float>(-(c01 * q[3] + c11 * q[6] + c12 * q[8]) / det);
+    p.z = static_cast<float>(-(c02 * q[3] + c12 * q[6] + c22 * q[8]) / det);
+    return true;
+}
+
+Point3D Quadric::optimumNear(const Point3D& anchor, double tolerance) const {
+    // Eigen-decomposition of the 3x3 block by cyclic Jacobi rotations
+    double a[3][3] = {{q[0], q[1], q[2]}, {q[1], q[4], q[5]}, {q[2], q[5], q[7]}};
+    double v[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+    for (int sweep = 0; sweep < 16; ++sweep) {
+        const double off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if (!(off > 1e-30 * (a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2]))) {
+            break;
+        }
+        for (int i = 0; i < 2; ++i) {
+            for (int j = i + 1; j < 3; ++j) {
+                if (a[i][j] == 0.0) {
+                    continue;
+                }
+                const double theta = (a[j][j] - a[i][i]) / (2.0 * a[i][j]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const double aki = a[k][i], akj = a[k][j];
+                    a[k][i] = c * aki - s * akj;
+                    a[k][j] = s * aki + c * akj;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double aik = a[i][k], ajk = a[j][k];
+                    a[i][k] = c * aik - s * ajk;
+                    a[j][k] = s * aik + c * ajk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double vki = v[k][i], vkj = v[k][j];
+                    v[k][i] = c * vki - s * vkj;
+                    v[k][j] = s * vki + c * vkj;
+                }
+            }
+        }
+    }
+
+    // Step from the anchor along the well-constrained eigenvectors only
+    const double largest = std::max({a[0][0], a[1][1], a[2][2]});
+    const double residual[3] = {
+        -(q[3] + q[0] * anchor.x + q[1] * anchor.y + q[2] * anchor.z),
+        -(q[6] + q[1] * anchor.x + q[4] * anchor.y + q[5] * anchor.z),
+        -(q[8] + q[2] * anchor.x + q[5] * anchor.y + q[7] * anchor.z)};
+    double step[3] = {0.0, 0.0, 0.0};
+    for (int e = 0; e < 3; ++e) {
+        if (!(largest > 0.0) || !(a[e][e] > tolerance * largest)) {
+            continue;
+        }
+        const double along = (v[0][e] * residual[0] + v[1][e] * residual[1] + v[2][e] * residual[2]) / a[e][e];
+        for (int k = 0; k < 3; ++k) {
+            step[k] += along * v[k][e];
+        }
+    }
+    return Point3D(static_cast<float>(anchor.x + step[0]), static_cast<float>(anchor.y + step[1]),
+                   static_cast<float>(anchor.z + step[2]));
+}
+
+// ============================================================
+// Edge Collapse
+// ============================================================
+
+namespace {
+
+constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+/// Binary min-heap of vertices keyed by their candidate cost. Each
+/// vertex's slot is tracked, so its key can change or be removed in place;
+/// keys are stored next to the ids to keep sifting within the heap array
+class CandidateHeap {
+public:
+    explicit CandidateHeap(size_t vertexCount) : _slot(vertexCount, kNone) {}
+
+    bool empty() const { return _heap.empty(); }
+    uint32_t top() const { return _heap[0].vertex; }
+
+    /// Heap of every vertex with a finite key
+    void build(const double* keys) {
+        _heap.clear();
+        for (uint32_t v = 0; v < _slot.size(); ++v) {
+            if (keys[v] < std::numeric_limits<double>::infinity()) {
+                _slot[v] = static_cast<uint32_t>(_heap.size());
+                _heap.push_back(Entry{keys[v], v});
+            }
+        }
+        for (size_t i = _heap.size() / 2; i-- > 0;) {
+            siftDown(i);
+        }
+    }
+
+    /// Insert `v`, or move it after its key changed
+    void update(uint32_t v, double key) {
+        size_t i = _slot[v];
+        if (i == kNone) {
+            i = _heap.size();
+            _heap.push_back(Entry{key, v});
+            siftUp(i);
+        } else if (key < _heap[i].key) {
+            _heap[i].key = key;
+            siftUp(i);
+        } else {
+            _heap[i].key = key;
+            siftDown(i);
+        }
+    }
+
+    void remove(uint32_t v) {
+        const uint32_t i = _slot[v];
+        if (i == kNone) {
+            return;
+        }
+        _slot[v] = kNone;
+        const Entry last = _heap.back();
+        _heap.resize(_heap.size() - 1);
+        if (i < _heap.size()) {
+            place(i, last);
+            siftUp(i);
+            siftDown(_slot[last.vertex]);
+        }
+    }
+
+private:
+    struct Entry {
+        double key;
+        uint32_t vertex;
+    };
+
+    void siftUp(size_t i) {
+        const Entry entry = _heap[i];
+        while (i > 0) {
+            const size_t parent = (i - 1) / 2;
+            if (!(entry.key < _heap[parent].key)) {
+                break;
+            }
+            place(i, _heap[parent]);
+            i = parent;
+        }
+        place(i, entry);
+    }
+
+    void siftDown(size_t i) {
+        const Entry entry = _heap[i];
+        const size_t count = _heap.size();
+        while (true) {
+            size_t child = 2 * i + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && _heap[child + 1].key < _heap[child].key) {
+                ++child;
+            }
+            if (!(_heap[child].key < entry.key)) {
+                break;
+            }
+            place(i, _heap[child]);
+            i = child;
+        }
+        place(i, entry);
+    }
+
+    void place(size_t i, const Entry& entry) {
+        _heap[i] = entry;
+        _slot[entry.vertex] = static_cast<uint32_t>(i);
+    }
+
+    MallocBuffer<uint32_t> _slot;
+    MallocBuffer<Entry> _heap;
+};
+
+/// Mutable triangle mesh with per-vertex face rings and collapse candidates
+/// Faces are killed by clearing their first corner; rings may still list
+/// dead faces until the ring is rewritten or the pool is compacted. A
+/// collapse reads and writes only the closed one-rings of its two vertices,
+/// which is what lets the batched mode run non-overlapping ones in parallel
+class EdgeCollapser {
+public:
+    EdgeCollapser(const float* vertices, size_t vertexCount,
+                  const uint32_t* indices, size_t triangleCount, float boundaryWeight)
+        : _positions(vertexCount), _quadrics(vertexCount), _boundary(vertexCount, 0),
+          _faceCount(vertexCount, 0), _ringStart(vertexCount, 0), _ringSize(vertexCount, 0),
+          _target(vertexCount, kNone), _cost(vertexCount, std::numeric_limits<double>::infinity()),
+          _optimum(vertexCount), _stamp(vertexCount, 0), _heap(vertexCount) {
+        for (size_t v = 0; v < vertexCount; ++v) {
+            _positions[v] = Point3D(vertices[v * 3], vertices[v * 3 + 1], vertices[v * 3 + 2]);
+        }
+
+        // Faces, without degenerate ones
+        _faces.reserve(triangleCount * 3);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const uint32_t* tri = indices + t * 3;
+            if (tri[0] >= vertexCount || tri[1] >= vertexCount || tri[2] >= vertexCount) {
+                throw std::out_of_range("Triangle index out of range");
+            }
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0]) {
+                continue;
+            }
+            _faces.append(tri, tri + 3);
+            ++_faceCount[tri[0]];
+            ++_faceCount[tri[1]];
+            ++_faceCount[tri[2]];
+        }
+        _liveTriangles = _faces.size() / 3;
+
+        // Rings, laid out like a CSR to begin with
+        uint32_t offset = 0;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            _ringStart[v] = offset;
+            offset += _faceCount[v];
+            _liveVertices += _faceCount[v] > 0 ? 1 : 0;
+        }
+        _ring.resize(offset);
+        for (uint32_t f = 0; f < _liveTriangles; ++f) {
+            for (int c = 0; c < 3; ++c) {
+                const uint32_t v = _faces[f * 3 + c];
+                _ring[_ringStart[v] + _ringSize[v]++] = f;
+            }
+        }
+        _poolLimit = 2 * std::max<size_t>(_ring.size(), 1024);
+
+        // Area-weighted face planes
+        for (uint32_t f = 0; f < _liveTriangles; ++f) {
+            const Point3D p0 = _positions[_faces[f * 3]];
+            const Point3D n = (_positions[_faces[f * 3 + 1]] - p0).cross(_positions[_faces[f * 3 + 2]] - p0);
+            const float length = n.length();
+            if (!(length > 0.0f)) {
+                continue;
+            }
+            const Point3D unit = n / length;
+            const Quadric plane(unit.x, unit.y, unit.z, -unit.dot(p0), 0.5 * length);
+            for (int c = 0; c < 3; ++c) {
+                _quadrics[_faces[f * 3 + c]] += plane;
+            }
+        }
+
+        addBoundaryPlanes(boundaryWeight);
+
+        parallelFor(vertexCount, [&](size_t v) {
+            computeCandidate(static_cast<uint32_t>(v), nullptr);
+        }, 1024);
+    }
+
+    /// One collapse at a time, always the cheapest
+    void runGreedy(const SimplifyParams& params, SimplifyStats& stats) {
+        _heap.build(_cost.data());
+        while (!_heap.empty() && !targetsReached(params)) {
+            const uint32_t v = _heap.top();
+            const uint32_t w = _target[v];
+            const Point3D p = _optimum[v];
+            // Candidates are not revalidated when the neighborhood changes;
+            // a stale or blocked one is replaced by the best valid edge here
+            if (!canCollapse(v, w, p, _scratch)) {
+                ++stats.rejected;
+                computeCandidate(v, &_scratch);
+                updateHeap(v);
+                continue;
+            }
+
+            stats.maxError = std::max(stats.maxError, _cost[v]);
+            ++stats.collapses;
+            // Keep the vertex with the larger ring, so less of it is copied
+            if (_ringSize[v] >= _ringSize[w]) {
+                collapse(v, w, p);
+            } else {
+                collapse(w, v, p);
+            }
+        }
+    }
+
+    /// Rounds of independent collapses. Each round offers the candidates up
+    /// to a sampled cost threshold. A candidate claims every vertex its
+    /// collapse touches with an atomic minimum of its key (cost, then a
+    /// hash of the vertex so ties do not cascade along index order); those
+    /// holding all their claims are accepted and fence their vertices off,
+    /// and the rest try again for a few passes. The accepted set has
+    /// pairwise disjoint regions and is collapsed in parallel
+    void runBatched(const SimplifyParams& params, SimplifyStats& stats) {
+        const size_t vertexCount = _positions.size();
+        const size_t grain = 4096;
+        const size_t chunks = (vertexCount + grain - 1) / grain;
+        const int claimPasses = 4;
+        const uint64_t unclaimed = ~uint64_t(0);
+        const uint64_t taken = 0;
+
+        // Vertices to rescore before the next round: 1, or 2 to keep only
+        // collapses that pass canCollapse
+        MallocBuffer<uint8_t> refresh(vertexCount, 0);
+        std::vector<std::atomic<uint64_t>> claim(vertexCount);
+        parallelFor(vertexCount, [&](size_t v) {
+            claim[v].store(unclaimed, std::memory_order_relaxed);
+        }, grain);
+
+        auto keyOf = [&](uint32_t v) {
+            // Costs are non-negative, so their float bits sort like the
+            // values; the multiplicative hash is a bijection, keeping keys
+            // unique, and the offset keeps them clear of `taken`
+            const float cost = static_cast<float>(_cost[v]);
+            uint32_t bits;
+            std::memcpy(&bits, &cost, sizeof(bits));
+            return ((static_cast<uint64_t>(bits) << 32) | (v * 2654435761u)) + 1;
+        };
+
+        // Per-chunk outputs of the parallel passes, emptied again by gather
+        // (a single worker gets the whole range as one chunk)
+        std::vector<std::vector<uint32_t>> picked(chunks);
+        std::vector<std::vector<uint32_t>> waiting(chunks);
+        MallocBuffer<size_t> blocked(chunks, 0);
+        auto gather = [&](std::vector<std::vector<uint32_t>>& lists, std::vector<uint32_t>& out) {
+            out.clear();
+            for (std::vector<uint32_t>& list : lists) {
+                out.insert(out.end(), list.begin(), list.end());
+                list.clear();
+            }
+        };
+
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> accepted;
+        std::vector<uint32_t> batch;
+        std::vector<double> sample;
+        // Candidates offered per collapse wanted; grows while the cheap
+        // ones crowd together (e.g. along a flat strip) and block each other
+        double admit = 1.0;
+
+        auto rescore = [&]() {
+            parallelForChunks(vertexCount, [&](size_t begin, size_t end) {
+                std::vector<uint32_t> scratch;
+                for (size_t v = begin; v < end; ++v) {
+                    if (refresh[v]) {
+                        computeCandidate(static_cast<uint32_t>(v), refresh[v] == 2 ? &scratch : nullptr);
+                        refresh[v] = 0;
+                    }
+                }
+            }, grain);
+        };
+
+        while (!targetsReached(params)) {
+            rescore();
+
+            // Collapses wanted this round, and the cost that admits about
+            // that many candidates, estimated from a strided sample
+            size_t budget = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(_liveVertices) * params.batchFraction));
+            if (params.targetTriangles > 0) {
+                budget = std::min(budget, (_liveTriangles - params.targetTriangles + 1) / 2);
+            }
+            if (params.targetVertices > 0) {
+                budget = std::min(budget, _liveVertices - params.targetVertices);
+            }
+            sample.clear();
+            for (size_t step = std::max<size_t>(1, vertexCount / 65536);; step = 1) {
+                for (size_t v = 0; v < vertexCount; v += step) {
+                    if (_target[v] != kNone) {
+                        sample.push_back(_cost[v]);
+                    }
+                }
+                if (sample.size() >= 1024 || step == 1) {
+                    break;
+                }
+                sample.clear();
+            }
+            if (sample.empty()) {
+                break;
+            }
+            const size_t rank = std::min(sample.size() - 1, static_cast<size_t>(
+                static_cast<double>(sample.size()) * admit * static_cast<double>(budget) / static_cast<double>(_liveVertices)));
+            std::nth_element(sample.begin(), sample.begin() + rank, sample.end());
+            const double threshold = sample[rank];
+
+            parallelForChunks(vertexCount, [&](size_t begin, size_t end) {
+                std::vector<uint32_t>& out = picked[begin / grain];
+                for (size_t v = begin; v < end; ++v) {
+                    // An edge offered from both ends goes in once
+                    const uint32_t w = _target[v];
+                    if (w != kNone && _cost[v] <= threshold &&
+                        !(_target[w] == v && _cost[w] <= threshold && keyOf(w) < keyOf(static_cast<uint32_t>(v)))) {
+                        out.push_back(static_cast<uint32_t>(v));
+                    }
+                }
+            }, grain);
+            gather(picked, candidates);
+
+            batch.clear();
+            size_t rejected = 0;
+            for (int pass = 0; pass < claimPasses && !candidates.empty(); ++pass) {
+                parallelFor(candidates.size(), [&](size_t i) {
+                    const uint32_t v = candidates[i];
+                    const uint64_t key = keyOf(v);
+                    forEachRegionVertex(v, _target[v], [&](uint32_t x) {
+                        uint64_t current = claim[x].load(std::memory_order_relaxed);
+                        while (key < current && !claim[x].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                        }
+                    });
+                }, 256);
+
+                parallelForChunks(candidates.size(), [&](size_t begin, size_t end) {
+                    std::vector<uint32_t> scratch;
+                    std::vector<uint32_t>& won = picked[begin / grain];
+                    std::vector<uint32_t>& lost = waiting[begin / grain];
+                    for (size_t i = begin; i < end; ++i) {
+                        const uint32_t v = candidates[i];
+                        const uint64_t key = keyOf(v);
+                        bool owned = true;
+                        forEachRegionVertex(v, _target[v], [&](uint32_t x) {
+                            owned = owned && claim[x].load(std::memory_order_relaxed) == key;
+                        });
+                        if (!owned) {
+                            lost.push_back(v);
+                        } else if (canCollapse(v, _target[v], _optimum[v], scratch)) {
+                            won.push_back(v);
+                        } else {
+                            refresh[v] = 2;
+                            ++blocked[begin / grain];
+                        }
+                    }
+                }, grain);
+                for (size_t c = 0; c < chunks; ++c) {
+                    rejected += blocked[c];
+                    blocked[c] = 0;
+                }
+                gather(picked, accepted);
+                gather(waiting, candidates);
+
+                // Fence off the accepted regions, release everything else and
+                // keep only the candidates that stay clear of the fences
+                parallelFor(accepted.size(), [&](size_t i) {
+                    forEachRegionVertex(accepted[i], _target[accepted[i]], [&](uint32_t x) {
+                        claim[x].store(taken, std::memory_order_relaxed);
+                    });
+                }, 256);
+                parallelForChunks(candidates.size(), [&](size_t begin, size_t end) {
+                    std::vector<uint32_t>& out = waiting[begin / grain];
+                    for (size_t i = begin; i < end; ++i) {
+                        const uint32_t v = candidates[i];
+                        bool clear = true;
+                        forEachRegionVertex(v, _target[v], [&](uint32_t x) {
+                            if (claim[x].load(std::memory_order_relaxed) == taken) {
+                                clear = false;
+                            } else {
+                                claim[x].store(unclaimed, std::memory_order_relaxed);
+                            }
+                        });
+                        if (clear) {
+                            out.push_back(v);
+                        }
+                    }
+                }, grain);
+                gather(waiting, candidates);
+                batch.insert(batch.end(), accepted.begin(), accepted.end());
+            }
+            parallelFor(batch.size(), [&](size_t i) {
+                forEachRegionVertex(batch[i], _target[batch[i]], [&](uint32_t x) {
+                    claim[x].store(unclaimed, std::memory_order_relaxed);
+                });
+            }, 256);
+
+            stats.rejected += rejected;
+            if (batch.size() * 2 < budget) {
+                admit = std::min(admit * 2.0, 4.0);
+            } else if (batch.size() > budget) {
+                admit = std::max(admit * 0.5, 1.0);
+            }
+            if (batch.empty()) {
+                if (rejected == 0) {
+                    break;
+                }
+                continue;
+            }
+            trimBatch(batch, params);
+            for (uint32_t v : batch) {
+                stats.maxError = std::max(stats.maxError, _cost[v]);
+            }
+
+            // Each merged ring gets its own stretch of the pool up front
+            MallocBuffer<uint32_t> offsets(batch.size() + 1, 0);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                offsets[i + 1] = offsets[i] + _ringSize[batch[i]] + _ringSize[_target[batch[i]]];
+            }
+            const uint32_t start = static_cast<uint32_t>(_ring.size());
+            resizeRing(_ring.size() + offsets[batch.size()]);
+
+            MallocBuffer<uint32_t> killed(batch.size(), 0);
+            MallocBuffer<uint32_t> retired(batch.size(), 0);
+            parallelFor(batch.size(), [&](size_t i) {
+                const uint32_t v = batch[i];
+                const uint32_t w = _target[v];
+                const uint32_t keep = _ringSize[v] >= _ringSize[w] ? v : w;
+                const uint32_t gone = keep == v ? w : v;
+                uint32_t orphans = 1;
+                killed[i] = merge(keep, gone, _optimum[v], start + offsets[i], [&](uint32_t c) {
+                    ++orphans;
+                    clearCandidate(c);
+                });
+                clearCandidate(gone);
+                if (_faceCount[keep] == 0) {
+                    ++orphans;
+                    clearCandidate(keep);
+                } else {
+                    refresh[keep] = 1;
+                    forEachFace(keep, [&](uint32_t f) {
+                        refresh[_faces[f * 3]] = 1;
+                        refresh[_faces[f * 3 + 1]] = 1;
+                        refresh[_faces[f * 3 + 2]] = 1;
+                    });
+                }
+                retired[i] = orphans;
+            }, 64);
+
+            for (size_t i = 0; i < batch.size(); ++i) {
+                _liveTriangles -= killed[i];
+                _liveVertices -= retired[i];
+            }
+            stats.collapses += batch.size();
+            ++stats.rounds;
+
+            if (_ring.size() > _poolLimit) {
+                compactRings();
+            }
+        }
+        // Leave every candidate current, so a later run can pick up from here
+        rescore();
+    }
+
+    MeshData output() const {
+        MeshData result;
+        MallocBuffer<uint32_t> remap(_positions.size(), kNone);
+        result.vertices.reserve(_liveVertices * 3);
+        uint32_t next = 0;
+        for (size_t v = 0; v < _positions.size(); ++v) {
+            if (_faceCount[v] > 0) {
+                remap[v] = next++;
+                result.addVertex(_positions[v]);
+            }
+        }
+        result.indices.reserve(_liveTriangles * 3);
+        for (size_t f = 0; f < _faces.size() / 3; ++f) {
+            if (_faces[f * 3] != kNone) {
+                result.addTriangle(remap[_faces[f * 3]], remap[_faces[f * 3 + 1]], remap[_faces[f * 3 + 2]]);
+            }
+        }
+        return result;
+    }
+
+    size_t liveTriangles() const { return _liveTriangles; }
+
+    /// Append the live mesh to `chain` as a level. slot[v] is v's entry in
+    /// the shared vertex buffer (kNone if it has none); vertices whose
+    /// position no longer matches their entry get a new one
+    void appendLevel(LodChain& chain, MallocBuffer<uint32_t>& slot, double maxError) const {
+        LodChain::Level level;
+        level.indexOffset = chain.indices.size();
+        level.vertexCount = _liveVertices;
+        level.maxError = maxError;
+        for (uint32_t v = 0; v < _positions.size(); ++v) {
+            if (_faceCount[v] == 0) {
+                continue;
+            }
+            const Point3D& p = _positions[v];
+            const float* entry = slot[v] != kNone ? chain.vertices.data() + static_cast<size_t>(slot[v]) * 3 : nullptr;
+            if (!entry || entry[0] != p.x || entry[1] != p.y || entry[2] != p.z) {
+                if (chain.vertices.size() / 3 >= kNone) {
+                    throw std::length_error("LOD chain too large for 32-bit indices");
+                }
+                slot[v] = static_cast<uint32_t>(chain.vertices.size() / 3);
+                chain.vertices.push_back(p.x);
+                chain.vertices.push_back(p.y);
+                chain.vertices.push_back(p.z);
+            }
+        }
+        for (size_t f = 0; f < _faces.size() / 3; ++f) {
+            if (_faces[f * 3] != kNone) {
+                chain.indices.push_back(slot[_faces[f * 3]]);
+                chain.indices.push_back(slot[_faces[f * 3 + 1]]);
+                chain.indices.push_back(slot[_faces[f * 3 + 2]]);
+            }
+        }
+        level.indexCount = chain.indices.size() - level.indexOffset;
+        chain.levels.push_back(level);
+    }
+
+private:
+    bool targetsReached(const SimplifyParams& params) const {
+        return (params.targetTriangles > 0 && _liveTriangles <= params.targetTriangles) ||
+               (params.targetVertices > 0 && _liveVertices <= params.targetVertices);
+    }
+
+    bool hasCorner(uint32_t f, uint32_t v) const {
+        return _faces[f * 3] == v || _faces[f * 3 + 1] == v || _faces[f * 3 + 2] == v;
+    }
+
+    /// fn(f) for every live face around `v`
+    template<typename Fn>
+    void forEachFace(uint32_t v, Fn&& fn) const {
+        for (uint32_t i = _ringStart[v], end = _ringStart[v] + _ringSize[v]; i < end; ++i) {
+            const uint32_t f = _ring[i];
+            if (_faces[f * 3] != kNone) {
+                fn(f);
+            }
+        }
+    }
+
+    /// fn(x) for every corner of the live faces around `a` and `b`, i.e.
+    /// everything a collapse of edge ab reads or writes (with repeats)
+    template<typename Fn>
+    void forEachRegionVertex(uint32_t a, uint32_t b, Fn&& fn) const {
+        for (uint32_t v : {a, b}) {
+            forEachFace(v, [&](uint32_t f) {
+                fn(_faces[f * 3]);
+                fn(_faces[f * 3 + 1]);
+                fn(_faces[f * 3 + 2]);
+            });
+        }
+    }
+
+    /// Resize the ring pool, growing its capacity geometrically
+    void resizeRing(size_t size) {
+        if (size > _ring.capacity()) {
+            _ring.reserve(std::max(size, _ring.capacity() * 2));
+        }
+        _ring.resize(size);
+    }
+
+    uint32_t nextStamp() {
+        if (_stampValue >= kNone - 2) {
+            std::fill(_stamp.begin(), _stamp.end(), 0u);
+            _stampValue = 0;
+        }
+        _stampValue += 2;
+        return _stampValue;
+    }
+
+    /// Planes through each open edge, perpendicular to its face, so that
+    /// moving along the boundary is cheap and moving off it is not
+    void addBoundaryPlanes(float weight) {
+        for (uint32_t v = 0; v < _positions.size(); ++v) {
+            forEachFace(v, [&](uint32_t f) {
+                for (int c = 0; c < 3; ++c) {
+                    const uint32_t w = _faces[f * 3 + c];
+                    if (w <= v) {
+                        continue;
+                    }
+                    size_t shared = 0;
+                    forEachFace(v, [&](uint32_t g) { shared += hasCorner(g, w) ? 1 : 0; });
+                    if (shared != 1) {
+                        continue;
+                    }
+
+                    _boundary[v] = 1;
+                    _boundary[w] = 1;
+                    const Point3D p0 = _positions[_faces[f * 3]];
+                    const Point3D normal = (_positions[_faces[f * 3 + 1]] - p0).cross(_positions[_faces[f * 3 + 2]] - p0);
+                    const Point3D edge = _positions[w] - _positions[v];
+                    const Point3D side = edge.cross(normal);
+                    const float length = side.length();
+                    if (weight > 0.0f && length > 0.0f) {
+                        const Point3D unit = side / length;
+                        const Quadric plane(unit.x, unit.y, unit.z, -unit.dot(_positions[v]),
+                                            static_cast<double>(weight) * edge.dot(edge));
+                        _quadrics[v] += plane;
+                        _quadrics[w] += plane;
+                    }
+                }
+            });
+        }
+    }
+
+    /// Error of merging `a` and `b`, and the position it is reached at
+    double collapseCost(uint32_t a, uint32_t b, Point3D& p) const {
+        Quadric q = _quadrics[a];
+        q += _quadrics[b];
+        const Point3D pa = _positions[a];
+        const Point3D pb = _positions[b];
+        const Point3D mid = (pa + pb) * 0.5f;
+        // Nearly singular systems can solve to far-away points; those fall
+        // back to the better of the endpoints and the midpoint
+        if (q.optimum(p) && (p - mid).length() <= 2.0f * (pb - pa).length()) {
+            return std::max(q.evaluate(p), 0.0);
+        }
+        const double ea = q.evaluate(pa);
+        const double eb = q.evaluate(pb);
+        const double em = q.evaluate(mid);
+        if (ea <= eb && ea <= em) {
+            p = pa;
+            return std::max(ea, 0.0);
+        }
+        p = eb <= em ? pb : mid;
+        return std::max(std::min(eb, em), 0.0);
+    }
+
+    /// Cheapest collapse of `v` along the edges to the next corner of each
+    /// face around it. Every edge is the next-corner edge of one of its
+    /// endpoints, so together the candidates still cover all edges. Given
+    /// `validate` scratch, only collapses that pass canCollapse qualify.
+    /// Writes only v's own candidate slots
+    void computeCandidate(uint32_t v, std::vector<uint32_t>* validate) {
+        uint32_t best = kNone;
+        double bestCost = std::numeric_limits<double>::infinity();
+        Point3D bestPosition;
+        forEachFace(v, [&](uint32_t f) {
+            const uint32_t* tri = _faces.data() + f * 3;
+            const uint32_t w = tri[0] == v ? tri[1] : tri[1] == v ? tri[2] : tri[0];
+            Point3D p;
+            const double cost = collapseCost(v, w, p);
+            if (cost < bestCost && (!validate || canCollapse(v, w, p, *validate))) {
+                best = w;
+                bestCost = cost;
+                bestPosition = p;
+            }
+        });
+        _target[v] = best;
+        _cost[v] = bestCost;
+        _optimum[v] = bestPosition;
+    }
+
+    void updateHeap(uint32_t v) {
+        if (_target[v] == kNone) {
+            _heap.remove(v);
+        } else {
+            _heap.update(v, _cost[v]);
+        }
+    }
+
+    /// Link condition, no pinching of two boundaries, and no face of
+    /// either ring turned over by moving its vertex to `p`. Thread safe;
+    /// `scratch` only saves allocations
+    bool canCollapse(uint32_t a, uint32_t b, const Point3D& p, std::vector<uint32_t>& scratch) const {
+        scratch.clear();
+        size_t shared = 0;
+        forEachFace(a, [&](uint32_t f) {
+            for (int c = 0; c < 3; ++c) {
+                const uint32_t w = _faces[f * 3 + c];
+                if (w != a && w != b) {
+                    scratch.push_back(w);
+                }
+            }
+            shared += hasCorner(f, b) ? 1 : 0;
+        });
+        if (shared == 0 || (shared > 1 && _boundary[a] && _boundary[b])) {
+            return false;
+        }
+
+        // Vertices adjacent to both must be exactly the shared faces' apexes
+        std::sort(scratch.begin(), scratch.end());
+        const size_t ringA = static_cast<size_t>(std::unique(scratch.begin(), scratch.end()) - scratch.begin());
+        scratch.resize(ringA);
+        forEachFace(b, [&](uint32_t f) {
+            for (int c = 0; c < 3; ++c) {
+                const uint32_t w = _faces[f * 3 + c];
+                if (w != a && w != b && std::binary_search(scratch.begin(), scratch.begin() + ringA, w)) {
+                    scratch.push_back(w);
+                }
+            }
+        });
+        std::sort(scratch.begin() + ringA, scratch.end());
+        const size_t common = static_cast<size_t>(std::unique(scratch.begin() + ringA, scratch.end()) - (scratch.begin() + ringA));
+        if (common != shared) {
+            return false;
+        }
+
+        return !flipsFace(a, b, p) && !flipsFace(b, a, p);
+    }
+
+    bool flipsFace(uint32_t v, uint32_t other, const Point3D& p) const {
+        bool flips = false;
+        forEachFace(v, [&](uint32_t f) {
+            if (flips || hasCorner(f, other)) {
+                return;
+            }
+            Point3D corner[3] = {_positions[_faces[f * 3]], _positions[_faces[f * 3 + 1]], _positions[_faces[f * 3 + 2]]};
+            const Point3D before = (corner[1] - corner[0]).cross(corner[2] - corner[0]);
+            const float area = before.length();
+            if (!(area > 0.0f)) {
+                return;
+            }
+            for (int c = 0; c < 3; ++c) {
+                if (_faces[f * 3 + c] == v) {
+                    corner[c] = p;
+                }
+            }
+            const Point3D after = (corner[1] - corner[0]).cross(corner[2] - corner[0]);
+            // Turning by more than ~80 degrees (or collapsing) counts as a flip
+            flips = !(after.dot(before) > 0.2f * area * after.length());
+        });
+        return flips;
+    }
+
+    void clearCandidate(uint32_t v) {
+        _target[v] = kNone;
+        _cost[v] = std::numeric_limits<double>::infinity();
+    }
+
+    void retire(uint32_t v) {
+        --_liveVertices;
+        _heap.remove(v);
+        clearCandidate(v);
+    }
+
+    /// Merge `gone` into `keep` at `p`: faces on the edge die, the others
+    /// are re-pointed, and the merged ring is written to _ring[start ..),
+    /// which must hold both rings. onOrphan(c) is called for apexes left
+    /// without faces. Leaves candidates and live counts to the caller;
+    /// returns the number of faces killed
+    template<typename OnOrphan>
+    uint32_t merge(uint32_t keep, uint32_t gone, const Point3D& p, uint32_t start, OnOrphan&& onOrphan) {
+        uint32_t size = 0;
+        for (uint32_t i = _ringStart[keep], end = _ringStart[keep] + _ringSize[keep]; i < end; ++i) {
+            const uint32_t f = _ring[i];
+            if (_faces[f * 3] != kNone && !hasCorner(f, gone)) {
+                _ring[start + size++] = f;
+            }
+        }
+        uint32_t killed = 0;
+        for (uint32_t i = _ringStart[gone], end = _ringStart[gone] + _ringSize[gone]; i < end; ++i) {
+            const uint32_t f = _ring[i];
+            uint32_t* tri = _faces.data() + f * 3;
+            if (tri[0] == kNone) {
+                continue;
+            }
+            if (hasCorner(f, keep)) {
+                for (int c = 0; c < 3; ++c) {
+                    if (tri[c] != keep && tri[c] != gone && --_faceCount[tri[c]] == 0) {
+                        onOrphan(tri[c]);
+                    }
+                }
+                tri[0] = kNone;
+                ++killed;
+                continue;
+            }
+            for (int c = 0; c < 3; ++c) {
+                tri[c] = tri[c] == gone ? keep : tri[c];
+            }
+            _ring[start + size++] = f;
+        }
+
+        _ringStart[keep] = start;
+        _ringSize[keep] = size;
+        _ringSize[gone] = 0;
+        _faceCount[keep] = _faceCount[keep] + _faceCount[gone] - 2 * killed;
+        _faceCount[gone] = 0;
+        _positions[keep] = p;
+        _quadrics[keep] += _quadrics[gone];
+        _boundary[keep] |= _boundary[gone];
+        return killed;
+    }
+
+    /// Merge `gone` into `keep` at `p` and refresh the candidates around it
+    void collapse(uint32_t keep, uint32_t gone, const Point3D& p) {
+        const uint32_t start = static_cast<uint32_t>(_ring.size());
+        resizeRing(_ring.size() + _ringSize[keep] + _ringSize[gone]);
+        _liveTriangles -= merge(keep, gone, p, start, [&](uint32_t c) { retire(c); });
+        _ring.resize(start + _ringSize[keep]);
+        retire(gone);
+        if (_faceCount[keep] == 0) {
+            retire(keep);
+            return;
+        }
+
+        // One pass over the distinct neighbors of `keep` rescores every edge
+        // that moved: each becomes a candidate of `keep`, and is compared
+        // against the neighbor's own best. Neighbors that were aiming at
+        // either vertex need a full rescan only if that edge got dearer
+        uint32_t best = kNone;
+        double bestCost = std::numeric_limits<double>::infinity();
+        Point3D bestPosition;
+        const uint32_t mark = nextStamp();
+        _stamp[keep] = mark;
+        forEachFace(keep, [&](uint32_t f) {
+            for (int c = 0; c < 3; ++c) {
+                const uint32_t w = _faces[f * 3 + c];
+                if (_stamp[w] == mark) {
+                    continue;
+                }
+                _stamp[w] = mark;
+                Point3D q;
+                const double cost = collapseCost(keep, w, q);
+                if (cost < bestCost) {
+                    best = w;
+                    bestCost = cost;
+                    bestPosition = q;
+                }
+                const bool aimed = _target[w] == keep || _target[w] == gone;
+                if (_target[w] == kNone || (aimed && cost > _cost[w])) {
+                    computeCandidate(w, nullptr);
+                    updateHeap(w);
+                } else if (aimed || cost < _cost[w]) {
+                    _target[w] = keep;
+                    _cost[w] = cost;
+                    _optimum[w] = q;
+                    updateHeap(w);
+                }
+            }
+        });
+        _target[keep] = best;
+        _cost[keep] = bestCost;
+        _optimum[keep] = bestPosition;
+        updateHeap(keep);
+
+        if (_ring.size() > _poolLimit) {
+            compactRings();
+        }
+    }
+
+    /// Cut a round's batch to its cheapest collapses if all of it would
+    /// overshoot a target; collapses remove one face per face on the edge
+    void trimBatch(std::vector<uint32_t>& batch, const SimplifyParams& params) const {
+        size_t faces = 0;
+        for (uint32_t v : batch) {
+            faces += edgeFaces(v, _target[v]);
+        }
+        const size_t faceLimit = params.targetTriangles > 0 ? _liveTriangles - params.targetTriangles : faces;
+        const size_t vertexLimit = params.targetVertices > 0 ? _liveVertices - params.targetVertices : batch.size();
+        if (faces <= faceLimit && batch.size() <= vertexLimit) {
+            return;
+        }
+
+        std::sort(batch.begin(), batch.end(), [&](uint32_t a, uint32_t b) { return _cost[a] < _cost[b]; });
+        size_t kept = 0;
+        faces = 0;
+        while (kept < batch.size() && kept < vertexLimit && faces < faceLimit) {
+            faces += edgeFaces(batch[kept], _target[batch[kept]]);
+            ++kept;
+        }
+        batch.resize(kept);
+    }
+
+    size_t edgeFaces(uint32_t a, uint32_t b) const {
+        size_t count = 0;
+        forEachFace(a, [&](uint32_t f) { count += hasCorner(f, b) ? 1 : 0; });
+        return count;
+    }
+
+    /// Rewrite all rings without dead faces into a fresh pool
+    void compactRings() {
+        MallocBuffer<uint32_t> pool;
+        pool.reserve(_liveTriangles * 3);
+        for (uint32_t v = 0; v < _positions.size(); ++v) {
+            const uint32_t start = static_cast<uint32_t>(pool.size());
+            forEachFace(v, [&](uint32_t f) { pool.push_back(f); });
+            _ringStart[v] = start;
+            _ringSize[v] = static_cast<uint32_t>(pool.size()) - start;
+        }
+        _ring = std::move(pool);
+        _poolLimit = 2 * std::max<size_t>(_ring.size(), 1024);
+    }
+
+    MallocBuffer<Point3D> _positions;
+    MallocBuffer<Quadric> _quadrics;
+    MallocBuffer<uint8_t> _boundary;
+    MallocBuffer<uint32_t> _faces;          // 3 corners per face; kNone in the first marks a dead face
+    MallocBuffer<uint32_t> _faceCount;      // Live faces per vertex
+
+    // Face rings: _ring[_ringStart[v] .. + _ringSize[v])
+    MallocBuffer<uint32_t> _ringStart;
+    MallocBuffer<uint32_t> _ringSize;
+    MallocBuffer<uint32_t> _ring;
+    size_t _poolLimit = 0;
+
+    // Best collapse per vertex
+    MallocBuffer<uint32_t> _target;
+    MallocBuffer<double> _cost;
+    MallocBuffer<Point3D> _optimum;
+
+    MallocBuffer<uint32_t> _stamp;
+    uint32_t _stampValue = 0;
+    std::vector<uint32_t> _scratch;
+
+    CandidateHeap _heap;
+    size_t _liveTriangles = 0;
+    size_t _liveVertices = 0;
+};
+
+} // namespace
+
+MeshData simplifyQuadric(const float* vertices, size_t vertexCount,
+                         const uint32_t* indices, size_t indexCount,
+                         const SimplifyParams& params,
+                         SimplifyStats* stats) {
+    const size_t triangleCount = indexCount / 3;
+    // Ring pools hold up to twice the corner count before compaction
+    if (triangleCount * 8 > 0xFFFFFFFFull || vertexCount >= kNone) {
+        throw std::length_error("Mesh too large for 32-bit simplification indices");
+    }
+
+    EdgeCollapser collapser(vertices, vertexCount, indices, triangleCount, params.boundaryWeight);
+    SimplifyStats local;
+    if (params.strategy == SimplifyParams::Strategy::Batched) {
+        collapser.runBatched(params, local);
+    } else {
+        collapser.runGreedy(params, local);
+    }
+    if (stats) {
+        *stats = local;
+    }
+    return collapser.output();
+}
+
+LodChain simplifyQuadricChain(const float* vertices, size_t vertexCount,
+                              const uint32_t* indices, size_t indexCount,
+                              const std::vector<float>& ratios,
+                              const SimplifyParams& params,
+                              SimplifyStats* stats) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount * 8 > 0xFFFFFFFFull || vertexCount >= kNone) {
+        throw std::length_error("Mesh too large for 32-bit simplification indices");
+    }
+    for (size_t i = 0; i < ratios.size(); ++i) {
+        if (!(ratios[i] > 0.0f && ratios[i] <= 1.0f) || (i > 0 && ratios[i] > ratios[i - 1])) {
+            throw std::invalid_argument("LOD ratios must be non-increasing and in (0, 1]");
+        }
+    }
+
+    EdgeCollapser collapser(vertices, vertexCount, indices, triangleCount, params.boundaryWeight);
+    SimplifyStats local;
+    LodChain chain;
+    MallocBuffer<uint32_t> slot(vertexCount, kNone);
+    const size_t inputTriangles = collapser.liveTriangles();
+    for (float ratio : ratios) {
+        SimplifyParams level = params;
+        level.targetTriangles = std::max<size_t>(static_cast<size_t>(std::llround(ratio * static_cast<double>(inputTriangles))), 1);
+        level.targetVertices = 0;
+        if (collapser.liveTriangles() > level.targetTriangles) {
+            if (params.strategy == SimplifyParams::Strategy::Batched) {
+                collapser.runBatched(level, local);
+            } else {
+                collapser.runGreedy(level, local);
+            }
+        }
+        collapser.appendLevel(chain, slot, local.maxError);
+    }
+    if (stats) {
+        *stats = local;
+    }
+    return chain;
+}
+
+} // namespace mesh
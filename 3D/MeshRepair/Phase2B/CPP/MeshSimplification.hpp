@@ -0,0 +1,111 @@
+//
+//  MeshSimplification.hpp
+//  3D
+//
+//  Quadric error metric edge-collapse simplification (Garland & Heckbert 1997)
+//  Every vertex keeps its cheapest collapse in an indexed binary heap whose
+//  keys are updated in place as neighborhoods change; faces around each
+//  vertex live in rings in a shared pool, so a collapse only touches the
+//  one-rings of its two vertices. The batched mode applies many collapses
+//  with disjoint one-rings per round, in parallel. A single collapse run
+//  can also be snapshotted into a chain of levels of detail
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+#include <vector>
+
+namespace mesh {
+
+/// Symmetric 4x4 error quadric, upper triangle stored row by row
+struct Quadric {
+    double q[10] = {};
+
+    Quadric() = default;
+
+    /// Squared distance to the plane a x + b y + c z + d = 0 (unit normal),
+    /// scaled by `weight`
+    Quadric(double a, double b, double c, double d, double weight);
+
+    Quadric& operator+=(const Quadric& other) {
+        for (int i = 0; i < 10; ++i) {
+            q[i] += other.q[i];
+        }
+        return *this;
+    }
+
+    double evaluate(const Point3D& p) const;
+
+    /// Position of least error; false if the 3x3 system is close to
+    /// singular (flat or creased neighborhoods), leaving `p` untouched
+    bool optimum(Point3D& p) const;
+
+    /// Least-error position closest to `anchor`: directions the quadric
+    /// barely constrains (eigenvalues below `tolerance` times the largest)
+    /// keep the anchor's coordinate, as in a truncated pseudo-inverse
+    Point3D optimumNear(const Point3D& anchor, double tolerance = 1e-3) const;
+};
+
+struct SimplifyParams {
+    enum class Strategy {
+        Greedy,                     // One collapse at a time, strictly cheapest first
+        Batched                     // Rounds of independent cheap collapses, applied in parallel
+    };
+
+    size_t targetTriangles = 0;     // Stop at or below this many triangles (0 = no limit)
+    size_t targetVertices = 0;      // Stop at or below this many referenced vertices (0 = no limit)
+    float boundaryWeight = 10.0f;   // Weight of the planes holding open boundaries in place (0 = free)
+    Strategy strategy = Strategy::Greedy;
+    float batchFraction = 0.02f;    // Batched: share of the live vertices offered per round
+};
+
+struct SimplifyStats {
+    size_t collapses = 0;
+    size_t rejected = 0;            // Candidates blocked by the link condition or a face flip
+    double maxError = 0.0;          // Largest quadric error of an applied collapse
+    size_t rounds = 0;              // Batched: rounds that applied collapses
+};
+
+/// Decimate an indexed triangle mesh by repeatedly collapsing the edge of
+/// least quadric error into its optimal position. Face quadrics are area
+/// weighted. Collapses that would make the surface non-manifold (link
+/// condition) or turn a face over are skipped. Stops when either target is
+/// reached or no valid collapse is left; with both targets 0 it runs until
+/// then. Batched trades strict cost order for parallelism: each round takes
+/// the cheapest collapses up to a sampled threshold that do not share a
+/// one-ring, and the last round is trimmed so targets are not overshot.
+/// Degenerate input triangles are dropped; unreferenced vertices are
+/// removed from the output, the remaining ones keep their relative order
+MeshData simplifyQuadric(const float* vertices, size_t vertexCount,
+                         const uint32_t* indices, size_t indexCount,
+                         const SimplifyParams& params,
+                         SimplifyStats* stats = nullptr);
+
+/// Levels of detail indexing one shared vertex buffer
+struct LodChain {
+    struct Level {
+        size_t indexOffset = 0;     // First index of the level in `indices`
+        size_t indexCount = 0;
+        size_t vertexCount = 0;     // Distinct vertices the level references
+        double maxError = 0.0;      // Largest quadric error of the collapses up to this level
+    };
+
+    MallocBuffer<float> vertices;   // xyz, finest level first
+    MallocBuffer<uint32_t> indices; // Triangles of every level, back to back
+    std::vector<Level> levels;
+};
+
+/// simplifyQuadric run once through a falling series of triangle counts,
+/// `ratios` of the input's non-degenerate triangles (non-increasing, each
+/// in (0, 1]; std::invalid_argument otherwise), with the mesh snapshotted
+/// at each. Vertices keep their buffer entry across levels until a
+/// collapse moves them, so a coarser level only appends the vertices it
+/// repositioned. The targets in `params` are ignored; `stats` totals the
+/// whole run
+LodChain simplifyQuadricChain(const float* vertices, size_t vertexCount,
+                              const uint32_t* indices, size_t indexCount,
+                              const std::vector<float>& ratios,
+                              const SimplifyParams& params,
+                              SimplifyStats* stats = nullptr);
+
+} // namespace mesh
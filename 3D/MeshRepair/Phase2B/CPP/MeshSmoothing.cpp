@@ -0,0 +1,207 @@
+//
+//  MeshSmoothing.cpp
+//  3D
+//
+//  Edge weights, feature detection and Taubin passes
+//
+
+#include "MeshSmoothing.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace mesh {
+
+// ============================================================
+// Smoothing
+// ============================================================
+
+namespace {
+
+inline Point3D readPoint(const float* points, size_t stride, size_t i) {
+    const float* p = reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(points) + i * stride);
+    return Point3D(p[0], p[1], p[2]);
+}
+
+/// Normalized per-entry weights; empty rows (isolated vertices) stay empty
+MallocBuffer<float> edgeWeights(const CSRAdjacency& adjacency, const float* vertices, size_t stride,
+                                const uint32_t* indices, size_t triangleCount,
+                                SmoothingParams::Weighting weighting) {
+    const size_t vertexCount = adjacency.nodeCount();
+    MallocBuffer<float> weights(adjacency.items.size(), 1.0f);
+
+    if (weighting == SmoothingParams::Weighting::Cotangent) {
+        std::fill(weights.begin(), weights.end(), 0.0f);
+        // Each corner's cotangent goes to the opposite edge, in both rows
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const uint32_t* tri = indices + t * 3;
+            for (int c = 0; c < 3; ++c) {
+                const uint32_t i = tri[c];
+                const uint32_t j = tri[(c + 1) % 3];
+                const uint32_t k = tri[(c + 2) % 3];
+                if (i == j || j == k || k == i) break;
+                const Point3D e1 = readPoint(vertices, stride, j) - readPoint(vertices, stride, i);
+                const Point3D e2 = readPoint(vertices, stride, k) - readPoint(vertices, stride, i);
+                const float sine = e1.cross(e2).length();
+                if (!(sine > 1e-12f)) continue;
+                const float halfCot = 0.5f * e1.dot(e2) / sine;
+                weights[adjacency.find(j, k)] += halfCot;
+                weights[adjacency.find(k, j)] += halfCot;
+            }
+        }
+    }
+
+    parallelFor(vertexCount, [&](size_t v) {
+        const uint32_t begin = adjacency.offsets[v];
+        const uint32_t end = adjacency.offsets[v + 1];
+        // Obtuse triangles give negative cotangents; clamping keeps every
+        // update a convex combination
+        float total = 0.0f;
+        for (uint32_t e = begin; e < end; ++e) {
+            weights[e] = std::max(weights[e], 0.0f);
+            total += weights[e];
+        }
+        if (total > 0.0f) {
+            for (uint32_t e = begin; e < end; ++e) {
+                weights[e] /= total;
+            }
+        } else {
+            for (uint32_t e = begin; e < end; ++e) {
+                weights[e] = 1.0f / static_cast<float>(end - begin);
+            }
+        }
+    }, 1024);
+    return weights;
+}
+
+/// Mark vertices on sharp or open edges as pinned
+void pinEdges(const CSRAdjacency& adjacency, const float* vertices, size_t stride,
+              const uint32_t* indices, size_t triangleCount,
+              const SmoothingParams& params, MallocBuffer<uint8_t>& pinned) {
+    // Per undirected edge (stored at the lower vertex's entry): face count
+    // and the first face's normal
+    MallocBuffer<uint32_t> faces(adjacency.items.size(), 0);
+    MallocBuffer<float> firstNormal(adjacency.items.size() * 3, 0.0f);
+    const float cosLimit = std::cos(params.featureAngle * static_cast<float>(M_PI) / 180.0f);
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = indices + t * 3;
+        const Point3D p0 = readPoint(vertices, stride, tri[0]);
+        const Point3D normal = (readPoint(vertices, stride, tri[1]) - p0).cross(readPoint(vertices, stride, tri[2]) - p0).normalized();
+        for (int c = 0; c < 3; ++c) {
+            const uint32_t a = std::min(tri[c], tri[(c + 1) % 3]);
+            const uint32_t b = std::max(tri[c], tri[(c + 1) % 3]);
+            if (a == b) continue;
+            const uint32_t e = adjacency.find(a, b);
+            if (faces[e]++ == 0) {
+                firstNormal[e * 3] = normal.x;
+                firstNormal[e * 3 + 1] = normal.y;
+                firstNormal[e * 3 + 2] = normal.z;
+            } else if (params.featureAngle > 0.0f &&
+                       normal.dot(Point3D(firstNormal[e * 3], firstNormal[e * 3 + 1], firstNormal[e * 3 + 2])) < cosLimit) {
+                pinned[a] = 1;
+                pinned[b] = 1;
+            }
+        }
+    }
+
+    if (params.pinBoundaries) {
+        for (size_t a = 0; a < adjacency.nodeCount(); ++a) {
+            for (uint32_t e = adjacency.offsets[a]; e < adjacency.offsets[a + 1]; ++e) {
+                const uint32_t b = adjacency.items[e];
+                if (b > a && faces[e] == 1) {
+                    pinned[a] = 1;
+                    pinned[b] = 1;
+                }
+            }
+        }
+    }
+}
+
+/// dst = src + factor * (weighted neighbor average - src) for free vertices
+void smoothingPass(const CSRAdjacency& adjacency, const float* weights, const uint8_t* free,
+                   const float* const src[3], float* const dst[3], float factor) {
+    parallelForChunks(adjacency.nodeCount(), [&](size_t begin, size_t end) {
+        const uint32_t* offsets = adjacency.offsets.data();
+        const uint32_t* neighbors = adjacency.items.data();
+        const float* sx = src[0];
+        const float* sy = src[1];
+        const float* sz = src[2];
+        for (size_t v = begin; v < end; ++v) {
+            float ax = 0.0f, ay = 0.0f, az = 0.0f;
+            for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                const uint32_t n = neighbors[e];
+                ax += weights[e] * sx[n];
+                ay += weights[e] * sy[n];
+                az += weights[e] * sz[n];
+            }
+            // Branch-free blend: pinned and isolated vertices get step 0
+            const float step = free[v] ? factor : 0.0f;
+            dst[0][v] = sx[v] + step * (ax - sx[v]);
+            dst[1][v] = sy[v] + step * (ay - sy[v]);
+            dst[2][v] = sz[v] + step * (az - sz[v]);
+        }
+    }, 4096);
+}
+
+} // namespace
+
+size_t smoothTaubin(float* vertices, size_t vertexCount, size_t stride,
+                    const uint32_t* indices, size_t indexCount,
+                    const SmoothingParams& params,
+                    const uint8_t* movable) {
+    const size_t triangleCount = indexCount / 3;
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        if (indices[i] >= vertexCount) {
+            throw std::out_of_range("Triangle index out of range");
+        }
+    }
+
+    MeshAdjacency meshAdjacency;
+    meshAdjacency.build(indices, triangleCount, vertexCount);
+    const CSRAdjacency& adjacency = meshAdjacency.vertexNeighbors();
+    const MallocBuffer<float> weights = edgeWeights(adjacency, vertices, stride, indices, triangleCount, params.weighting);
+
+    MallocBuffer<uint8_t> pinned(vertexCount, 0);
+    if (params.featureAngle > 0.0f || params.pinBoundaries) {
+        pinEdges(adjacency, vertices, stride, indices, triangleCount, params, pinned);
+    }
+
+    size_t held = 0;
+    MallocBuffer<uint8_t> free(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        free[v] = (!movable || movable[v]) && !pinned[v] && adjacency.offsets[v + 1] > adjacency.offsets[v];
+        held += free[v] ? 0 : 1;
+    }
+
+    // Structure-of-arrays double buffer
+    MallocBuffer<float> buffer(vertexCount * 6);
+    float* front[3] = {buffer.data(), buffer.data() + vertexCount, buffer.data() + vertexCount * 2};
+    float* back[3] = {buffer.data() + vertexCount * 3, buffer.data() + vertexCount * 4, buffer.data() + vertexCount * 5};
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const Point3D p = readPoint(vertices, stride, v);
+        front[0][v] = p.x;
+        front[1][v] = p.y;
+        front[2][v] = p.z;
+    }
+
+    for (size_t iteration = 0; iteration < params.iterations; ++iteration) {
+        smoothingPass(adjacency, weights.data(), free.data(), front, back, params.lambda);
+        std::swap(front, back);
+        if (params.mu != 0.0f) {
+            smoothingPass(adjacency, weights.data(), free.data(), front, back, params.mu);
+            std::swap(front, back);
+        }
+    }
+
+    for (size_t v = 0; v < vertexCount; ++v) {
+        float* p = reinterpret_cast<float*>(reinterpret_cast<unsigned char*>(vertices) + v * stride);
+        p[0] = front[0][v];
+        p[1] = front[1][v];
+        p[2] = front[2][v];
+    }
+    return held;
+}
+
+} // namespace mesh
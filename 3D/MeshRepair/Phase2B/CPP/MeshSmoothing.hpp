@@ -0,0 +1,42 @@
+//
+//  MeshSmoothing.hpp
+//  3D
+//
+//  Laplacian / Taubin smoothing of triangle meshes
+//  Weights are stored per entry of the mesh's CSR one-ring adjacency;
+//  positions are split into x/y/z arrays and double buffered, so each
+//  pass is a parallel, allocation-free sweep
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+
+namespace mesh {
+
+struct SmoothingParams {
+    enum class Weighting {
+        Uniform,      // Umbrella operator: neighbor average
+        Cotangent     // (cot a + cot b) / 2 per edge, clamped at 0; follows the surface, not the sampling
+    };
+
+    size_t iterations = 5;
+    float lambda = 0.5f;        // Shrinking step
+    float mu = -0.53f;          // Inflating step, |mu| > lambda; 0 for plain Laplacian smoothing
+    Weighting weighting = Weighting::Uniform;
+    float featureAngle = 0.0f;  // Degrees; vertices on edges with a sharper dihedral angle stay put (0 = off)
+    bool pinBoundaries = false; // Keep vertices on open boundary edges in place
+};
+
+/// Taubin smoothing (Taubin 1995) of `vertexCount` positions (3 floats,
+/// `stride` bytes apart, updated in place): each iteration moves every
+/// free vertex by lambda, then by mu, times its weighted Laplacian.
+/// Cotangent weights are taken from the input shape. `movable` (optional,
+/// one byte per vertex) marks vertices allowed to move; pinned features
+/// and boundaries are excluded on top of it.
+/// Returns the number of vertices held in place
+size_t smoothTaubin(float* vertices, size_t vertexCount, size_t stride,
+                    const uint32_t* indices, size_t indexCount,
+                    const SmoothingParams& params,
+                    const uint8_t* movable = nullptr);
+
+} // namespace mesh
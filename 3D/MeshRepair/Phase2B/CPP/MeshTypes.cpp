@@ -0,0 +1,294 @@
+//
+//  MeshTypes.cpp
+//  3D
+//
+//  Out-of-line implementations for the shared mesh types
+//
+
+#include "MeshTypes.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace mesh {
+
+// ============================================================
+// Mesh Data
+// ============================================================
+
+size_t compactVertices(MeshData& mesh) {
+    const size_t vertexCount = mesh.vertexCount();
+    const size_t indexCount = mesh.indices.size();
+    const bool hasNormals = mesh.normals.size() == mesh.vertices.size();
+    constexpr size_t Grain = 1 << 16;
+
+    // Referenced bitmap
+    std::vector<std::atomic<uint8_t>> referenced(vertexCount);
+    parallelFor(vertexCount, [&](size_t v) {
+        referenced[v].store(0, std::memory_order_relaxed);
+    }, Grain);
+    parallelFor(indexCount, [&](size_t i) {
+        referenced[mesh.indices[i]].store(1, std::memory_order_relaxed);
+    }, Grain);
+
+    // Exclusive prefix sum: per-chunk counts, scan of the chunk totals,
+    // then each chunk writes its new indices from its own base
+    const size_t chunkCount = (vertexCount + Grain - 1) / Grain;
+    std::vector<uint32_t> chunkBase(chunkCount + 1, 0);
+    parallelForChunks(vertexCount, [&](size_t begin, size_t end) {
+        uint32_t count = 0;
+        for (size_t v = begin; v < end; ++v) {
+            count += referenced[v].load(std::memory_order_relaxed);
+        }
+        chunkBase[begin / Grain + 1] = count;
+    }, Grain);
+    for (size_t c = 0; c < chunkCount; ++c) {
+        chunkBase[c + 1] += chunkBase[c];
+    }
+
+    const size_t keptCount = chunkBase[chunkCount];
+    if (keptCount == vertexCount) {
+        return 0;
+    }
+
+    std::vector<uint32_t> remap(vertexCount);
+    parallelForChunks(vertexCount, [&](size_t begin, size_t end) {
+        uint32_t next = chunkBase[begin / Grain];
+        for (size_t v = begin; v < end; ++v) {
+            remap[v] = next;
+            next += referenced[v].load(std::memory_order_relaxed);
+        }
+    }, Grain);
+
+    // Gather surviving vertices (and normals) into fresh buffers
+    MallocBuffer<float> vertices;
+    MallocBuffer<float> normals;
+    vertices.resize(keptCount * 3);
+    if (hasNormals) {
+        normals.resize(keptCount * 3);
+    }
+    parallelFor(vertexCount, [&](size_t v) {
+        if (!referenced[v].load(std::memory_order_relaxed)) {
+            return;
+        }
+        const size_t dst = size_t(remap[v]) * 3;
+        std::copy(&mesh.vertices[v * 3], &mesh.vertices[v * 3] + 3, &vertices[dst]);
+        if (hasNormals) {
+            std::copy(&mesh.normals[v * 3], &mesh.normals[v * 3] + 3, &normals[dst]);
+        }
+    }, Grain);
+
+    parallelFor(indexCount, [&](size_t i) {
+        mesh.indices[i] = remap[mesh.indices[i]];
+    }, Grain);
+
+    mesh.vertices = std::move(vertices);
+    if (hasNormals) {
+        mesh.normals = std::move(normals);
+    }
+
+    return vertexCount - keptCount;
+}
+
+// ============================================================
+// Edge Table
+// ============================================================
+
+namespace {
+
+/// Number of bits needed to represent `value` (at least 1)
+unsigned int bitWidth(uint32_t value) {
+    unsigned int bits = 1;
+    while (bits < 32 && (value >> bits) != 0) {
+        bits++;
+    }
+    return bits;
+}
+
+} // namespace
+
+void EdgeTable::build(const MeshData& mesh) {
+    const size_t halfEdgeCount = mesh.triangleCount() * 3;
+    const uint32_t* indices = mesh.indices.data();
+
+    _keys.clear();
+    _runStart.clear();
+    _halfEdges.resize(halfEdgeCount);
+    _sortKeys.resize(halfEdgeCount);
+
+    if (halfEdgeCount == 0) {
+        _runStart.push_back(0);
+        return;
+    }
+
+    // Pack keys using only as many bits as the largest vertex index needs,
+    // so the radix sort runs 2-4 passes instead of a full 64-bit sort
+    uint32_t maxIndex = 0;
+    for (size_t i = 0; i < halfEdgeCount; ++i) {
+        maxIndex = std::max(maxIndex, indices[i]);
+    }
+    const unsigned int indexBits = bitWidth(maxIndex);
+    const uint64_t lowMask = (uint64_t(1) << indexBits) - 1;
+
+    for (size_t h = 0; h < halfEdgeCount; ++h) {
+        const size_t tri = h / 3;
+        const uint32_t a = indices[h];
+        const uint32_t b = indices[tri * 3 + (h % 3 + 1) % 3];
+        const uint64_t lo = std::min(a, b);
+        const uint64_t hi = std::max(a, b);
+        _sortKeys[h] = (lo << indexBits) | hi;
+        _halfEdges[h] = static_cast<uint32_t>(h);
+    }
+
+    radixSortPairs(_sortKeys, _halfEdges, _sortKeysTmp, _sortIdsTmp, 2 * indexBits);
+
+    // Run-length encode equal keys into unique edges
+    _keys.reserve(halfEdgeCount / 2 + 1);
+    _runStart.reserve(halfEdgeCount / 2 + 2);
+    for (size_t i = 0; i < halfEdgeCount; ++i) {
+        if (i == 0 || _sortKeys[i] != _sortKeys[i - 1]) {
+            const uint64_t lo = _sortKeys[i] >> indexBits;
+            const uint64_t hi = _sortKeys[i] & lowMask;
+            _keys.push_back((lo << 32) | hi);
+            _runStart.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    _runStart.push_back(static_cast<uint32_t>(halfEdgeCount));
+}
+
+size_t EdgeTable::find(uint32_t a, uint32_t b) const {
+    const uint64_t k = key(a, b);
+    auto it = std::lower_bound(_keys.begin(), _keys.end(), k);
+    if (it == _keys.end() || *it != k) {
+        return npos;
+    }
+    return static_cast<size_t>(it - _keys.begin());
+}
+
+// ============================================================
+// Compact Adjacency (CSR)
+// ============================================================
+
+uint32_t CSRAdjacency::find(size_t node, uint32_t item) const {
+    const uint32_t* rowEnd = end(node);
+    const uint32_t* entry = std::lower_bound(begin(node), rowEnd, item);
+    return entry != rowEnd && *entry == item ? static_cast<uint32_t>(entry - items.data()) : offsets[node + 1];
+}
+
+void CSRAdjacency::buildFromEdges(size_t nodeCount, const uint32_t* pairs, size_t pairCount) {
+    offsets.assign(nodeCount + 1, 0);
+    for (size_t i = 0; i < pairCount * 2; ++i) {
+        offsets[pairs[i] + 1]++;
+    }
+    for (size_t n = 0; n < nodeCount; ++n) {
+        offsets[n + 1] += offsets[n];
+    }
+
+    items.resize(offsets[nodeCount]);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < pairCount; ++i) {
+        const uint32_t a = pairs[i * 2];
+        const uint32_t b = pairs[i * 2 + 1];
+        items[cursor[a]++] = b;
+        items[cursor[b]++] = a;
+    }
+}
+
+void CSRAdjacency::buildGrouped(size_t nodeCount, const uint32_t* nodes, const uint32_t* values, size_t count) {
+    offsets.assign(nodeCount + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        offsets[nodes[i] + 1]++;
+    }
+    for (size_t n = 0; n < nodeCount; ++n) {
+        offsets[n + 1] += offsets[n];
+    }
+
+    items.resize(count);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        items[cursor[nodes[i]]++] = values[i];
+    }
+}
+
+void MeshAdjacency::build(const MeshData& mesh, const std::vector<uint8_t>* removedFaces) {
+    build(mesh.indices.data(), mesh.triangleCount(), mesh.vertexCount(), removedFaces);
+}
+
+void MeshAdjacency::build(const uint32_t* indices, size_t faceCount, size_t vertexCount,
+                          const std::vector<uint8_t>* removedFaces) {
+    if (faceCount * 6 > 0xFFFFFFFFull) {
+        throw std::length_error("Mesh too large for 32-bit adjacency offsets");
+    }
+    _indices = indices;
+
+    auto isLive = [&](size_t face) {
+        return removedFaces == nullptr || face >= removedFaces->size() || !(*removedFaces)[face];
+    };
+
+    // Vertex -> corner: count, prefix sum, scatter
+    _corners.offsets.assign(vertexCount + 1, 0);
+    for (size_t f = 0; f < faceCount; ++f) {
+        if (!isLive(f)) continue;
+        for (size_t k = 0; k < 3; ++k) {
+            _corners.offsets[_indices[f * 3 + k] + 1]++;
+        }
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        _corners.offsets[v + 1] += _corners.offsets[v];
+    }
+
+    _corners.items.resize(_corners.offsets[vertexCount]);
+    std::vector<uint32_t> cursor(_corners.offsets.begin(), _corners.offsets.end() - 1);
+    for (size_t f = 0; f < faceCount; ++f) {
+        if (!isLive(f)) continue;
+        for (size_t k = 0; k < 3; ++k) {
+            const uint32_t corner = static_cast<uint32_t>(f * 3 + k);
+            _corners.items[cursor[_indices[corner]]++] = corner;
+        }
+    }
+
+    // Vertex -> vertex: each corner contributes its two face neighbours
+    // to a row twice the vertex's corner count; rows are sorted and
+    // deduplicated in parallel, then packed
+    std::vector<uint32_t> raw(_corners.items.size() * 2);
+    _neighbors.offsets.assign(vertexCount + 1, 0);
+    parallelForChunks(vertexCount, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            uint32_t* rowStart = raw.data() + size_t(_corners.offsets[v]) * 2;
+            uint32_t* write = rowStart;
+            for (const uint32_t* c = _corners.begin(v); c != _corners.end(v); ++c) {
+                *write++ = _indices[next(*c)];
+                *write++ = _indices[prev(*c)];
+            }
+            std::sort(rowStart, write);
+            write = std::unique(rowStart, write);
+            write = std::remove(rowStart, write, static_cast<uint32_t>(v));
+            _neighbors.offsets[v + 1] = static_cast<uint32_t>(write - rowStart);
+        }
+    }, 1024);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        _neighbors.offsets[v + 1] += _neighbors.offsets[v];
+    }
+
+    _neighbors.items.resize(_neighbors.offsets[vertexCount]);
+    parallelForChunks(vertexCount, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            const uint32_t* rowStart = raw.data() + size_t(_corners.offsets[v]) * 2;
+            std::copy(rowStart, rowStart + _neighbors.degree(v), _neighbors.items.data() + _neighbors.offsets[v]);
+        }
+    }, 1024);
+}
+
+uint32_t MeshAdjacency::twin(uint32_t halfEdge) const {
+    const uint32_t from = origin(halfEdge);
+    const uint32_t to = target(halfEdge);
+    for (const uint32_t* c = _corners.begin(to); c != _corners.end(to); ++c) {
+        if (_indices[next(*c)] == from) {
+            return *c;
+        }
+    }
+    return npos;
+}
+
+} // namespace mesh
@@ -7,8 +7,14 @@
 
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <cmath>
+#include <new>
+#include <type_traits>
 
 namespace mesh {
 
@@ -68,14 +74,171 @@ struct Triangle {
     Triangle(uint32_t a, uint32_t b, uint32_t c) : i0(a), i1(b), i2(c) {}
 };
 
+// ============================================================
+// Detachable Buffer
+// ============================================================
+
+/// Growable array of trivially copyable elements stored in malloc'd memory
+/// The storage can be detached with release() and handed to C callers,
+/// which then own it and must free() it
+template<typename T>
+class MallocBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MallocBuffer only holds trivially copyable types");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    MallocBuffer() : _data(nullptr), _size(0), _capacity(0) {}
+
+    explicit MallocBuffer(size_t count, const T& value = T())
+        : MallocBuffer() {
+        resize(count, value);
+    }
+
+    MallocBuffer(const MallocBuffer& other) : MallocBuffer() {
+        assign(other.begin(), other.end());
+    }
+
+    MallocBuffer(MallocBuffer&& other) noexcept
+        : _data(other._data), _size(other._size), _capacity(other._capacity) {
+        other._data = nullptr;
+        other._size = 0;
+        other._capacity = 0;
+    }
+
+    ~MallocBuffer() {
+        std::free(_data);
+    }
+
+    MallocBuffer& operator=(const MallocBuffer& other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    MallocBuffer& operator=(MallocBuffer&& other) noexcept {
+        if (this != &other) {
+            std::free(_data);
+            _data = other._data;
+            _size = other._size;
+            _capacity = other._capacity;
+            other._data = nullptr;
+            other._size = 0;
+            other._capacity = 0;
+        }
+        return *this;
+    }
+
+    // Element access
+    T* data() { return _data; }
+    const T* data() const { return _data; }
+    T& operator[](size_t index) { return _data[index]; }
+    const T& operator[](size_t index) const { return _data[index]; }
+    T& back() { return _data[_size - 1]; }
+    const T& back() const { return _data[_size - 1]; }
+
+    // Iterators
+    T* begin() { return _data; }
+    T* end() { return _data + _size; }
+    const T* begin() const { return _data; }
+    const T* end() const { return _data + _size; }
+
+    // Capacity
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+
+    void reserve(size_t count) {
+        if (count > _capacity) {
+            reallocate(count);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (_size < _capacity) {
+            reallocate(_size);
+        }
+    }
+
+    // Modifiers
+    void clear() { _size = 0; }
+
+    void resize(size_t count, const T& value = T()) {
+        reserve(count);
+        for (size_t i = _size; i < count; ++i) {
+            _data[i] = value;
+        }
+        _size = count;
+    }
+
+    void push_back(const T& value) {
+        if (_size == _capacity) {
+            reallocate(_capacity < 16 ? 16 : _capacity * 2);
+        }
+        _data[_size++] = value;
+    }
+
+    void assign(const T* first, const T* last) {
+        const size_t count = static_cast<size_t>(last - first);
+        reserve(count);
+        if (count > 0) {
+            std::memcpy(_data, first, count * sizeof(T));
+        }
+        _size = count;
+    }
+
+    void append(const T* first, const T* last) {
+        const size_t count = static_cast<size_t>(last - first);
+        reserve(_size + count);
+        if (count > 0) {
+            std::memcpy(_data + _size, first, count * sizeof(T));
+        }
+        _size += count;
+    }
+
+    /// Detach the storage; the caller takes ownership and must free() it
+    /// The buffer is left empty
+    T* release() {
+        T* detached = _data;
+        _data = nullptr;
+        _size = 0;
+        _capacity = 0;
+        return detached;
+    }
+
+private:
+    void reallocate(size_t count) {
+        if (count == 0) {
+            std::free(_data);
+            _data = nullptr;
+            _capacity = 0;
+            return;
+        }
+        T* grown = static_cast<T*>(std::realloc(_data, count * sizeof(T)));
+        if (grown == nullptr) {
+            throw std::bad_alloc();
+        }
+        _data = grown;
+        _capacity = count;
+    }
+
+    T* _data;
+    size_t _size;
+    size_t _capacity;
+};
+
 // ============================================================
 // Mesh Data Container
 // ============================================================
 
 struct MeshData {
-    std::vector<float> vertices;    // Flat array: [x0,y0,z0, x1,y1,z1, ...]
-    std::vector<uint32_t> indices;  // Triangle indices: [i0,i1,i2, ...]
-    std::vector<float> normals;     // Per-vertex normals (optional)
+    MallocBuffer<float> vertices;    // Flat array: [x0,y0,z0, x1,y1,z1, ...]
+    MallocBuffer<uint32_t> indices;  // Triangle indices: [i0,i1,i2, ...]
+    MallocBuffer<float> normals;     // Per-vertex normals (optional)
 
     MeshData() = default;
     ~MeshData() = default;
@@ -139,6 +302,12 @@ struct MeshData {
         normals.clear();
     }
 
+    // Bytes currently reserved by the three buffers
+    size_t memoryBytes() const {
+        return (vertices.capacity() + normals.capacity()) * sizeof(float) +
+               indices.capacity() * sizeof(uint32_t);
+    }
+
     // Check if valid
     bool isValid() const {
         return !vertices.empty() &&
@@ -148,6 +317,262 @@ struct MeshData {
     }
 };
 
+/// Drop vertices no triangle references and remap indices in place
+/// Per-vertex normals are carried along when present. Returns the number
+/// of vertices removed.
+size_t compactVertices(MeshData& mesh);
+
+// ============================================================
+// Radix Sort
+// ============================================================
+
+/// Stable LSD radix sort of 64-bit `keys` with 32-bit `values` alongside,
+/// 11 bits (2048 buckets, fits in L1) per pass over the low `keyBits` bits.
+/// Passes whose digit is the same for every key are skipped. The tmp
+/// buffers are resized to match and keep the other half of each pass;
+/// `Keys`/`Values` are std::vector or MallocBuffer
+template <typename Keys, typename Values>
+void radixSortPairs(Keys& keys, Values& values, Keys& keysTmp, Values& valuesTmp, unsigned int keyBits) {
+    constexpr unsigned int DigitBits = 11;
+    constexpr size_t Buckets = size_t(1) << DigitBits;
+    const size_t count = keys.size();
+    if (count < 2) {
+        return;
+    }
+    keysTmp.resize(count);
+    valuesTmp.resize(count);
+
+    size_t histogram[Buckets];
+    for (unsigned int shift = 0; shift < keyBits; shift += DigitBits) {
+        std::fill(histogram, histogram + Buckets, size_t(0));
+        for (size_t i = 0; i < count; ++i) {
+            histogram[(keys[i] >> shift) & (Buckets - 1)]++;
+        }
+        if (histogram[(keys[0] >> shift) & (Buckets - 1)] == count) {
+            continue;
+        }
+
+        size_t sum = 0;
+        for (size_t& bucket : histogram) {
+            const size_t size = bucket;
+            bucket = sum;
+            sum += size;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const size_t slot = histogram[(keys[i] >> shift) & (Buckets - 1)]++;
+            keysTmp[slot] = keys[i];
+            valuesTmp[slot] = values[i];
+        }
+        std::swap(keys, keysTmp);
+        std::swap(values, valuesTmp);
+    }
+}
+
+// ============================================================
+// Edge Table
+// ============================================================
+
+/// Sorted table of all triangle edges, built once per mesh in O(F)
+/// Every triangle corner contributes one half-edge (id = tri * 3 + corner,
+/// running from that corner to the next). Half-edges are radix-sorted by
+/// their packed undirected key, so all half-edges sharing an edge form one
+/// contiguous run and per-edge face counts are run lengths.
+class EdgeTable {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// (Re)build from the mesh's triangles, reusing existing storage
+    void build(const MeshData& mesh);
+
+    /// Number of unique undirected edges
+    size_t edgeCount() const {
+        return _keys.size();
+    }
+
+    /// Endpoints of an edge (v0 < v1)
+    uint32_t v0(size_t edge) const {
+        return static_cast<uint32_t>(_keys[edge] >> 32);
+    }
+
+    uint32_t v1(size_t edge) const {
+        return static_cast<uint32_t>(_keys[edge] & 0xFFFFFFFFu);
+    }
+
+    /// Number of half-edges (triangle uses) of an edge
+    uint32_t faceCount(size_t edge) const {
+        return _runStart[edge + 1] - _runStart[edge];
+    }
+
+    /// Half-edge ids using an edge; triangle = id / 3, corner = id % 3
+    const uint32_t* halfEdgesBegin(size_t edge) const {
+        return _halfEdges.data() + _runStart[edge];
+    }
+
+    const uint32_t* halfEdgesEnd(size_t edge) const {
+        return _halfEdges.data() + _runStart[edge + 1];
+    }
+
+    /// Edge index of (a, b) in either orientation, or npos
+    size_t find(uint32_t a, uint32_t b) const;
+
+    /// Bytes currently reserved by the table, including sort scratch
+    size_t memoryBytes() const {
+        return (_keys.capacity() + _sortKeys.capacity() + _sortKeysTmp.capacity()) * sizeof(uint64_t) +
+               (_runStart.capacity() + _halfEdges.capacity() + _sortIdsTmp.capacity()) * sizeof(uint32_t);
+    }
+
+    /// Packed undirected edge key
+    static uint64_t key(uint32_t a, uint32_t b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b
+                     : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+private:
+    std::vector<uint64_t> _keys;       // One packed key per unique edge, ascending
+    std::vector<uint32_t> _runStart;   // CSR offsets into _halfEdges (edgeCount + 1)
+    std::vector<uint32_t> _halfEdges;  // Half-edge ids grouped by edge
+
+    // Radix sort scratch, kept to make rebuilds allocation-free
+    std::vector<uint64_t> _sortKeys, _sortKeysTmp;
+    std::vector<uint32_t> _sortIdsTmp;
+};
+
+// ============================================================
+// Compact Adjacency (CSR)
+// ============================================================
+
+/// Compressed sparse row lists: the items of node n are
+/// items[offsets[n] .. offsets[n+1]), stored contiguously for all nodes
+struct CSRAdjacency {
+    std::vector<uint32_t> offsets;  // nodeCount + 1 prefix sums
+    std::vector<uint32_t> items;
+
+    size_t nodeCount() const {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    uint32_t degree(size_t node) const {
+        return offsets[node + 1] - offsets[node];
+    }
+
+    const uint32_t* begin(size_t node) const {
+        return items.data() + offsets[node];
+    }
+
+    const uint32_t* end(size_t node) const {
+        return items.data() + offsets[node + 1];
+    }
+
+    /// Entry of `item` in node's row, or offsets[node + 1] if absent
+    /// Rows must be sorted ascending
+    uint32_t find(size_t node, uint32_t item) const;
+
+    /// Build an undirected graph from pairs [a0,b0, a1,b1, ...] in O(N + E)
+    void buildFromEdges(size_t nodeCount, const uint32_t* pairs, size_t pairCount);
+
+    /// Group values by node: node n lists every values[i] with nodes[i] == n
+    /// (in input order), in O(N + count)
+    void buildGrouped(size_t nodeCount, const uint32_t* nodes, const uint32_t* values, size_t count);
+};
+
+/// Vertex -> corner and vertex -> vertex adjacency of a triangle mesh,
+/// built in O(V + F) with prefix sums (no per-vertex allocations)
+/// Half-edge h = face * 3 + corner runs from that corner to the next one;
+/// corner ids double as outgoing half-edge ids.
+class MeshAdjacency {
+public:
+    static constexpr uint32_t npos = static_cast<uint32_t>(-1);
+
+    /// Build for all faces, or only faces whose removedFaces flag is 0
+    /// The mesh's index buffer must outlive this object and stay unchanged
+    void build(const MeshData& mesh, const std::vector<uint8_t>* removedFaces = nullptr);
+
+    /// Same over a raw index buffer of `faceCount` triangles; indices must
+    /// be below `vertexCount`
+    void build(const uint32_t* indices, size_t faceCount, size_t vertexCount,
+               const std::vector<uint8_t>* removedFaces = nullptr);
+
+    /// Corners (outgoing half-edges) around each vertex
+    const CSRAdjacency& vertexCorners() const {
+        return _corners;
+    }
+
+    /// Unique neighbouring vertices of each vertex (sorted per vertex); a
+    /// degenerate face never makes a vertex its own neighbour
+    const CSRAdjacency& vertexNeighbors() const {
+        return _neighbors;
+    }
+
+    size_t vertexCount() const {
+        return _corners.nodeCount();
+    }
+
+    static uint32_t face(uint32_t halfEdge) { return halfEdge / 3; }
+    static uint32_t next(uint32_t halfEdge) { return halfEdge - halfEdge % 3 + (halfEdge + 1) % 3; }
+    static uint32_t prev(uint32_t halfEdge) { return halfEdge - halfEdge % 3 + (halfEdge + 2) % 3; }
+
+    uint32_t origin(uint32_t halfEdge) const { return _indices[halfEdge]; }
+    uint32_t target(uint32_t halfEdge) const { return _indices[next(halfEdge)]; }
+
+    /// Opposite half-edge, or npos on a boundary; O(valence of target)
+    uint32_t twin(uint32_t halfEdge) const;
+
+private:
+    const uint32_t* _indices = nullptr;
+    CSRAdjacency _corners;
+    CSRAdjacency _neighbors;
+};
+
+// ============================================================
+// Oriented Point View (non-owning)
+// ============================================================
+
+/// Strided, read-only view over caller-owned position and normal buffers
+/// Strides are in bytes so packed float triples (12) and SIMD3<Float> (16)
+/// can both be read in place without copying
+struct OrientedPointView {
+    const float* points;
+    const float* normals;
+    size_t count;
+    size_t pointStride;
+    size_t normalStride;
+
+    OrientedPointView()
+        : points(nullptr), normals(nullptr), count(0)
+        , pointStride(3 * sizeof(float)), normalStride(3 * sizeof(float)) {}
+
+    OrientedPointView(const float* points_, const float* normals_, size_t count_,
+                      size_t pointStride_ = 3 * sizeof(float),
+                      size_t normalStride_ = 3 * sizeof(float))
+        : points(points_), normals(normals_), count(count_)
+        , pointStride(pointStride_), normalStride(normalStride_) {}
+
+    Point3D point(size_t index) const {
+        const float* p = element(points, pointStride, index);
+        return Point3D(p[0], p[1], p[2]);
+    }
+
+    Point3D normal(size_t index) const {
+        const float* n = element(normals, normalStride, index);
+        return Point3D(n[0], n[1], n[2]);
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool isValid() const {
+        return points != nullptr && normals != nullptr && count > 0 &&
+               pointStride >= 3 * sizeof(float) && normalStride >= 3 * sizeof(float);
+    }
+
+private:
+    static const float* element(const float* base, size_t stride, size_t index) {
+        return reinterpret_cast<const float*>(
+            reinterpret_cast<const unsigned char*>(base) + index * stride);
+    }
+};
+
 // ============================================================
 // Oriented Point Cloud
 // ============================================================
@@ -176,6 +601,15 @@ struct OrientedPointCloud {
         points.clear();
         normals.clear();
     }
+
+    // Non-owning view over the stored points (valid until the cloud changes)
+    OrientedPointView view() const {
+        if (!isValid()) {
+            return OrientedPointView();
+        }
+        return OrientedPointView(&points[0].x, &normals[0].x, points.size(),
+                                 sizeof(Point3D), sizeof(Point3D));
+    }
 };
 
 } // namespace mesh
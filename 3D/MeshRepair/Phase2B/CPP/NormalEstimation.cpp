@@ -0,0 +1,362 @@
+//
+//  NormalEstimation.cpp
+//  3D
+//
+//  Batch PCA normal estimation and MST orientation
+//
+
+#include "NormalEstimation.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace mesh {
+
+namespace {
+
+// Points per structure-of-arrays block: moments for a whole block are
+// gathered before any is solved, then results written back together. The
+// solve is straight-line arithmetic with selects (no library calls, no
+// branches), so the loop over a block's lanes vectorizes
+constexpr size_t BlockSize = 16;
+
+constexpr float Pi = 3.14159265358979f;
+constexpr float HalfSqrt3 = 0.866025403784439f;
+
+/// acos on [-1, 1]: Abramowitz & Stegun 4.4.46, |error| <= 2e-8 (before
+/// float rounding), mirrored for negative arguments
+inline float acosApprox(float x) {
+    const float a = std::fabs(x);
+    float poly = -0.0012624911f;
+    poly = poly * a + 0.0066700901f;
+    poly = poly * a - 0.0170881256f;
+    poly = poly * a + 0.0308918810f;
+    poly = poly * a - 0.0501743046f;
+    poly = poly * a + 0.0889789874f;
+    poly = poly * a - 0.2145988016f;
+    poly = poly * a + 1.5707963050f;
+    const float angle = std::sqrt(std::max(1.0f - a, 0.0f)) * poly;
+    return x < 0.0f ? Pi - angle : angle;
+}
+
+/// cos and sin on [0, pi/3] from their Taylor series; the first dropped
+/// terms are below 4e-9 there
+inline void sinCosApprox(float x, float& sine, float& cosine) {
+    const float x2 = x * x;
+    cosine = 1.0f + x2 * (-1.0f / 2 + x2 * (1.0f / 24 + x2 * (-1.0f / 720 +
+             x2 * (1.0f / 40320 + x2 * (-1.0f / 3628800)))));
+    sine = x * (1.0f + x2 * (-1.0f / 6 + x2 * (1.0f / 120 + x2 * (-1.0f / 5040 +
+           x2 * (1.0f / 362880 + x2 * (-1.0f / 39916800))))));
+}
+
+/// Symmetric 3x3 problems in structure-of-arrays form, one lane each:
+/// upper-triangle inputs, ascending eigenvalues, smallest eigenvector
+struct EigenBlock {
+    float c00[BlockSize], c01[BlockSize], c02[BlockSize];
+    float c11[BlockSize], c12[BlockSize], c22[BlockSize];
+    float l0[BlockSize], l1[BlockSize], l2[BlockSize];
+    float nx[BlockSize], ny[BlockSize], nz[BlockSize];
+};
+
+/// Closed-form eigen solve of the first `lanes` lanes; scale-normalized for
+/// float precision. Degenerate cases are handled with selects rather than
+/// branches, and the loop body inlines into one vectorizable sweep
+void solveBlock(EigenBlock& block, size_t lanes) {
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        float a00 = block.c00[lane], a01 = block.c01[lane], a02 = block.c02[lane];
+        float a11 = block.c11[lane], a12 = block.c12[lane], a22 = block.c22[lane];
+
+        const float scale = std::max(std::max(std::max(std::fabs(a00), std::fabs(a01)),
+                                              std::max(std::fabs(a02), std::fabs(a11))),
+                                     std::max(std::max(std::fabs(a12), std::fabs(a22)), 1e-30f));
+        const float inv = 1.0f / scale;
+        a00 *= inv; a01 *= inv; a02 *= inv;
+        a11 *= inv; a12 *= inv; a22 *= inv;
+
+        // Eigenvalues (Smith 1961)
+        const float q = (a00 + a11 + a22) / 3.0f;
+        const float b00 = a00 - q;
+        const float b11 = a11 - q;
+        const float b22 = a22 - q;
+        const float p1 = a01 * a01 + a02 * a02 + a12 * a12;
+        const float p2 = b00 * b00 + b11 * b11 + b22 * b22 + 2.0f * p1;
+        const float p = std::sqrt(p2 / 6.0f);
+
+        // A multiple of the identity (p ~ 0) has the triple eigenvalue q; the
+        // trigonometric path still runs on a clamped p and is discarded
+        const bool isotropic = !(p > 1e-12f);
+        const float invP = 1.0f / std::max(p, 1e-12f);
+        const float det = (b00 * (b11 * b22 - a12 * a12) -
+                           a01 * (a01 * b22 - a12 * a02) +
+                           a02 * (a01 * a12 - b11 * a02)) * invP * invP * invP;
+        const float r = std::max(-1.0f, std::min(1.0f, 0.5f * det));
+
+        // phi is in [0, pi/3]; cos(phi + 2pi/3) follows from the angle sum
+        float sinPhi, cosPhi;
+        sinCosApprox(acosApprox(r) / 3.0f, sinPhi, cosPhi);
+        const float e2 = isotropic ? q : q + 2.0f * p * cosPhi;
+        const float e0 = isotropic ? q : q - p * (cosPhi + 2.0f * HalfSqrt3 * sinPhi);
+        const float e1 = isotropic ? q : 3.0f * q - e0 - e2;
+
+        // Smallest eigenvector: the largest cross product of two rows of A - e0 I
+        const float r0x = a00 - e0, r0y = a01, r0z = a02;
+        const float r1x = a01, r1y = a11 - e0, r1z = a12;
+        const float r2x = a02, r2y = a12, r2z = a22 - e0;
+
+        const float c0x = r0y * r1z - r0z * r1y, c0y = r0z * r1x - r0x * r1z, c0z = r0x * r1y - r0y * r1x;
+        const float c1x = r0y * r2z - r0z * r2y, c1y = r0z * r2x - r0x * r2z, c1z = r0x * r2y - r0y * r2x;
+        const float c2x = r1y * r2z - r1z * r2y, c2y = r1z * r2x - r1x * r2z, c2z = r1x * r2y - r1y * r2x;
+        const float d0 = c0x * c0x + c0y * c0y + c0z * c0z;
+        const float d1 = c1x * c1x + c1y * c1y + c1z * c1z;
+        const float d2 = c2x * c2x + c2y * c2y + c2z * c2z;
+
+        const bool take1 = d1 > d0;
+        float vx = take1 ? c1x : c0x, vy = take1 ? c1y : c0y, vz = take1 ? c1z : c0z;
+        float best = take1 ? d1 : d0;
+        const bool take2 = d2 > best;
+        vx = take2 ? c2x : vx;
+        vy = take2 ? c2y : vy;
+        vz = take2 ? c2z : vz;
+        best = take2 ? d2 : best;
+
+        // No well-defined direction: fall back to +y
+        const bool defined = best > 1e-20f;
+        const float invLength = 1.0f / std::sqrt(std::max(best, 1e-20f));
+        block.nx[lane] = defined ? vx * invLength : 0.0f;
+        block.ny[lane] = defined ? vy * invLength : 1.0f;
+        block.nz[lane] = defined ? vz * invLength : 0.0f;
+
+        block.l0[lane] = e0 * scale;
+        block.l1[lane] = e1 * scale;
+        block.l2[lane] = e2 * scale;
+    }
+}
+
+} // namespace
+
+void symmetricEigen3(const float covariance[6], float eigenvalues[3], Point3D& normal) {
+    EigenBlock block;
+    block.c00[0] = covariance[0];
+    block.c01[0] = covariance[1];
+    block.c02[0] = covariance[2];
+    block.c11[0] = covariance[3];
+    block.c12[0] = covariance[4];
+    block.c22[0] = covariance[5];
+    solveBlock(block, 1);
+
+    eigenvalues[0] = block.l0[0];
+    eigenvalues[1] = block.l1[0];
+    eigenvalues[2] = block.l2[0];
+    normal = Point3D(block.nx[0], block.ny[0], block.nz[0]);
+}
+
+NormalEstimate estimateNormals(const float* points, size_t count, size_t stride,
+                               const NeighborGraph& graph) {
+    NormalEstimate result;
+    result.normals.resize(count * 3);
+    result.confidence.resize(count);
+
+    auto point = [&](size_t index) {
+        return reinterpret_cast<const float*>(
+            reinterpret_cast<const unsigned char*>(points) + index * stride);
+    };
+
+    const size_t k = graph.pointCount() == count ? graph.k : 0;
+
+    parallelForChunks(count, [&](size_t begin, size_t end) {
+        // Covariance components and results, one lane per point
+        EigenBlock eigen;
+
+        for (size_t block = begin; block < end; block += BlockSize) {
+            const size_t lanes = std::min(BlockSize, end - block);
+
+            // Accumulate moments relative to the query point, which keeps
+            // float sums well-conditioned far from the origin
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                const size_t i = block + lane;
+                const float* origin = point(i);
+                const uint32_t* neighbors = k > 0 ? graph.neighbors(i) : nullptr;
+
+                float sx = 0, sy = 0, sz = 0;
+                float sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+                for (size_t j = 0; j < k; ++j) {
+                    const float* q = point(neighbors[j]);
+                    const float dx = q[0] - origin[0];
+                    const float dy = q[1] - origin[1];
+                    const float dz = q[2] - origin[2];
+                    sx += dx; sy += dy; sz += dz;
+                    sxx += dx * dx; sxy += dx * dy; sxz += dx * dz;
+                    syy += dy * dy; syz += dy * dz; szz += dz * dz;
+                }
+
+                // The point itself contributes a zero offset
+                const float n = static_cast<float>(k + 1);
+                const float mx = sx / n, my = sy / n, mz = sz / n;
+                eigen.c00[lane] = sxx / n - mx * mx;
+                eigen.c01[lane] = sxy / n - mx * my;
+                eigen.c02[lane] = sxz / n - mx * mz;
+                eigen.c11[lane] = syy / n - my * my;
+                eigen.c12[lane] = syz / n - my * mz;
+                eigen.c22[lane] = szz / n - mz * mz;
+            }
+
+            solveBlock(eigen, lanes);
+
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                const size_t i = block + lane;
+                result.normals[i * 3] = eigen.nx[lane];
+                result.normals[i * 3 + 1] = eigen.ny[lane];
+                result.normals[i * 3 + 2] = eigen.nz[lane];
+
+                const float l0 = std::max(0.0f, eigen.l0[lane]);
+                const float sum = l0 + std::max(0.0f, eigen.l1[lane]) + std::max(0.0f, eigen.l2[lane]);
+                const float variation = sum > 0.0f ? l0 / sum : 1.0f / 3.0f;
+                result.confidence[i] = k >= 2 ? std::max(0.0f, 1.0f - 3.0f * variation) : 0.0f;
+            }
+        }
+    }, 1024);
+
+    return result;
+}
+
+// ============================================================
+// Orientation
+// ============================================================
+
+void orientNormals(const float* points, size_t count, size_t stride,
+                   const NeighborGraph& graph, float* normals,
+                   const float* viewpoints, size_t viewpointStride) {
+    if (count == 0 || graph.pointCount() != count) {
+        return;
+    }
+
+    auto element = [](const float* base, size_t elementStride, size_t index) {
+        const float* p = reinterpret_cast<const float*>(
+            reinterpret_cast<const unsigned char*>(base) + index * elementStride);
+        return Point3D(p[0], p[1], p[2]);
+    };
+    auto normal = [&](size_t index) {
+        return Point3D(normals[index * 3], normals[index * 3 + 1], normals[index * 3 + 2]);
+    };
+    auto flip = [&](size_t index) {
+        normals[index * 3] = -normals[index * 3];
+        normals[index * 3 + 1] = -normals[index * 3 + 1];
+        normals[index * 3 + 2] = -normals[index * 3 + 2];
+    };
+
+    // Symmetric Riemannian graph: k-NN rows plus their reverse edges
+    const size_t k = graph.k;
+    std::vector<uint32_t> pairs(count * k * 2);
+    parallelFor(count, [&](size_t i) {
+        const uint32_t* row = graph.neighbors(i);
+        for (size_t j = 0; j < k; ++j) {
+            pairs[(i * k + j) * 2] = static_cast<uint32_t>(i);
+            pairs[(i * k + j) * 2 + 1] = row[j];
+        }
+    });
+    CSRAdjacency adjacency;
+    adjacency.buildFromEdges(count, pairs.data(), count * k);
+    pairs = std::vector<uint32_t>();
+
+    // Connected components, labelled by their smallest point index
+    ConcurrentUnionFind sets(count);
+    parallelFor(count, [&](size_t i) {
+        const uint32_t* row = graph.neighbors(i);
+        for (size_t j = 0; j < k; ++j) {
+            sets.unite(static_cast<uint32_t>(i), row[j]);
+        }
+    });
+    std::vector<uint32_t> labels(count);
+    parallelFor(count, [&](size_t i) {
+        labels[i] = sets.find(static_cast<uint32_t>(i));
+    });
+
+    // Seed score per point; the best point of each component seeds it
+    Point3D centroid(0, 0, 0);
+    if (!viewpoints) {
+        double sx = 0, sy = 0, sz = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const Point3D p = element(points, stride, i);
+            sx += p.x; sy += p.y; sz += p.z;
+        }
+        centroid = Point3D(static_cast<float>(sx / count), static_cast<float>(sy / count),
+                           static_cast<float>(sz / count));
+    }
+
+    // With viewpoints the seed is the point seen most head-on, whose sign is
+    // the least ambiguous; otherwise the extreme point, which lies on the hull
+    auto seedScore = [&](size_t i) {
+        const Point3D p = element(points, stride, i);
+        if (viewpoints) {
+            const Point3D toSensor = (element(viewpoints, viewpointStride, i) - p).normalized();
+            return std::fabs(normal(i).dot(toSensor));
+        }
+        const Point3D d = p - centroid;
+        return d.dot(d);
+    };
+
+    std::vector<uint32_t> seeds(count, std::numeric_limits<uint32_t>::max());
+    std::vector<float> bestScore(count, -1.0f);
+    std::vector<uint32_t> roots;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t root = labels[i];
+        if (static_cast<size_t>(root) == i) {
+            roots.push_back(root);
+        }
+        const float score = seedScore(i);
+        if (score > bestScore[root]) {
+            bestScore[root] = score;
+            seeds[root] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // Prim's algorithm from each seed; components touch disjoint points,
+    // so they propagate independently in parallel
+    std::vector<uint8_t> visited(count, 0);
+    parallelFor(roots.size(), [&](size_t c) {
+        const uint32_t seed = seeds[roots[c]];
+
+        const Point3D seedPoint = element(points, stride, seed);
+        const Point3D outward = viewpoints ? element(viewpoints, viewpointStride, seed) - seedPoint
+                                           : seedPoint - centroid;
+        if (normal(seed).dot(outward) < 0.0f) {
+            flip(seed);
+        }
+
+        // (weight, parent, point); lightest edge first
+        struct Edge {
+            float weight;
+            uint32_t parent;
+            uint32_t point;
+            bool operator>(const Edge& other) const { return weight > other.weight; }
+        };
+        std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge>> frontier;
+
+        auto expand = [&](uint32_t from) {
+            visited[from] = 1;
+            const Point3D n = normal(from);
+            for (const uint32_t* it = adjacency.begin(from); it != adjacency.end(from); ++it) {
+                if (!visited[*it]) {
+                    frontier.push(Edge{1.0f - std::fabs(n.dot(normal(*it))), from, *it});
+                }
+            }
+        };
+
+        expand(seed);
+        while (!frontier.empty()) {
+            const Edge edge = frontier.top();
+            frontier.pop();
+            if (visited[edge.point]) continue;
+
+            if (normal(edge.parent).dot(normal(edge.point)) < 0.0f) {
+                flip(edge.point);
+            }
+            expand(edge.point);
+        }
+    }, 1);
+}
+
+} // namespace mesh
@@ -0,0 +1,46 @@
+//
+//  NormalEstimation.hpp
+//  3D
+//
+//  Batch PCA normal estimation and orientation over a k-NN graph
+//  Covariances are accumulated in structure-of-arrays blocks and the
+//  symmetric 3x3 eigenproblems solved in closed form, a block at a time;
+//  orientation is propagated along a minimum spanning tree
+//
+
+#pragma once
+#include "KdTree.hpp"
+
+namespace mesh {
+
+/// Per-point normals (unoriented) and fit confidence
+struct NormalEstimate {
+    MallocBuffer<float> normals;     // Flat array: [nx0,ny0,nz0, ...], unit length
+    MallocBuffer<float> confidence;  // 1 - 3 * lambda0 / (lambda0 + lambda1 + lambda2), in [0, 1]
+                                     // 1 on a perfect plane, 0 for isotropic neighborhoods
+};
+
+/// Eigen decomposition of a symmetric 3x3 matrix given as
+/// (a00, a01, a02, a11, a12, a22), using the trigonometric closed form
+/// Eigenvalues come back ascending; `normal` is the unit eigenvector of the
+/// smallest one, (0, 1, 0) when it is not well defined
+void symmetricEigen3(const float covariance[6], float eigenvalues[3], Point3D& normal);
+
+/// PCA normal of every point from its neighborhood in `graph` (plus itself)
+/// `points` must be the buffer the graph was built from
+NormalEstimate estimateNormals(const float* points, size_t count, size_t stride,
+                               const NeighborGraph& graph);
+
+/// Consistently orient `normals` (flat, unit length, modified in place)
+/// Each connected component of the k-NN graph is oriented by propagating
+/// from a seed along the minimum spanning tree of 1 - |n_i . n_j| edge
+/// weights (Hoppe et al. 1992); components run in parallel.
+/// With `viewpoints` (one sensor position per point, `viewpointStride`
+/// bytes apart) each seed faces its sensor; otherwise the seed is the point
+/// farthest from the cloud centroid, facing away from it.
+void orientNormals(const float* points, size_t count, size_t stride,
+                   const NeighborGraph& graph, float* normals,
+                   const float* viewpoints = nullptr,
+                   size_t viewpointStride = 3 * sizeof(float));
+
+} // namespace mesh
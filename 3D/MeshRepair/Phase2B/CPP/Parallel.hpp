@@ -0,0 +1,238 @@
+//
+//  Parallel.hpp
+//  3D
+//
+//  Minimal fork-join helpers and concurrent structures for the mesh
+//  processing core
+//
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mesh {
+
+/// Number of threads the helpers below fan out to
+inline unsigned int workerCount() {
+    unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+/// Threads parked between parallel loops, so a loop costs a wake-up rather
+/// than thread creation (per-frame LiDAR ingestion runs several per frame).
+/// One loop uses the pool at a time; a loop started while it is busy, or
+/// from inside a pool task, falls back to threads of its own
+class WorkerPool {
+public:
+    static WorkerPool& shared() {
+        static WorkerPool pool(workerCount() - 1);
+        return pool;
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    size_t size() const { return _threads.size(); }
+
+    /// Run task(0) on the caller and task(1 .. helpers) on pool threads,
+    /// returning when all are done; false (nothing run) if the pool is busy
+    bool tryRun(size_t helpers, const std::function<void(size_t)>& task) {
+        bool expected = false;
+        if (helpers > _threads.size() || onPoolThread() || !_busy.compare_exchange_strong(expected, true)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = &task;
+            _helpers = helpers;
+            _pending = helpers;
+            ++_generation;
+        }
+        _wake.notify_all();
+        task(0);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _pending == 0; });
+            _task = nullptr;
+        }
+        _busy.store(false);
+        return true;
+    }
+
+private:
+    explicit WorkerPool(size_t threads) {
+        _threads.reserve(threads);
+        for (size_t t = 1; t <= threads; ++t) {
+            _threads.emplace_back([this, t] { run(t); });
+        }
+    }
+
+    static bool& onPoolThread() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    void run(size_t index) {
+        onPoolThread() = true;
+        uint64_t seen = 0;
+        while (true) {
+            const std::function<void(size_t)>* task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stop || _generation != seen; });
+                if (_stop) {
+                    return;
+                }
+                seen = _generation;
+                if (index > _helpers) {
+                    continue;
+                }
+                task = _task;
+            }
+            (*task)(index);
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0) {
+                _done.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    const std::function<void(size_t)>* _task = nullptr;
+    size_t _helpers = 0;
+    size_t _pending = 0;
+    uint64_t _generation = 0;
+    bool _stop = false;
+    std::atomic<bool> _busy{false};   // A loop owns the pool
+};
+
+/// Run fn(chunkBegin, chunkEnd) over [0, count) in chunks of `grain` items,
+/// handed out dynamically to all cores. Runs inline when one chunk suffices.
+/// The first exception thrown by any chunk is rethrown on the caller.
+template<typename Fn>
+void parallelForChunks(size_t count, Fn&& fn, size_t grain = 1024) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + grain - 1) / grain;
+    const size_t threads = std::min<size_t>(workerCount(), chunks);
+    if (threads <= 1) {
+        fn(size_t(0), count);
+        return;
+    }
+
+    std::atomic<size_t> nextChunk(0);
+    std::vector<std::exception_ptr> errors(threads);
+    auto worker = [&](size_t thread) {
+        try {
+            size_t chunk;
+            while ((chunk = nextChunk.fetch_add(1)) < chunks) {
+                const size_t begin = chunk * grain;
+                fn(begin, std::min(count, begin + grain));
+            }
+        } catch (...) {
+            errors[thread] = std::current_exception();
+            nextChunk.store(chunks);
+        }
+    };
+
+    if (!WorkerPool::shared().tryRun(threads - 1, worker)) {
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/// Run fn(i) for every i in [0, count) on all cores
+template<typename Fn>
+void parallelFor(size_t count, Fn&& fn, size_t grain = 1024) {
+    parallelForChunks(count, [&fn](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            fn(i);
+        }
+    }, grain);
+}
+
+/// Lock-free disjoint-set forest over element indices
+/// Roots always link toward the smaller index, so concurrent unions from
+/// several threads converge on the same forest without locks
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(size_t count)
+        : _parent(count)
+    {
+        parallelFor(count, [this](size_t i) {
+            _parent[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        });
+    }
+
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t parent = _parent[x].load(std::memory_order_relaxed);
+            if (parent == x) {
+                return x;
+            }
+            // Path halving; losing the race only means less compression
+            uint32_t grandparent = _parent[parent].load(std::memory_order_relaxed);
+            if (parent != grandparent) {
+                _parent[x].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (a < b) {
+                std::swap(a, b);
+            }
+            // Only a root may be relinked; retry if `a` gained a parent meanwhile
+            uint32_t expected = a;
+            if (_parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::vector<std::atomic<uint32_t>> _parent;
+};
+
+} // namespace mesh
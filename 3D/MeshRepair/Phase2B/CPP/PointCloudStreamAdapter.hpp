@@ -15,15 +15,22 @@
 
 namespace mesh {
 
-/// Adapter class that wraps our OrientedPointCloud for PoissonRecon
+/// Adapter class that streams an OrientedPointView into PoissonRecon
+/// Reads straight from the viewed buffers, no intermediate copy is made
 template< typename Real >
 class PointCloudStreamAdapter : public PoissonRecon::Reconstructor::InputOrientedSampleStream< Real , 3 >
 {
 public:
+    /// Constructor from a non-owning view (buffers must outlive the adapter)
+    explicit PointCloudStreamAdapter(const OrientedPointView& view)
+        : _view(view)
+        , _current(0)
+    {
+    }
+
     /// Constructor from our point cloud
     explicit PointCloudStreamAdapter(const OrientedPointCloud& cloud)
-        : _cloud(cloud)
-        , _current(0)
+        : PointCloudStreamAdapter(cloud.view())
     {
     }
 
@@ -37,13 +44,13 @@ public:
     bool read(PoissonRecon::Point< Real , 3 > &point,
               PoissonRecon::Point< Real , 3 > &normal) override
     {
-        if (_current >= _cloud.size()) {
+        if (_current >= _view.size()) {
             return false; // End of stream
         }
 
-        // Get point and normal from our cloud
-        const Point3D& p = _cloud.points[_current];
-        const Point3D& n = _cloud.normals[_current];
+        // Get point and normal from the viewed buffers
+        const Point3D p = _view.point(_current);
+        const Point3D n = _view.normal(_current);
 
         // Convert to PoissonRecon::Point
         point[0] = static_cast<Real>(p.x);
@@ -59,7 +66,7 @@ public:
     }
 
 private:
-    const OrientedPointCloud& _cloud;
+    OrientedPointView _view;
     size_t _current;
 };
 
@@ -2,21 +2,138 @@
 //  PoissonWrapper.cpp
 //  3D
 //
-//  Simplified Poisson wrapper (placeholder for full implementation)
+//  Poisson Surface Reconstruction backed by the vendored PoissonRecon library
 //
 
 #include "PoissonWrapper.hpp"
+#include "PointCloudStreamAdapter.hpp"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 namespace mesh {
 
+namespace {
+
+using Real = float;
+constexpr unsigned int Dim = 3;
+
+// Degree-1 B-splines with Neumann boundaries (PoissonRecon defaults)
+constexpr unsigned int FEMSig = PoissonRecon::FEMDegreeAndBType<
+    PoissonRecon::Reconstructor::Poisson::DefaultFEMDegree,
+    PoissonRecon::Reconstructor::Poisson::DefaultFEMBoundary
+>::Signature;
+
+using FEMSigs = PoissonRecon::IsotropicUIntPack< Dim , FEMSig >;
+using Implicit = PoissonRecon::Reconstructor::Implicit< Real , Dim , FEMSigs >;
+using Solver = PoissonRecon::Reconstructor::Poisson::Solver< Real , Dim , FEMSigs >;
+
+/// Collects extracted level-set vertices straight into MeshData
+/// The indicator gradient points inward, so its negation becomes the
+/// per-vertex normal; densities are kept for trimming
+class MeshVertexStream : public PoissonRecon::Reconstructor::OutputLevelSetVertexStream< Real , Dim >
+{
+public:
+    MeshVertexStream(MeshData& mesh, std::vector<Real>& densities)
+        : _mesh(mesh)
+        , _densities(densities)
+    {
+    }
+
+    size_t size() const override {
+        return _mesh.vertexCount();
+    }
+
+    size_t write(const PoissonRecon::Point< Real , Dim >& p,
+                 const PoissonRecon::Point< Real , Dim >& gradient,
+                 const Real& density) override
+    {
+        _mesh.addVertex(Point3D(p[0], p[1], p[2]));
+
+        Point3D n = Point3D(-gradient[0], -gradient[1], -gradient[2]).normalized();
+        _mesh.normals.push_back(n.x);
+        _mesh.normals.push_back(n.y);
+        _mesh.normals.push_back(n.z);
+
+        _densities.push_back(density);
+        return _mesh.vertexCount() - 1;
+    }
+
+private:
+    MeshData& _mesh;
+    std::vector<Real>& _densities;
+};
+
+/// Collects extracted triangles straight into MeshData
+class MeshFaceStream : public PoissonRecon::Reconstructor::OutputFaceStream< 2 >
+{
+public:
+    explicit MeshFaceStream(MeshData& mesh)
+        : _mesh(mesh)
+    {
+    }
+
+    size_t size() const override {
+        return _mesh.triangleCount();
+    }
+
+    size_t write(const std::vector< PoissonRecon::node_index_type >& polygon) override {
+        // Extraction runs with polygonMesh=false, so polygons are triangles
+        // Fan-split anything larger defensively
+        for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+            _mesh.addTriangle(
+                static_cast<uint32_t>(polygon[0]),
+                static_cast<uint32_t>(polygon[i]),
+                static_cast<uint32_t>(polygon[i + 1])
+            );
+        }
+        return _mesh.triangleCount() - 1;
+    }
+
+private:
+    MeshData& _mesh;
+};
+
+/// Remove triangles touching vertices whose sampling density falls in the
+/// lowest `trimPercentage` quantile (hallucinated surface far from samples)
+size_t trimLowDensity(MeshData& mesh, const std::vector<Real>& densities, float trimPercentage) {
+    if (densities.empty() || trimPercentage <= 0.0f) {
+        return 0;
+    }
+
+    std::vector<Real> sorted = densities;
+    size_t k = std::min(sorted.size() - 1,
+                        static_cast<size_t>(trimPercentage * static_cast<float>(sorted.size())));
+    std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+    const Real threshold = sorted[k];
+
+    size_t kept = 0;
+    const size_t triCount = mesh.triangleCount();
+    for (size_t t = 0; t < triCount; ++t) {
+        const uint32_t* tri = &mesh.indices[t * 3];
+        if (densities[tri[0]] < threshold ||
+            densities[tri[1]] < threshold ||
+            densities[tri[2]] < threshold) {
+            continue;
+        }
+        std::copy(tri, tri + 3, &mesh.indices[kept * 3]);
+        kept++;
+    }
+    mesh.indices.resize(kept * 3);
+
+    return triCount - kept;
+}
+
+} // namespace
+
 PoissonWrapper::PoissonWrapper() {}
 PoissonWrapper::~PoissonWrapper() {}
 
-// Simplified triangulation for now
-// TODO: Integrate full PoissonRecon library
 MeshData PoissonWrapper::reconstruct(const OrientedPointCloud& input, const Configuration& config) {
+    return reconstruct(input.view(), config);
+}
+
+MeshData PoissonWrapper::reconstruct(const OrientedPointView& input, const Configuration& config) {
     if (!input.isValid()) {
         if (config.verbose) {
             std::cerr << "Poisson: Invalid input point cloud" << std::endl;
@@ -25,37 +142,61 @@ MeshData PoissonWrapper::reconstruct(const OrientedPointCloud& input, const Conf
     }
 
     if (config.verbose) {
-        std::cout << "Poisson: Starting reconstruction (simplified)..." << std::endl;
+        std::cout << "Poisson: Starting reconstruction..." << std::endl;
         std::cout << "  Input: " << input.size() << " oriented points" << std::endl;
+        std::cout << "  Depth: " << config.depth
+                  << ", samples/node: " << config.samplesPerNode
+                  << ", scale: " << config.scale << std::endl;
     }
 
-    MeshData output;
+    // Run the solver and the level-set extraction on all cores
+    PoissonRecon::ThreadPool::ParallelizationType = PoissonRecon::ThreadPool::ParallelType::ASYNC;
 
-    // Flatten Point3D to float array for MeshData
-    output.vertices.reserve(input.points.size() * 3);
-    for (const auto& p : input.points) {
-        output.vertices.push_back(p.x);
-        output.vertices.push_back(p.y);
-        output.vertices.push_back(p.z);
-    }
+    PoissonRecon::Reconstructor::Poisson::SolutionParameters<Real> solverParams;
+    solverParams.verbose = config.verbose;
+    solverParams.depth = static_cast<unsigned int>(std::max(config.depth, 1));
+    solverParams.samplesPerNode = static_cast<Real>(config.samplesPerNode);
+    solverParams.scale = static_cast<Real>(config.scale);
+    solverParams.confidence = config.useNormalConfidence;
+
+    PoissonRecon::Reconstructor::LevelSetExtractionParameters extractionParams;
+    extractionParams.forceManifold = true;
+    extractionParams.polygonMesh = false;
+    extractionParams.outputGradients = true;
+    extractionParams.outputDensity = config.enableDensityTrimming;
+    extractionParams.verbose = config.verbose;
 
-    // Simple triangulation: Create triangles from nearby points
-    // This is a PLACEHOLDER - real Poisson reconstruction will be integrated later
-    const size_t pointCount = input.size();
-    if (pointCount >= 3) {
-        // Create a simple fan triangulation around the first point
-        for (size_t i = 1; i < pointCount - 1; ++i) {
-            output.indices.push_back(0);
-            output.indices.push_back(static_cast<uint32_t>(i));
-            output.indices.push_back(static_cast<uint32_t>(i + 1));
+    PointCloudStreamAdapter<Real> sampleStream(input);
+    std::unique_ptr<Implicit> implicit(Solver::Solve(sampleStream, solverParams));
+    if (!implicit) {
+        if (config.verbose) {
+            std::cerr << "Poisson: Solver failed" << std::endl;
         }
+        return MeshData();
+    }
+
+    MeshData output;
+    output.vertices.reserve(input.size() * 3);
+    output.normals.reserve(input.size() * 3);
+    output.indices.reserve(input.size() * 6);
+
+    std::vector<Real> densities;
+    MeshVertexStream vertexStream(output, densities);
+    MeshFaceStream faceStream(output);
+    implicit->extractLevelSet(vertexStream, faceStream, extractionParams);
+
+    size_t trimmed = 0;
+    if (config.enableDensityTrimming) {
+        trimmed = trimLowDensity(output, densities, config.trimPercentage);
     }
 
     if (config.verbose) {
-        std::cout << "Poisson: Reconstruction complete (simplified)" << std::endl;
+        std::cout << "Poisson: Reconstruction complete" << std::endl;
+        if (config.enableDensityTrimming) {
+            std::cout << "  Trimmed " << trimmed << " low-density triangles" << std::endl;
+        }
         std::cout << "  Output: " << output.vertexCount() << " vertices, "
                   << output.triangleCount() << " triangles" << std::endl;
-        std::cout << "  NOTE: Using simplified triangulation (full Poisson integration pending)" << std::endl;
     }
 
     return output;
@@ -3,7 +3,7 @@
 //  3D
 //
 //  C++ wrapper for Poisson Surface Reconstruction
-//  Will be integrated with actual PoissonRecon library in Day 5-6
+//  Runs the vendored PoissonRecon solver (ThirdParty/PoissonRecon/Src)
 //
 
 #pragma once
@@ -21,6 +21,7 @@ public:
         bool enableDensityTrimming;
         float trimPercentage;
         bool verbose;
+        bool useNormalConfidence;   // Normal length is the sample weight
 
         Configuration()
             : depth(9)
@@ -29,6 +30,7 @@ public:
             , enableDensityTrimming(true)
             , trimPercentage(0.05f)
             , verbose(true)
+            , useNormalConfidence(false)
         {}
     };
 
@@ -37,14 +39,18 @@ public:
 
     /// Main reconstruction function
     /// Input: Oriented point cloud (points + normals)
-    /// Output: Watertight triangle mesh
+    /// Output: Watertight triangle mesh with per-vertex normals
+    /// (open where density trimming removed unsupported surface)
     MeshData reconstruct(
         const OrientedPointCloud& input,
         const Configuration& config = Configuration()
     );
 
-private:
-    // Implementation details (simplified version uses inline implementation)
+    /// Zero-copy variant reading directly from caller-owned buffers
+    MeshData reconstruct(
+        const OrientedPointView& input,
+        const Configuration& config = Configuration()
+    );
 };
 
 } // namespace mesh
@@ -0,0 +1,308 @@
+//
+//  SparseVoxelGrid.cpp
+//  3D
+//
+//  Brick-sparse rasterization, dilation and dense volume export
+//
+
+#include "SparseVoxelGrid.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+
+namespace mesh {
+
+namespace {
+
+using BrickMask = SparseVoxelGrid::BrickMask;
+
+// Bits of a mask word on each y/z face of the brick (bit = y * 8 + z)
+constexpr uint64_t ZLow = 0x0101010101010101ull;
+constexpr uint64_t ZHigh = 0x8080808080808080ull;
+constexpr uint64_t YLow = 0x00000000000000FFull;
+constexpr uint64_t YHigh = 0xFF00000000000000ull;
+
+// Directions, matching brickNeighbors()
+enum Direction { MinusX, PlusX, MinusY, PlusY, MinusZ, PlusZ };
+
+/// For every voxel of a brick, whether its neighbor in `direction` is set
+/// `outside` is the adjacent brick's mask in that direction, null if absent
+inline void neighborMask(const BrickMask& mask, const BrickMask* outside, int direction, BrickMask& out) {
+    const int last = SparseVoxelGrid::BrickSize - 1;
+    for (int x = 0; x <= last; ++x) {
+        const uint64_t w = mask[x];
+        const uint64_t o = outside ? (*outside)[x] : 0;
+        switch (direction) {
+        case MinusX: out[x] = x > 0 ? mask[x - 1] : (outside ? (*outside)[last] : 0); break;
+        case PlusX:  out[x] = x < last ? mask[x + 1] : (outside ? (*outside)[0] : 0); break;
+        case MinusY: out[x] = (w << 8) | (o >> 56); break;
+        case PlusY:  out[x] = (w >> 8) | ((o & YLow) << 56); break;
+        case MinusZ: out[x] = ((w << 1) & ~ZLow) | ((o & ZHigh) >> 7); break;
+        case PlusZ:  out[x] = ((w >> 1) & ~ZHigh) | ((o & ZLow) << 7); break;
+        }
+    }
+}
+
+/// Whether a mask has set voxels on the brick face toward `direction`
+inline bool touchesFace(const BrickMask& mask, int direction) {
+    uint64_t any = 0;
+    switch (direction) {
+    case MinusX: return mask[0] != 0;
+    case PlusX:  return mask[SparseVoxelGrid::BrickSize - 1] != 0;
+    case MinusY: for (uint64_t w : mask) any |= w & YLow; break;
+    case PlusY:  for (uint64_t w : mask) any |= w & YHigh; break;
+    case MinusZ: for (uint64_t w : mask) any |= w & ZLow; break;
+    case PlusZ:  for (uint64_t w : mask) any |= w & ZHigh; break;
+    }
+    return any != 0;
+}
+
+const int32_t DirectionOffset[6][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+} // namespace
+
+SparseVoxelGrid::SparseVoxelGrid(float voxelSize, const Point3D& origin)
+    : _voxelSize(voxelSize), _origin(origin) {
+    if (!(voxelSize > 0.0f)) {
+        throw std::invalid_argument("SparseVoxelGrid voxel size must be positive");
+    }
+}
+
+uint32_t SparseVoxelGrid::findOrCreateBrick(int32_t x, int32_t y, int32_t z) {
+    bool inserted = false;
+    const uint32_t index = _brickIndex.insert(packBlockKey(x, y, z), static_cast<uint32_t>(_bricks.size()), inserted);
+    if (inserted) {
+        _bricks.emplace_back();
+        Brick& brick = _bricks.back();
+        brick.x = x;
+        brick.y = y;
+        brick.z = z;
+        brick.occupancy.fill(0);
+        std::fill(brick.counts, brick.counts + BrickVoxels, uint16_t(0));
+    }
+    return index;
+}
+
+std::vector<std::array<uint32_t, 6>> SparseVoxelGrid::brickNeighbors() const {
+    std::vector<std::array<uint32_t, 6>> neighbors(_bricks.size());
+    parallelFor(_bricks.size(), [&](size_t b) {
+        const Brick& brick = _bricks[b];
+        for (int d = 0; d < 6; ++d) {
+            neighbors[b][d] = findBrick(brick.x + DirectionOffset[d][0],
+                                        brick.y + DirectionOffset[d][1],
+                                        brick.z + DirectionOffset[d][2]);
+        }
+    });
+    return neighbors;
+}
+
+size_t SparseVoxelGrid::memoryBytes() const {
+    return _bricks.capacity() * sizeof(Brick) + _brickIndex.memoryBytes();
+}
+
+bool SparseVoxelGrid::occupied(int32_t x, int32_t y, int32_t z) const {
+    const int32_t bx = floorDiv(x, BrickSize);
+    const int32_t by = floorDiv(y, BrickSize);
+    const int32_t bz = floorDiv(z, BrickSize);
+    const uint32_t b = findBrick(bx, by, bz);
+    if (b == BlockHashMap::npos) {
+        return false;
+    }
+    const int32_t ly = y - by * BrickSize;
+    const int32_t lz = z - bz * BrickSize;
+    return (_bricks[b].occupancy[x - bx * BrickSize] >> (ly * BrickSize + lz)) & 1;
+}
+
+size_t SparseVoxelGrid::occupiedCount() const {
+    size_t count = 0;
+    for (const Brick& brick : _bricks) {
+        for (uint64_t w : brick.occupancy) {
+            count += static_cast<size_t>(__builtin_popcountll(w));
+        }
+    }
+    return count;
+}
+
+// ============================================================
+// Rasterization and Thresholding
+// ============================================================
+
+void SparseVoxelGrid::rasterize(const float* points, size_t count, size_t stride) {
+    const float inverseVoxel = 1.0f / _voxelSize;
+
+    // Consecutive points mostly share a brick; remember the last one
+    uint64_t lastKey = ~uint64_t(0);
+    uint32_t lastBrick = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const float* p = reinterpret_cast<const float*>(
+            reinterpret_cast<const unsigned char*>(points) + i * stride);
+        const float fx = std::floor((p[0] - _origin.x) * inverseVoxel);
+        const float fy = std::floor((p[1] - _origin.y) * inverseVoxel);
+        const float fz = std::floor((p[2] - _origin.z) * inverseVoxel);
+        if (!(std::fabs(fx) < 1e6f && std::fabs(fy) < 1e6f && std::fabs(fz) < 1e6f)) {
+            continue;   // Non-finite or outside the addressable range
+        }
+
+        const int32_t x = static_cast<int32_t>(fx);
+        const int32_t y = static_cast<int32_t>(fy);
+        const int32_t z = static_cast<int32_t>(fz);
+        const int32_t bx = floorDiv(x, BrickSize);
+        const int32_t by = floorDiv(y, BrickSize);
+        const int32_t bz = floorDiv(z, BrickSize);
+
+        const uint64_t key = packBlockKey(bx, by, bz);
+        if (key != lastKey) {
+            lastBrick = findOrCreateBrick(bx, by, bz);
+            lastKey = key;
+        }
+
+        uint16_t& c = _bricks[lastBrick].counts[voxelIndex(x - bx * BrickSize, y - by * BrickSize, z - bz * BrickSize)];
+        if (c < 0xFFFF) {
+            c++;
+        }
+    }
+}
+
+size_t SparseVoxelGrid::threshold(float fraction) {
+    uint16_t peak = 0;
+    for (const Brick& brick : _bricks) {
+        peak = std::max(peak, *std::max_element(brick.counts, brick.counts + BrickVoxels));
+    }
+    const float minimum = std::max(fraction * static_cast<float>(peak), 1.0f);
+
+    parallelFor(_bricks.size(), [&](size_t b) {
+        Brick& brick = _bricks[b];
+        for (int32_t x = 0; x < BrickSize; ++x) {
+            uint64_t w = 0;
+            const uint16_t* counts = brick.counts + voxelIndex(x, 0, 0);
+            for (int32_t bit = 0; bit < BrickSize * BrickSize; ++bit) {
+                w |= uint64_t(static_cast<float>(counts[bit]) >= minimum) << bit;
+            }
+            brick.occupancy[x] = w;
+        }
+    }, 64);
+
+    return occupiedCount();
+}
+
+// ============================================================
+// Dilation
+// ============================================================
+
+size_t SparseVoxelGrid::dilate(size_t iterations, float seedFraction) {
+    uint16_t peak = 0;
+    for (const Brick& brick : _bricks) {
+        peak = std::max(peak, *std::max_element(brick.counts, brick.counts + BrickVoxels));
+    }
+    const float seedCount = seedFraction * static_cast<float>(peak);
+
+    // Seeds: voxels strictly above the seed density
+    std::vector<BrickMask> current(_bricks.size());
+    parallelFor(_bricks.size(), [&](size_t b) {
+        const Brick& brick = _bricks[b];
+        for (int32_t x = 0; x < BrickSize; ++x) {
+            uint64_t w = 0;
+            const uint16_t* counts = brick.counts + voxelIndex(x, 0, 0);
+            for (int32_t bit = 0; bit < BrickSize * BrickSize; ++bit) {
+                w |= uint64_t(counts[bit] > 0 && static_cast<float>(counts[bit]) > seedCount) << bit;
+            }
+            current[b][x] = w;
+        }
+    }, 64);
+
+    for (size_t iteration = 0; iteration < iterations; ++iteration) {
+        // Allocate empty bricks the front is about to grow into
+        const size_t existing = _bricks.size();
+        for (size_t b = 0; b < existing; ++b) {
+            for (int d = 0; d < 6; ++d) {
+                if (touchesFace(current[b], d)) {
+                    const Brick& brick = _bricks[b];
+                    findOrCreateBrick(brick.x + DirectionOffset[d][0],
+                                      brick.y + DirectionOffset[d][1],
+                                      brick.z + DirectionOffset[d][2]);
+                }
+            }
+        }
+        current.resize(_bricks.size(), BrickMask{});
+
+        // One 6-connected step: OR of the mask shifted in every direction
+        const std::vector<std::array<uint32_t, 6>> neighbors = brickNeighbors();
+        std::vector<BrickMask> next(_bricks.size());
+        parallelFor(_bricks.size(), [&](size_t b) {
+            BrickMask grown = current[b];
+            BrickMask shifted;
+            for (int d = 0; d < 6; ++d) {
+                const uint32_t n = neighbors[b][d];
+                neighborMask(current[b], n == BlockHashMap::npos ? nullptr : &current[n], d, shifted);
+                for (int32_t x = 0; x < BrickSize; ++x) {
+                    grown[x] |= shifted[x];
+                }
+            }
+            next[b] = grown;
+        }, 64);
+        current.swap(next);
+    }
+
+    parallelFor(_bricks.size(), [&](size_t b) {
+        for (int32_t x = 0; x < BrickSize; ++x) {
+            _bricks[b].occupancy[x] |= current[b][x];
+        }
+    }, 64);
+
+    return occupiedCount();
+}
+
+// ============================================================
+// Dense Volume Export
+// ============================================================
+
+BitVolume SparseVoxelGrid::occupancyVolume(int32_t padding, int32_t offset[3]) const {
+    int32_t lo[3] = {INT32_MAX, INT32_MAX, INT32_MAX};
+    int32_t hi[3] = {INT32_MIN, INT32_MIN, INT32_MIN};
+    for (const Brick& brick : _bricks) {
+        uint64_t any = 0;
+        for (uint64_t w : brick.occupancy) {
+            any |= w;
+        }
+        if (any == 0) continue;
+        const int32_t b[3] = {brick.x, brick.y, brick.z};
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], b[a]);
+            hi[a] = std::max(hi[a], b[a]);
+        }
+    }
+    if (lo[0] > hi[0]) {
+        offset[0] = offset[1] = offset[2] = 0;
+        return BitVolume(0, 0, 0);
+    }
+
+    // Whole-brick padding keeps brick z bytes aligned within volume words
+    const int32_t pad = (std::max(padding, 0) + BrickSize - 1) / BrickSize;
+    size_t dims[3];
+    for (int a = 0; a < 3; ++a) {
+        offset[a] = (lo[a] - pad) * BrickSize;
+        dims[a] = static_cast<size_t>(hi[a] - lo[a] + 1 + 2 * pad) * BrickSize;
+    }
+
+    BitVolume volume(dims[0], dims[1], dims[2]);
+    for (const Brick& brick : _bricks) {
+        const size_t z = static_cast<size_t>(brick.z * BrickSize - offset[2]);
+        for (int32_t lx = 0; lx < BrickSize; ++lx) {
+            const uint64_t w = brick.occupancy[lx];
+            if (w == 0) continue;
+            const size_t x = static_cast<size_t>(brick.x * BrickSize + lx - offset[0]);
+            for (int32_t ly = 0; ly < BrickSize; ++ly) {
+                const uint64_t bits = (w >> (ly * BrickSize)) & 0xFF;
+                const size_t y = static_cast<size_t>(brick.y * BrickSize + ly - offset[1]);
+                volume.row(x, y)[z / 64] |= bits << (z % 64);
+            }
+        }
+    }
+    return volume;
+}
+
+} // namespace mesh
@@ -0,0 +1,92 @@
+//
+//  SparseVoxelGrid.hpp
+//  3D
+//
+//  Sparse occupancy grid for voxel-based repair
+//  Space is divided into hashed 8^3 bricks allocated only where points land;
+//  each brick keeps per-voxel point counts and a 512-bit occupancy mask, so
+//  dilation and boundary tests run as word-wide shifts instead of per-voxel
+//  neighbor reads
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+#include "VoxelBlocks.hpp"
+#include "VoxelMorphology.hpp"
+#include <array>
+
+namespace mesh {
+
+class SparseVoxelGrid {
+public:
+    static constexpr int32_t BrickSize = 8;
+    static constexpr size_t BrickVoxels = BrickSize * BrickSize * BrickSize;
+
+    /// Occupancy of one brick: word x holds bit (y * 8 + z)
+    using BrickMask = std::array<uint64_t, BrickSize>;
+
+    /// Voxel (i, j, k) spans origin + [i, i + 1) * voxelSize on each axis
+    SparseVoxelGrid(float voxelSize, const Point3D& origin);
+
+    /// Count `count` points (3 floats, `stride` bytes apart) into their voxels
+    /// Can be called repeatedly to accumulate
+    void rasterize(const float* points, size_t count, size_t stride = 3 * sizeof(float));
+
+    /// Mark voxels holding at least `fraction` of the densest voxel's count
+    /// occupied (the dense grid's normalize-then-threshold); clears the rest
+    /// Returns the number of occupied voxels
+    size_t threshold(float fraction);
+
+    /// 6-connected dilation seeded by voxels above `seedFraction` of the peak
+    /// count, grown `iterations` steps and merged into the occupancy
+    /// Returns the number of occupied voxels afterwards
+    size_t dilate(size_t iterations, float seedFraction);
+
+    /// Occupancy of the bounding box of all occupied bricks, grown by at
+    /// least `padding` voxels (rounded up to whole bricks), as a dense bit
+    /// volume for morphology; `offset` receives the grid voxel that volume
+    /// voxel (0, 0, 0) maps to
+    BitVolume occupancyVolume(int32_t padding, int32_t offset[3]) const;
+
+    bool occupied(int32_t x, int32_t y, int32_t z) const;
+
+    size_t occupiedCount() const;
+
+    size_t brickCount() const {
+        return _bricks.size();
+    }
+
+    size_t memoryBytes() const;
+
+    float voxelSize() const {
+        return _voxelSize;
+    }
+
+private:
+    struct Brick {
+        int32_t x, y, z;                   // Brick coordinates (voxel / BrickSize)
+        BrickMask occupancy;
+        uint16_t counts[BrickVoxels];      // Saturating point counts, x-major then y then z
+    };
+
+    static size_t voxelIndex(int32_t x, int32_t y, int32_t z) {
+        return (size_t(x) * BrickSize + size_t(y)) * BrickSize + size_t(z);
+    }
+
+    uint32_t findBrick(int32_t x, int32_t y, int32_t z) const {
+        return _brickIndex.find(packBlockKey(x, y, z));
+    }
+
+    uint32_t findOrCreateBrick(int32_t x, int32_t y, int32_t z);
+
+    /// Bricks adjacent to each brick in -x, +x, -y, +y, -z, +z order
+    /// (BlockHashMap::npos where unallocated)
+    std::vector<std::array<uint32_t, 6>> brickNeighbors() const;
+
+    float _voxelSize;
+    Point3D _origin;
+    std::vector<Brick> _bricks;
+    BlockHashMap _brickIndex;
+};
+
+} // namespace mesh
@@ -0,0 +1,508 @@
+//
+//  TsdfVolume.cpp
+//  3D
+//
+//  Sparse TSDF integration, zero-crossing and marching cubes extraction
+//
+
+#include "TsdfVolume.hpp"
+#include "Parallel.hpp"
+#include "VoxelSurface.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace mesh {
+
+namespace {
+
+// Depth rows per filtering/allocation task, blocks per update task
+constexpr size_t RowGrain = 8;
+constexpr size_t BlockGrain = 4;
+
+} // namespace
+
+TsdfVolume::TsdfVolume(const Configuration& config) : _config(config) {
+    if (!(config.voxelSize > 0.0f) || !(config.truncation > 0.0f) || !(config.maxWeight > 0.0f)) {
+        throw std::invalid_argument("TsdfVolume voxel size, truncation and max weight must be positive");
+    }
+}
+
+void TsdfVolume::clear() {
+    _pages.clear();
+    _blockCount = 0;
+    _blockIndex.clear();
+}
+
+size_t TsdfVolume::memoryBytes() const {
+    return _pages.size() * PageBlocks * sizeof(Block) + _blockIndex.memoryBytes();
+}
+
+const TsdfVolume::Block* TsdfVolume::blockContaining(int32_t x, int32_t y, int32_t z, size_t& index) const {
+    const int32_t bx = floorDiv(x, BlockSize);
+    const int32_t by = floorDiv(y, BlockSize);
+    const int32_t bz = floorDiv(z, BlockSize);
+    const uint32_t block = _blockIndex.find(packBlockKey(bx, by, bz));
+    if (block == BlockHashMap::npos) {
+        return nullptr;
+    }
+    index = voxelIndex(x - bx * BlockSize, y - by * BlockSize, z - bz * BlockSize);
+    return &this->block(block);
+}
+
+bool TsdfVolume::sample(const Block& home, int32_t x, int32_t y, int32_t z, float minWeight,
+                        float& tsdf, float& weight) const {
+    const int32_t lx = x - home.x * BlockSize;
+    const int32_t ly = y - home.y * BlockSize;
+    const int32_t lz = z - home.z * BlockSize;
+    const Block* block = &home;
+    size_t index;
+    if (lx >= 0 && ly >= 0 && lz >= 0 && lx < BlockSize && ly < BlockSize && lz < BlockSize) {
+        index = voxelIndex(lx, ly, lz);
+    } else {
+        block = blockContaining(x, y, z, index);
+        if (!block) return false;
+    }
+    weight = block->weight[index];
+    tsdf = block->tsdf[index];
+    return weight >= minWeight;
+}
+
+Point3D TsdfVolume::gradient(const Block& home, int32_t x, int32_t y, int32_t z, float tsdf, float minWeight) const {
+    float g[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float tp, tm, w;
+        const bool hasPlus = sample(home, x + (axis == 0), y + (axis == 1), z + (axis == 2), minWeight, tp, w);
+        const bool hasMinus = sample(home, x - (axis == 0), y - (axis == 1), z - (axis == 2), minWeight, tm, w);
+        g[axis] = (hasPlus ? tp : tsdf) - (hasMinus ? tm : tsdf);
+    }
+    return Point3D(g[0], g[1], g[2]);
+}
+
+float TsdfVolume::distance(int32_t x, int32_t y, int32_t z, float& weight) const {
+    size_t index = 0;
+    const Block* block = blockContaining(x, y, z, index);
+    if (!block) {
+        weight = 0.0f;
+        return _config.truncation;
+    }
+    weight = block->weight[index];
+    return block->tsdf[index] * _config.truncation;
+}
+
+// ============================================================
+// Integration
+// ============================================================
+
+size_t TsdfVolume::integrate(const float* depth, size_t depthRowBytes,
+                             const uint8_t* confidence, size_t confidenceRowBytes,
+                             size_t width, size_t height,
+                             const DepthUnprojectionParams& params,
+                             size_t* acceptedSamples) {
+    if (acceptedSamples) {
+        *acceptedSamples = 0;
+    }
+    if (width == 0 || height == 0) {
+        return 0;
+    }
+
+    const DepthIntrinsics& k = params.intrinsics;
+    const float* m = params.pose;
+    const Point3D camera(m[12], m[13], m[14]);
+    const float truncation = _config.truncation;
+    const float blockExtent = _config.voxelSize * BlockSize;
+    const float inverseBlockExtent = 1.0f / blockExtent;
+
+    // Depth with rejected pixels zeroed, densely packed for the gathers below
+    _filteredDepth.resize(width * height);
+    std::vector<size_t> chunkSamples((height + RowGrain - 1) / RowGrain, 0);
+    parallelForChunks(height, [&](size_t rowBegin, size_t rowEnd) {
+        size_t accepted = 0;
+        for (size_t v = rowBegin; v < rowEnd; ++v) {
+            const float* depthRow = reinterpret_cast<const float*>(
+                reinterpret_cast<const unsigned char*>(depth) + v * depthRowBytes);
+            float* out = _filteredDepth.data() + v * width;
+            for (size_t u = 0; u < width; ++u) {
+                const float d = depthRow[u];
+                out[u] = d > params.minDepth && d <= params.maxDepth ? d : 0.0f;
+            }
+            if (confidence) {
+                const uint8_t* confidenceRow = confidence + v * confidenceRowBytes;
+                for (size_t u = 0; u < width; ++u) {
+                    out[u] = confidenceRow[u] >= params.minConfidence ? out[u] : 0.0f;
+                }
+            }
+            for (size_t u = 0; u < width; ++u) {
+                accepted += out[u] != 0.0f;
+            }
+        }
+        chunkSamples[rowBegin / RowGrain] = accepted;
+    }, RowGrain);
+    if (acceptedSamples) {
+        *acceptedSamples = std::accumulate(chunkSamples.begin(), chunkSamples.end(), size_t(0));
+    }
+
+    // 1. Blocks crossed by the +-truncation band around every sampled depth;
+    //    runs of equal keys along a row are dropped early, the rest merged
+    const size_t step = std::max<size_t>(params.step, 1);
+    const size_t rows = (height + step - 1) / step;
+    const size_t chunks = (rows + RowGrain - 1) / RowGrain;
+    std::vector<std::vector<uint64_t>> chunkKeys(chunks);
+    const int samples = std::max(2, static_cast<int>(std::ceil(2.0f * truncation / (0.5f * blockExtent)))) + 1;
+
+    parallelForChunks(rows, [&](size_t rowBegin, size_t rowEnd) {
+        std::vector<uint64_t>& keys = chunkKeys[rowBegin / RowGrain];
+        uint64_t last = ~uint64_t(0);
+        for (size_t row = rowBegin; row < rowEnd; ++row) {
+            const size_t v = row * step;
+            const float rayY = -(static_cast<float>(v) - k.cy) / k.fy;
+            for (size_t u = 0; u < width; u += step) {
+                const float d = _filteredDepth[v * width + u];
+                if (d == 0.0f) continue;
+
+                const float rayX = (static_cast<float>(u) - k.cx) / k.fx;
+                const Point3D p(d * (m[0] * rayX + m[4] * rayY - m[8]) + m[12],
+                                d * (m[1] * rayX + m[5] * rayY - m[9]) + m[13],
+                                d * (m[2] * rayX + m[6] * rayY - m[10]) + m[14]);
+                const Point3D direction = (p - camera).normalized();
+
+                for (int s = 0; s < samples; ++s) {
+                    const float t = -truncation + 2.0f * truncation * static_cast<float>(s) / (samples - 1);
+                    const Point3D q = p + direction * t;
+                    const uint64_t key = packBlockKey(static_cast<int32_t>(std::floor(q.x * inverseBlockExtent)),
+                                                      static_cast<int32_t>(std::floor(q.y * inverseBlockExtent)),
+                                                      static_cast<int32_t>(std::floor(q.z * inverseBlockExtent)));
+                    if (key != last) {
+                        keys.push_back(key);
+                        last = key;
+                    }
+                }
+            }
+        }
+    }, RowGrain);
+
+    std::vector<uint64_t> keys;
+    for (auto& chunk : chunkKeys) {
+        keys.insert(keys.end(), chunk.begin(), chunk.end());
+        chunk = std::vector<uint64_t>();
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // 2. Allocate the blocks not seen before
+    std::vector<uint32_t> frameBlocks(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        bool inserted = false;
+        frameBlocks[i] = _blockIndex.insert(keys[i], static_cast<uint32_t>(_blockCount), inserted);
+        if (inserted) {
+            if (_blockCount == _pages.size() * PageBlocks) {
+                _pages.emplace_back(new Block[PageBlocks]);
+            }
+            Block& block = this->block(static_cast<uint32_t>(_blockCount++));
+            unpackBlockKey(keys[i], block.x, block.y, block.z);
+            std::fill(block.tsdf, block.tsdf + BlockVoxels, 1.0f);
+            std::fill(block.weight, block.weight + BlockVoxels, 0.0f);
+        }
+    }
+
+    // 3. Projective update of every voxel in the frame's blocks: project the
+    //    voxel center into the depth map and fuse the truncated distance along
+    //    the optical axis as a running weighted average. Each block is first
+    //    projected in one branch-free pass, then gathered and updated
+    const float voxelSize = _config.voxelSize;
+    const float maxWeight = _config.maxWeight;
+    const float inverseTruncation = 1.0f / truncation;
+    const float widthLimit = static_cast<float>(width);
+    const float heightLimit = static_cast<float>(height);
+    const float nearLimit = std::max(params.minDepth, 1e-3f);
+    const int32_t rowPixels = static_cast<int32_t>(width);
+
+    parallelForChunks(frameBlocks.size(), [&](size_t begin, size_t end) {
+        float viewDepth[BlockVoxels];
+        int32_t pixel[BlockVoxels];
+
+        for (size_t f = begin; f < end; ++f) {
+            Block& block = this->block(frameBlocks[f]);
+
+            // World -> camera with the transposed rotation
+            const float ox = static_cast<float>(block.x * BlockSize) * voxelSize + 0.5f * voxelSize - m[12];
+            const float oy = static_cast<float>(block.y * BlockSize) * voxelSize + 0.5f * voxelSize - m[13];
+            const float oz = static_cast<float>(block.z * BlockSize) * voxelSize + 0.5f * voxelSize - m[14];
+
+            for (int32_t i = 0; i < static_cast<int32_t>(BlockVoxels); ++i) {
+                const float dx = ox + static_cast<float>(i >> 6) * voxelSize;
+                const float dy = oy + static_cast<float>((i >> 3) & 7) * voxelSize;
+                const float dz = oz + static_cast<float>(i & 7) * voxelSize;
+                const float cx = m[0] * dx + m[1] * dy + m[2] * dz;
+                const float cy = m[4] * dx + m[5] * dy + m[6] * dz;
+                const float z = -(m[8] * dx + m[9] * dy + m[10] * dz);
+
+                // Voxels behind the camera project through a clamped depth so
+                // every lane stays finite; they are masked out below
+                const float inverseZ = 1.0f / std::max(z, nearLimit);
+                const float u = k.fx * cx * inverseZ + k.cx + 0.5f;
+                const float v = k.cy - k.fy * cy * inverseZ + 0.5f;
+                const bool inside = (z > nearLimit) & (u >= 0.0f) & (v >= 0.0f) &
+                                    (u < widthLimit) & (v < heightLimit);
+                const int32_t pu = static_cast<int32_t>(std::min(std::max(u, 0.0f), widthLimit - 1.0f));
+                const int32_t pv = static_cast<int32_t>(std::min(std::max(v, 0.0f), heightLimit - 1.0f));
+                viewDepth[i] = z;
+                pixel[i] = inside ? pv * rowPixels + pu : -1;
+            }
+
+            // Masked rather than branched: which voxels update is close to
+            // random along the block and would mispredict
+            const float* filtered = _filteredDepth.data();
+            for (int32_t i = 0; i < static_cast<int32_t>(BlockVoxels); ++i) {
+                const float d = filtered[std::max(pixel[i], 0)];
+                const float sdf = d - viewDepth[i];
+                const bool update = (pixel[i] >= 0) & (d > 0.0f) & (sdf >= -truncation);
+
+                const float weight = block.weight[i];
+                const float tsdf = std::min(1.0f, sdf * inverseTruncation);
+                const float fused = (block.tsdf[i] * weight + tsdf) / (weight + 1.0f);
+                block.tsdf[i] = update ? fused : block.tsdf[i];
+                block.weight[i] = update ? std::min(weight + 1.0f, maxWeight) : weight;
+            }
+        }
+    }, BlockGrain);
+
+    return frameBlocks.size();
+}
+
+// ============================================================
+// Surface Extraction
+// ============================================================
+
+TsdfSurfacePoints TsdfVolume::extractSurfacePoints(float minWeight) const {
+    const float voxelSize = _config.voxelSize;
+    minWeight = std::max(minWeight, std::numeric_limits<float>::min());
+
+    const size_t chunks = (_blockCount + BlockGrain - 1) / BlockGrain;
+    std::vector<TsdfSurfacePoints> chunkPoints(chunks);
+
+    parallelForChunks(_blockCount, [&](size_t begin, size_t end) {
+        TsdfSurfacePoints& out = chunkPoints[begin / BlockGrain];
+        for (size_t b = begin; b < end; ++b) {
+            const Block& block = this->block(static_cast<uint32_t>(b));
+            for (int32_t lx = 0; lx < BlockSize; ++lx) {
+                for (int32_t ly = 0; ly < BlockSize; ++ly) {
+                    for (int32_t lz = 0; lz < BlockSize; ++lz) {
+                        const size_t index = voxelIndex(lx, ly, lz);
+                        const float ta = block.tsdf[index];
+                        const float wa = block.weight[index];
+                        if (wa < minWeight || std::fabs(ta) >= 1.0f) continue;
+
+                        const int32_t x = block.x * BlockSize + lx;
+                        const int32_t y = block.y * BlockSize + ly;
+                        const int32_t z = block.z * BlockSize + lz;
+
+                        for (int axis = 0; axis < 3; ++axis) {
+                            float tb, wb;
+                            if (!sample(block, x + (axis == 0), y + (axis == 1), z + (axis == 2), minWeight, tb, wb)) continue;
+                            if ((ta < 0.0f) == (tb < 0.0f) || std::fabs(tb) >= 1.0f) continue;
+
+                            const Point3D normal = gradient(block, x, y, z, ta, minWeight).normalized();
+                            if (normal.dot(normal) == 0.0f) continue;
+
+                            const float t = ta / (ta - tb);
+                            out.points.push_back((static_cast<float>(x) + 0.5f + (axis == 0 ? t : 0.0f)) * voxelSize);
+                            out.points.push_back((static_cast<float>(y) + 0.5f + (axis == 1 ? t : 0.0f)) * voxelSize);
+                            out.points.push_back((static_cast<float>(z) + 0.5f + (axis == 2 ? t : 0.0f)) * voxelSize);
+                            out.normals.push_back(normal.x);
+                            out.normals.push_back(normal.y);
+                            out.normals.push_back(normal.z);
+                            out.weights.push_back(std::min(wa, wb));
+                        }
+                    }
+                }
+            }
+        }
+    }, BlockGrain);
+
+    TsdfSurfacePoints surface;
+    for (const TsdfSurfacePoints& chunk : chunkPoints) {
+        surface.points.append(chunk.points.begin(), chunk.points.end());
+        surface.normals.append(chunk.normals.begin(), chunk.normals.end());
+        surface.weights.append(chunk.weights.begin(), chunk.weights.end());
+    }
+    return surface;
+}
+
+MeshData TsdfVolume::extractSurfaceMesh(float minWeight) const {
+    MeshData mesh;
+    const float voxelSize = _config.voxelSize;
+    minWeight = std::max(minWeight, std::numeric_limits<float>::min());
+
+    // Each cell spans eight voxels from its lowest corner; each grid edge
+    // belongs to the block holding its lower voxel, as bit
+    // axis * BlockVoxels + voxelIndex in that block's edge mask. Vertices are
+    // numbered by bit rank, so every cell finds a shared edge's vertex
+    // without a hash, as in extractVoxelSurface
+    constexpr size_t EdgeWords = 3 * BlockVoxels / 64;
+    const size_t blocks = _blockCount;
+    std::vector<uint64_t> edgeMasks(blocks * EdgeWords, 0);
+    std::vector<size_t> blockTriangles(blocks, 0);
+
+    // Case of the cell at a global voxel; 0 when a corner is unobserved or
+    // at the truncation limit, where sign changes are not surface
+    auto cellCase = [&](const Block& home, int32_t x, int32_t y, int32_t z) {
+        unsigned mcCase = 0;
+        for (unsigned c = 0; c < 8; ++c) {
+            float tsdf, weight;
+            if (!sample(home, x + (c & 1), y + ((c >> 1) & 1), z + ((c >> 2) & 1), minWeight, tsdf, weight) ||
+                std::fabs(tsdf) >= 1.0f) {
+                return 0u;
+            }
+            mcCase |= static_cast<unsigned>(tsdf < 0.0f) << c;
+        }
+        return mcCase;
+    };
+
+    // Owning block and mask bit of cube edge `edge` of the cell at (x, y, z)
+    auto edgeBit = [&](uint32_t homeIndex, const Block& home, int32_t x, int32_t y, int32_t z,
+                       int edge, uint32_t& owner) {
+        const int axis = edge / 4;
+        const int a = edge & 1;
+        const int b = (edge >> 1) & 1;
+        const int32_t ex = x + (axis == 0 ? 0 : a);
+        const int32_t ey = y + (axis == 1 ? 0 : (axis == 0 ? a : b));
+        const int32_t ez = z + (axis == 2 ? 0 : b);
+        int32_t lx = ex - home.x * BlockSize;
+        int32_t ly = ey - home.y * BlockSize;
+        int32_t lz = ez - home.z * BlockSize;
+        owner = homeIndex;
+        if (lx >= BlockSize || ly >= BlockSize || lz >= BlockSize) {
+            // Edge corners were sampled, so the block exists
+            const int32_t bx = floorDiv(ex, BlockSize);
+            const int32_t by = floorDiv(ey, BlockSize);
+            const int32_t bz = floorDiv(ez, BlockSize);
+            owner = _blockIndex.find(packBlockKey(bx, by, bz));
+            lx = ex - bx * BlockSize;
+            ly = ey - by * BlockSize;
+            lz = ez - bz * BlockSize;
+        }
+        return size_t(axis) * BlockVoxels + voxelIndex(lx, ly, lz);
+    };
+
+    // Visit every cell of a block that produces triangles
+    auto forEachCell = [&](const Block& block, auto&& fn) {
+        for (int32_t lx = 0; lx < BlockSize; ++lx) {
+            for (int32_t ly = 0; ly < BlockSize; ++ly) {
+                for (int32_t lz = 0; lz < BlockSize; ++lz) {
+                    const int32_t x = block.x * BlockSize + lx;
+                    const int32_t y = block.y * BlockSize + ly;
+                    const int32_t z = block.z * BlockSize + lz;
+                    int triangles;
+                    const int8_t* edges = marchingCubesTriangles(cellCase(block, x, y, z), triangles);
+                    if (triangles > 0) {
+                        fn(x, y, z, edges, triangles);
+                    }
+                }
+            }
+        }
+    };
+
+    // Pass 1: mark the edges used by triangles; a cell's edges may belong
+    // to neighboring blocks handled by other workers
+    parallelForChunks(blocks, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const uint32_t homeIndex = static_cast<uint32_t>(b);
+            const Block& home = block(homeIndex);
+            forEachCell(home, [&](int32_t x, int32_t y, int32_t z, const int8_t* edges, int triangles) {
+                for (int i = 0; i < 3 * triangles; ++i) {
+                    uint32_t owner;
+                    const size_t bit = edgeBit(homeIndex, home, x, y, z, edges[i], owner);
+                    __atomic_fetch_or(&edgeMasks[owner * EdgeWords + bit / 64], uint64_t(1) << (bit % 64),
+                                      __ATOMIC_RELAXED);
+                }
+                blockTriangles[b] += static_cast<size_t>(triangles);
+            });
+        }
+    }, BlockGrain);
+
+    // Scan edge counts into each block's first vertex, triangles into offsets
+    std::vector<uint32_t> vertexStart(blocks);
+    uint64_t vertexCount = 0;
+    size_t triangleCount = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        vertexStart[b] = static_cast<uint32_t>(vertexCount);
+        for (size_t w = 0; w < EdgeWords; ++w) {
+            vertexCount += static_cast<uint64_t>(__builtin_popcountll(edgeMasks[b * EdgeWords + w]));
+        }
+        const size_t count = blockTriangles[b];
+        blockTriangles[b] = triangleCount;
+        triangleCount += count;
+    }
+    if (vertexCount > 0xFFFFFFFFull) {
+        throw std::length_error("TSDF surface exceeds 32-bit vertex indices");
+    }
+
+    // Pass 2: vertices at the zero crossing, normals from the gradient
+    // interpolated between the edge's voxels
+    mesh.vertices.resize(static_cast<size_t>(vertexCount) * 3);
+    mesh.normals.resize(static_cast<size_t>(vertexCount) * 3);
+    parallelForChunks(blocks, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const Block& home = block(static_cast<uint32_t>(b));
+            size_t vertex = vertexStart[b];
+            for (size_t w = 0; w < EdgeWords; ++w) {
+                for (uint64_t bits = edgeMasks[b * EdgeWords + w]; bits != 0; bits &= bits - 1) {
+                    const size_t bit = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                    const int axis = static_cast<int>(bit / BlockVoxels);
+                    const size_t index = bit % BlockVoxels;
+                    const int32_t x = home.x * BlockSize + static_cast<int32_t>(index >> 6);
+                    const int32_t y = home.y * BlockSize + static_cast<int32_t>((index >> 3) & 7);
+                    const int32_t z = home.z * BlockSize + static_cast<int32_t>(index & 7);
+
+                    float ta, tb, weight;
+                    sample(home, x, y, z, minWeight, ta, weight);
+                    sample(home, x + (axis == 0), y + (axis == 1), z + (axis == 2), minWeight, tb, weight);
+                    const float t = ta / (ta - tb);
+                    const Point3D normal = (gradient(home, x, y, z, ta, minWeight) * (1.0f - t) +
+                                            gradient(home, x + (axis == 0), y + (axis == 1), z + (axis == 2),
+                                                     tb, minWeight) * t).normalized();
+
+                    float* p = mesh.vertices.data() + vertex * 3;
+                    p[0] = (static_cast<float>(x) + 0.5f + (axis == 0 ? t : 0.0f)) * voxelSize;
+                    p[1] = (static_cast<float>(y) + 0.5f + (axis == 1 ? t : 0.0f)) * voxelSize;
+                    p[2] = (static_cast<float>(z) + 0.5f + (axis == 2 ? t : 0.0f)) * voxelSize;
+                    float* n = mesh.normals.data() + vertex * 3;
+                    n[0] = normal.x;
+                    n[1] = normal.y;
+                    n[2] = normal.z;
+                    ++vertex;
+                }
+            }
+        }
+    }, BlockGrain);
+
+    // Pass 3: triangles, looking up each edge's vertex by rank in its block
+    mesh.indices.resize(triangleCount * 3);
+    parallelForChunks(blocks, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const uint32_t homeIndex = static_cast<uint32_t>(b);
+            const Block& home = block(homeIndex);
+            uint32_t* out = mesh.indices.data() + blockTriangles[b] * 3;
+            forEachCell(home, [&](int32_t x, int32_t y, int32_t z, const int8_t* edges, int triangles) {
+                for (int i = 0; i < 3 * triangles; ++i) {
+                    uint32_t owner;
+                    const size_t bit = edgeBit(homeIndex, home, x, y, z, edges[i], owner);
+                    const uint64_t* mask = edgeMasks.data() + owner * EdgeWords;
+                    uint32_t vertex = vertexStart[owner];
+                    for (size_t w = 0; w < bit / 64; ++w) {
+                        vertex += static_cast<uint32_t>(__builtin_popcountll(mask[w]));
+                    }
+                    const uint64_t below = (uint64_t(1) << (bit % 64)) - 1;
+                    *out++ = vertex + static_cast<uint32_t>(__builtin_popcountll(mask[bit / 64] & below));
+                }
+            });
+        }
+    }, BlockGrain);
+
+    return mesh;
+}
+
+} // namespace mesh
@@ -0,0 +1,117 @@
+//
+//  TsdfVolume.hpp
+//  3D
+//
+//  Sparse truncated signed distance field fused incrementally from depth
+//  frames. Voxels live in hashed 8^3 blocks allocated along the truncation
+//  band of each frame, so memory follows surface area rather than the
+//  bounding volume; blocks seen by a frame are updated in parallel. Blocks
+//  are stored in fixed pages, so growing the volume never moves them
+//
+
+#pragma once
+#include "DepthUnprojection.hpp"
+#include "VoxelBlocks.hpp"
+#include <memory>
+
+namespace mesh {
+
+/// Zero-crossing samples of the fused surface
+struct TsdfSurfacePoints {
+    MallocBuffer<float> points;     // Flat array: [x0,y0,z0, ...]
+    MallocBuffer<float> normals;    // Flat array, unit length, pointing into free space
+    MallocBuffer<float> weights;    // Fused observation weight of each sample
+};
+
+class TsdfVolume {
+public:
+    static constexpr int32_t BlockSize = 8;
+    static constexpr size_t BlockVoxels = BlockSize * BlockSize * BlockSize;
+
+    struct Configuration {
+        float voxelSize = 0.005f;    // Meters
+        float truncation = 0.02f;    // Meters; should span at least 2-3 voxels
+        float maxWeight = 64.0f;     // Cap on fused weight, keeps the volume responsive
+    };
+
+    TsdfVolume() : TsdfVolume(Configuration()) {}
+    explicit TsdfVolume(const Configuration& config);
+
+    /// Fuse one depth map (see DepthFrameRing::ingest for the buffer and
+    /// parameter conventions; params.step thins the block allocation rays
+    /// only, every pixel still contributes to the update)
+    /// Returns the number of blocks the frame touched; `acceptedSamples`, when
+    /// given, receives the number of depth pixels that passed the filters
+    size_t integrate(const float* depth, size_t depthRowBytes,
+                     const uint8_t* confidence, size_t confidenceRowBytes,
+                     size_t width, size_t height,
+                     const DepthUnprojectionParams& params,
+                     size_t* acceptedSamples = nullptr);
+
+    /// Points where the field crosses zero between neighboring voxels that
+    /// both have at least `minWeight`, with normals from the field gradient
+    TsdfSurfacePoints extractSurfacePoints(float minWeight = 1.0f) const;
+
+    /// Marching cubes surface of the zero level set over cells whose eight
+    /// voxels all have at least `minWeight` and lie inside the truncation
+    /// band. Vertices sit on the zero crossings with normals from the field
+    /// gradient; triangles face free space and neighboring cells share
+    /// vertices, including across blocks
+    MeshData extractSurfaceMesh(float minWeight = 1.0f) const;
+
+    /// Signed distance (meters) and weight at a voxel; weight 0 if unobserved
+    float distance(int32_t x, int32_t y, int32_t z, float& weight) const;
+
+    size_t blockCount() const {
+        return _blockCount;
+    }
+
+    size_t memoryBytes() const;
+
+    const Configuration& configuration() const {
+        return _config;
+    }
+
+    void clear();
+
+private:
+    struct Block {
+        int32_t x, y, z;             // Block coordinates (voxel / BlockSize)
+        float tsdf[BlockVoxels];     // Normalized to [-1, 1], x-major then y then z
+        float weight[BlockVoxels];
+    };
+
+    static constexpr size_t PageBlocks = 256;   // About 1 MB per page
+
+    static size_t voxelIndex(int32_t x, int32_t y, int32_t z) {
+        return (size_t(x) * BlockSize + size_t(y)) * BlockSize + size_t(z);
+    }
+
+    Block& block(uint32_t index) {
+        return _pages[index / PageBlocks][index % PageBlocks];
+    }
+
+    const Block& block(uint32_t index) const {
+        return _pages[index / PageBlocks][index % PageBlocks];
+    }
+
+    // Block and in-block index of a global voxel; null when unallocated
+    const Block* blockContaining(int32_t x, int32_t y, int32_t z, size_t& index) const;
+
+    // Normalized distance and weight at a global voxel, looked up in `home`
+    // first; false when unallocated or observed less than `minWeight`
+    bool sample(const Block& home, int32_t x, int32_t y, int32_t z, float minWeight,
+                float& tsdf, float& weight) const;
+
+    // Central-difference field gradient at a voxel with distance `tsdf`,
+    // one-sided where a neighbor is not observed; not normalized
+    Point3D gradient(const Block& home, int32_t x, int32_t y, int32_t z, float tsdf, float minWeight) const;
+
+    Configuration _config;
+    std::vector<std::unique_ptr<Block[]>> _pages;
+    size_t _blockCount = 0;
+    BlockHashMap _blockIndex;
+    std::vector<float> _filteredDepth;   // Per-frame scratch, reused
+};
+
+} // namespace mesh
@@ -0,0 +1,131 @@
+//
+//  VoxelBlocks.hpp
+//  3D
+//
+//  Block coordinates and an open-addressing hash map for sparse voxel
+//  volumes, which allocate fixed-size voxel blocks only where needed
+//
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mesh {
+
+/// Integer block coordinates packed into 63 bits (21 per axis, offset
+/// binary), so keys sort by x, then y, then z; covers +-2^20 blocks per axis
+inline uint64_t packBlockKey(int32_t x, int32_t y, int32_t z) {
+    constexpr int32_t Offset = 1 << 20;
+    constexpr uint64_t Mask = (uint64_t(1) << 21) - 1;
+    return ((uint64_t(x + Offset) & Mask) << 42) |
+           ((uint64_t(y + Offset) & Mask) << 21) |
+           (uint64_t(z + Offset) & Mask);
+}
+
+inline void unpackBlockKey(uint64_t key, int32_t& x, int32_t& y, int32_t& z) {
+    constexpr int32_t Offset = 1 << 20;
+    constexpr uint64_t Mask = (uint64_t(1) << 21) - 1;
+    x = static_cast<int32_t>((key >> 42) & Mask) - Offset;
+    y = static_cast<int32_t>((key >> 21) & Mask) - Offset;
+    z = static_cast<int32_t>(key & Mask) - Offset;
+}
+
+/// Floor division for voxel -> block coordinates with negative voxels
+inline int32_t floorDiv(int32_t value, int32_t divisor) {
+    const int32_t quotient = value / divisor;
+    return quotient * divisor > value ? quotient - 1 : quotient;
+}
+
+/// Block key -> block index map with linear probing; serves any 64-bit
+/// key that leaves bit 63 clear, such as Morton codes
+/// Lookups are read-only and safe to run concurrently; inserts are not
+class BlockHashMap {
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    /// Index stored for `key`, or npos
+    uint32_t find(uint64_t key) const {
+        if (_size == 0) {
+            return npos;
+        }
+        const size_t mask = _keys.size() - 1;
+        for (size_t slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+            if (_keys[slot] == key) return _values[slot];
+            if (_keys[slot] == EmptyKey) return npos;
+        }
+    }
+
+    /// Store `value` for a new key, or return the existing index
+    /// `inserted` reports which happened
+    uint32_t insert(uint64_t key, uint32_t value, bool& inserted) {
+        if ((_size + 1) * 2 > _keys.size()) {
+            rehash(_keys.empty() ? 64 : _keys.size() * 2);
+        }
+        const size_t mask = _keys.size() - 1;
+        for (size_t slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+            if (_keys[slot] == key) {
+                inserted = false;
+                return _values[slot];
+            }
+            if (_keys[slot] == EmptyKey) {
+                _keys[slot] = key;
+                _values[slot] = value;
+                _size++;
+                inserted = true;
+                return value;
+            }
+        }
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    void clear() {
+        _keys.clear();
+        _values.clear();
+        _size = 0;
+    }
+
+    size_t memoryBytes() const {
+        return _keys.capacity() * sizeof(uint64_t) + _values.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    // Keys never set bit 63
+    static constexpr uint64_t EmptyKey = ~uint64_t(0);
+
+    static size_t hash(uint64_t key) {
+        // splitmix64 finalizer
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ull;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebull;
+        key ^= key >> 31;
+        return static_cast<size_t>(key);
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<uint64_t> keys(capacity, EmptyKey);
+        std::vector<uint32_t> values(capacity, npos);
+        const size_t mask = capacity - 1;
+        for (size_t i = 0; i < _keys.size(); ++i) {
+            if (_keys[i] == EmptyKey) continue;
+            size_t slot = hash(_keys[i]) & mask;
+            while (keys[slot] != EmptyKey) {
+                slot = (slot + 1) & mask;
+            }
+            keys[slot] = _keys[i];
+            values[slot] = _values[i];
+        }
+        _keys.swap(keys);
+        _values.swap(values);
+    }
+
+    std::vector<uint64_t> _keys;
+    std::vector<uint32_t> _values;
+    size_t _size = 0;
+};
+
+} // namespace mesh
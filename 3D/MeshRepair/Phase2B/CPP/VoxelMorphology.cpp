@@ -0,0 +1,239 @@
+//
+//  VoxelMorphology.cpp
+//  3D
+//
+//  Word-parallel morphology and flood fill over z-packed voxel rows
+//
+
+#include "VoxelMorphology.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+
+namespace mesh {
+
+namespace {
+
+/// Rows or slabs per parallel task, so each task covers a few thousand words
+size_t grainFor(size_t wordsPerItem) {
+    return std::max<size_t>(1, 4096 / std::max<size_t>(wordsPerItem, 1));
+}
+
+/// Extend set bits of `g` toward higher bits through runs of `p`
+/// (Kogge-Stone occluded fill: six shift steps cover 64 bits)
+inline uint64_t fillUp(uint64_t g, uint64_t p) {
+    g |= p & (g << 1);  p &= p << 1;
+    g |= p & (g << 2);  p &= p << 2;
+    g |= p & (g << 4);  p &= p << 4;
+    g |= p & (g << 8);  p &= p << 8;
+    g |= p & (g << 16); p &= p << 16;
+    g |= p & (g << 32);
+    return g;
+}
+
+/// Extend set bits of `g` toward lower bits through runs of `p`
+inline uint64_t fillDown(uint64_t g, uint64_t p) {
+    g |= p & (g >> 1);  p &= p >> 1;
+    g |= p & (g >> 2);  p &= p >> 2;
+    g |= p & (g >> 4);  p &= p >> 4;
+    g |= p & (g >> 8);  p &= p >> 8;
+    g |= p & (g >> 16); p &= p >> 16;
+    g |= p & (g >> 32);
+    return g;
+}
+
+struct Layout {
+    size_t nx, ny, wordsPerRow;
+    uint64_t lastWordMask;
+};
+
+/// One 6-connected dilation (OR of neighbors) or erosion (AND) of slab x
+/// `outside` is the word standing in for voxels beyond the volume
+template<bool Erode>
+void morphologySlab(const uint64_t* src, uint64_t* dst, size_t x, const Layout& layout, uint64_t outside) {
+    const size_t words = layout.wordsPerRow;
+    const size_t slabWords = layout.ny * words;
+    for (size_t y = 0; y < layout.ny; ++y) {
+        const size_t offset = x * slabWords + y * words;
+        const uint64_t* center = src + offset;
+        const uint64_t* minusX = x > 0 ? center - slabWords : nullptr;
+        const uint64_t* plusX = x + 1 < layout.nx ? center + slabWords : nullptr;
+        const uint64_t* minusY = y > 0 ? center - words : nullptr;
+        const uint64_t* plusY = y + 1 < layout.ny ? center + words : nullptr;
+        uint64_t* out = dst + offset;
+
+        for (size_t w = 0; w < words; ++w) {
+            const bool last = w + 1 == words;
+            // Padding bits past nz behave like the outside
+            const uint64_t c = last ? (center[w] | (outside & ~layout.lastWordMask)) : center[w];
+            const uint64_t below = w > 0 ? center[w - 1] : outside;
+            const uint64_t above = last ? outside : center[w + 1];
+            const uint64_t fromMinusZ = (c << 1) | (below >> 63);
+            const uint64_t fromPlusZ = (c >> 1) | (above << 63);
+            const uint64_t mx = minusX ? minusX[w] : outside;
+            const uint64_t px = plusX ? plusX[w] : outside;
+            const uint64_t my = minusY ? minusY[w] : outside;
+            const uint64_t py = plusY ? plusY[w] : outside;
+
+            const uint64_t result = Erode ? (c & fromMinusZ & fromPlusZ & mx & px & my & py)
+                                          : (c | fromMinusZ | fromPlusZ | mx | px | my | py);
+            out[w] = last ? result & layout.lastWordMask : result;
+        }
+    }
+}
+
+template<bool Erode>
+void morphology(std::vector<uint64_t>& words, const Layout& layout, size_t iterations, uint64_t outside) {
+    if (iterations == 0 || words.empty()) {
+        return;
+    }
+    std::vector<uint64_t> scratch(words.size());
+    for (size_t i = 0; i < iterations; ++i) {
+        parallelFor(layout.nx, [&](size_t x) {
+            morphologySlab<Erode>(words.data(), scratch.data(), x, layout, outside);
+        }, grainFor(layout.ny * layout.wordsPerRow));
+        words.swap(scratch);
+    }
+}
+
+} // namespace
+
+BitVolume::BitVolume(size_t nx, size_t ny, size_t nz)
+    : _nx(nx), _ny(ny), _nz(nz), _wordsPerRow((nz + 63) / 64),
+      _words(nx * ny * _wordsPerRow, 0) {}
+
+size_t BitVolume::count() const {
+    size_t total = 0;
+    for (uint64_t w : _words) {
+        total += static_cast<size_t>(__builtin_popcountll(w));
+    }
+    return total;
+}
+
+// ============================================================
+// Morphology
+// ============================================================
+
+void BitVolume::dilate(size_t iterations) {
+    morphology<false>(_words, Layout{_nx, _ny, _wordsPerRow, lastWordMask()}, iterations, 0);
+}
+
+void BitVolume::erode(size_t iterations, bool outsideSet) {
+    morphology<true>(_words, Layout{_nx, _ny, _wordsPerRow, lastWordMask()}, iterations,
+                     outsideSet ? ~uint64_t(0) : 0);
+}
+
+void BitVolume::close(size_t radius) {
+    dilate(radius);
+    erode(radius, true);
+}
+
+// ============================================================
+// Exterior Flood Fill
+// ============================================================
+
+BitVolume BitVolume::exterior() const {
+    BitVolume outside(_nx, _ny, _nz);
+    if (_words.empty()) {
+        return outside;
+    }
+
+    const size_t words = _wordsPerRow;
+    const uint64_t lastMask = lastWordMask();
+    const uint64_t topBit = uint64_t(1) << ((_nz - 1) % 64);
+
+    // Voxels the fill may pass through
+    std::vector<uint64_t> open(_words.size());
+    parallelFor(_nx * _ny, [&](size_t r) {
+        for (size_t w = 0; w < words; ++w) {
+            open[r * words + w] = ~_words[r * words + w];
+        }
+        open[r * words + words - 1] &= lastMask;
+    }, grainFor(words));
+
+    std::atomic<bool> changed(false);
+
+    // Seed row (x, y) from an adjacent row (null: outside the volume, all
+    // exterior) and the volume ends, then fill along z in both directions
+    auto update = [&](size_t x, size_t y, const uint64_t* neighbor) {
+        uint64_t* row = outside.row(x, y);
+        const uint64_t* free = open.data() + (x * _ny + y) * words;
+        // Rows are always left filled along z, so nothing new to seed means
+        // nothing to do (the common case once the fill has converged locally)
+        uint64_t fresh = (free[0] & ~row[0] & 1) | (free[words - 1] & ~row[words - 1] & topBit);
+        for (size_t w = 0; w < words; ++w) {
+            fresh |= (neighbor ? neighbor[w] : ~uint64_t(0)) & free[w] & ~row[w];
+        }
+        if (fresh == 0) {
+            return;
+        }
+        bool grew = false;
+
+        uint64_t carry = 1;   // Below z = 0 lies the outside
+        for (size_t w = 0; w < words; ++w) {
+            const uint64_t seed = (neighbor ? neighbor[w] : ~uint64_t(0)) | carry;
+            const uint64_t g = fillUp(row[w] | (seed & free[w]), free[w]);
+            grew |= g != row[w];
+            row[w] = g;
+            carry = g >> 63;
+        }
+
+        carry = 1;            // Above z = nz - 1 as well
+        for (size_t w = words; w-- > 0;) {
+            const uint64_t seed = w + 1 == words ? (carry ? topBit : 0) : (carry << 63);
+            const uint64_t g = fillDown(row[w] | (seed & free[w]), free[w]);
+            grew |= g != row[w];
+            row[w] = g;
+            carry = g & 1;
+        }
+
+        if (grew) {
+            changed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    // Alternate x-slab passes (sweeping y) with y-column passes (sweeping x);
+    // each pass only touches rows it owns, and z runs fill instantly, so the
+    // passes needed grow with the turns in the path to a cavity, not its length
+    do {
+        changed.store(false, std::memory_order_relaxed);
+
+        parallelFor(_nx, [&](size_t x) {
+            for (size_t y = 0; y < _ny; ++y) {
+                update(x, y, y > 0 ? outside.row(x, y - 1) : nullptr);
+            }
+            for (size_t y = _ny; y-- > 0;) {
+                update(x, y, y + 1 < _ny ? outside.row(x, y + 1) : nullptr);
+            }
+        }, grainFor(_ny * words));
+
+        parallelFor(_ny, [&](size_t y) {
+            for (size_t x = 0; x < _nx; ++x) {
+                update(x, y, x > 0 ? outside.row(x - 1, y) : nullptr);
+            }
+            for (size_t x = _nx; x-- > 0;) {
+                update(x, y, x + 1 < _nx ? outside.row(x + 1, y) : nullptr);
+            }
+        }, grainFor(_nx * words));
+    } while (changed.load(std::memory_order_relaxed));
+
+    return outside;
+}
+
+size_t BitVolume::fillInterior() {
+    if (_words.empty()) {
+        return 0;
+    }
+    const size_t before = count();
+    const BitVolume outside = exterior();
+    const size_t words = _wordsPerRow;
+    const uint64_t lastMask = lastWordMask();
+    parallelFor(_nx * _ny, [&](size_t r) {
+        for (size_t w = 0; w < words; ++w) {
+            _words[r * words + w] = ~outside._words[r * words + w];
+        }
+        _words[r * words + words - 1] &= lastMask;
+    }, grainFor(words));
+    return count() - before;
+}
+
+} // namespace mesh
@@ -0,0 +1,345 @@
+//
+//  VoxelSurface.cpp
+//  3D
+//
+//  Marching cubes case table built from PoissonRecon's marching squares
+//  table, and the slab-parallel extractor
+//
+
+#include "VoxelSurface.hpp"
+#include "Parallel.hpp"
+#include "MarchingCubes.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace mesh {
+
+namespace {
+
+// ============================================================
+// Case Table
+// ============================================================
+
+// Cube corner c sits at (c & 1, (c >> 1) & 1, (c >> 2) & 1). Cube edge
+// axis * 4 + a + 2 * b runs along `axis` from the corner whose other two
+// coordinates, in ascending axis order, are (a, b)
+constexpr int MaxCaseTriangles = 12;
+
+struct CaseTable {
+    uint8_t triangleCount[256];
+    int8_t edges[256][MaxCaseTriangles * 3];
+};
+
+inline int cubeEdge(int axis, const int coords[3]) {
+    const int first = axis == 0 ? 1 : 0;
+    const int second = axis == 2 ? 1 : 2;
+    return axis * 4 + coords[first] + 2 * coords[second];
+}
+
+/// Whether two cube edges lie on a common cube face
+inline bool shareFace(int a, int b) {
+    auto faces = [](int edge) {
+        const int axis = edge / 4;
+        const int first = axis == 0 ? 1 : 0;
+        const int second = axis == 2 ? 1 : 2;
+        // Face bits: axis * 2 + side
+        return (1 << (first * 2 + (edge & 1))) | (1 << (second * 2 + ((edge >> 1) & 1)));
+    };
+    return (faces(a) & faces(b)) != 0;
+}
+
+/// Split an iso-polygon into triangles by clipping ears, never cutting a
+/// diagonal between two vertices on one cube face: such a chord lies in the
+/// face and the neighboring cell could cut it too, leaving a non-manifold edge
+bool triangulateLoop(const int* loop, int length, int8_t* out) {
+    if (length == 3) {
+        for (int i = 0; i < 3; ++i) {
+            out[i] = static_cast<int8_t>(loop[i]);
+        }
+        return true;
+    }
+    for (int i = 0; i < length; ++i) {
+        const int prev = loop[(i + length - 1) % length];
+        const int next = loop[(i + 1) % length];
+        if (shareFace(prev, next)) continue;
+
+        int rest[12];
+        int count = 0;
+        for (int j = 0; j < length; ++j) {
+            if (j != i) rest[count++] = loop[j];
+        }
+        if (triangulateLoop(rest, count, out + 3)) {
+            out[0] = static_cast<int8_t>(prev);
+            out[1] = static_cast<int8_t>(loop[i]);
+            out[2] = static_cast<int8_t>(next);
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Every case's iso-polygons: marching squares on the six faces gives
+/// segments with the set side to their right, which chain into loops
+/// around the cube that are fanned into triangles. Neighboring cubes see
+/// identical faces, so ambiguous faces resolve the same way on both sides
+/// and the surface stays closed
+CaseTable buildCaseTable() {
+    using Squares = PoissonRecon::HyperCube::MarchingSquares;
+
+    CaseTable table = {};
+    for (int mcCase = 0; mcCase < 256; ++mcCase) {
+        int next[12];
+        std::fill(next, next + 12, -1);
+
+        for (int face = 0; face < 6; ++face) {
+            const int axis = face / 2;
+            const int side = face % 2;
+            const int u = axis == 0 ? 1 : 0;
+            const int v = axis == 2 ? 1 : 2;
+
+            // Square corner q = (q & 1, q >> 1) along (u, v)
+            unsigned char squareCase = 0;
+            for (int q = 0; q < 4; ++q) {
+                int coords[3];
+                coords[axis] = side;
+                coords[u] = q & 1;
+                coords[v] = q >> 1;
+                const int corner = coords[0] | (coords[1] << 1) | (coords[2] << 2);
+                squareCase |= static_cast<unsigned char>(((mcCase >> corner) & 1) << q);
+            }
+
+            // Square edges: 0 = v0 along u, 1 = u0 along v, 2 = u1 along v, 3 = v1 along u
+            int squareEdge[4];
+            for (int e = 0; e < 4; ++e) {
+                int coords[3];
+                coords[axis] = side;
+                coords[u] = e == 2 ? 1 : 0;
+                coords[v] = e == 3 ? 1 : 0;
+                squareEdge[e] = cubeEdge(e == 0 || e == 3 ? u : v, coords);
+            }
+
+            // The table looks down -(u x v); flip where that is not the outward view
+            const bool uvOutward = (axis == 1) == (side == 0);
+            int segments[2 * Squares::MAX_EDGES];
+            const int count = Squares::AddEdgeIndices(squareCase, segments);
+            for (int s = 0; s < count; ++s) {
+                int from = squareEdge[segments[2 * s]];
+                int to = squareEdge[segments[2 * s + 1]];
+                if (!uvOutward) {
+                    std::swap(from, to);
+                }
+                next[from] = to;
+            }
+        }
+
+        // Triangulate each loop, keeping its winding (triangles face the clear side)
+        int triangles = 0;
+        bool visited[12] = {};
+        for (int start = 0; start < 12; ++start) {
+            if (next[start] < 0 || visited[start]) continue;
+            int loop[12];
+            int length = 0;
+            for (int e = start; !visited[e]; e = next[e]) {
+                visited[e] = true;
+                loop[length++] = e;
+            }
+            if (!triangulateLoop(loop, length, table.edges[mcCase] + 3 * triangles)) {
+                throw std::logic_error("Marching cubes loop has no valid triangulation");
+            }
+            triangles += length - 2;
+        }
+        table.triangleCount[mcCase] = static_cast<uint8_t>(triangles);
+    }
+    return table;
+}
+
+const CaseTable& caseTable() {
+    static const CaseTable table = buildCaseTable();
+    return table;
+}
+
+// ============================================================
+// Edge Crossings
+// ============================================================
+
+/// Bits of z edges (z, z + 1) in a row whose voxels differ; the edge to
+/// the last voxel's +z side is not part of the volume
+inline uint64_t zCrossings(const uint64_t* row, size_t w, size_t words, uint64_t lastEdgeMask) {
+    const uint64_t above = w + 1 < words ? row[w + 1] << 63 : 0;
+    const uint64_t crossing = row[w] ^ ((row[w] >> 1) | above);
+    return w + 1 < words ? crossing : crossing & lastEdgeMask;
+}
+
+/// Vertex numbering: all x-edge vertices row by row, then y, then z;
+/// within a row, by z
+struct EdgeIndex {
+    const BitVolume& volume;
+    uint64_t lastEdgeMask;
+    std::vector<uint32_t> rowStart[3];   // Per axis, first vertex of each (x, y) row
+
+    uint64_t crossings(int axis, size_t x, size_t y, size_t w) const {
+        const uint64_t* row = volume.row(x, y);
+        switch (axis) {
+        case 0:  return x + 1 < volume.nx() ? row[w] ^ volume.row(x + 1, y)[w] : 0;
+        case 1:  return y + 1 < volume.ny() ? row[w] ^ volume.row(x, y + 1)[w] : 0;
+        default: return zCrossings(row, w, volume.wordsPerRow(), lastEdgeMask);
+        }
+    }
+
+    uint32_t vertex(int axis, size_t x, size_t y, size_t z) const {
+        uint32_t index = rowStart[axis][x * volume.ny() + y];
+        const size_t word = z / 64;
+        for (size_t w = 0; w < word; ++w) {
+            index += static_cast<uint32_t>(__builtin_popcountll(crossings(axis, x, y, w)));
+        }
+        const uint64_t below = (uint64_t(1) << (z % 64)) - 1;
+        return index + static_cast<uint32_t>(__builtin_popcountll(crossings(axis, x, y, word) & below));
+    }
+};
+
+} // namespace
+
+const int8_t* marchingCubesTriangles(unsigned mcCase, int& triangleCount) {
+    const CaseTable& table = caseTable();
+    triangleCount = table.triangleCount[mcCase & 0xFF];
+    return table.edges[mcCase & 0xFF];
+}
+
+// ============================================================
+// Extraction
+// ============================================================
+
+MeshData extractVoxelSurface(const BitVolume& volume, float voxelSize, const Point3D& origin) {
+    MeshData mesh;
+    const size_t nx = volume.nx();
+    const size_t ny = volume.ny();
+    const size_t nz = volume.nz();
+    if (nx < 2 || ny < 2 || nz < 2) {
+        return mesh;
+    }
+
+    const size_t words = volume.wordsPerRow();
+    const size_t rows = nx * ny;
+    const CaseTable& table = caseTable();
+
+    // Edges and cells exist for z < nz - 1; that never fills the last word
+    const size_t lastWordEdges = nz - 1 - 64 * (words - 1);
+    EdgeIndex edges{volume, (uint64_t(1) << lastWordEdges) - 1, {}};
+
+    // Pass 1: crossings per row and axis, scanned into vertex numbers
+    for (int axis = 0; axis < 3; ++axis) {
+        edges.rowStart[axis].resize(rows);
+    }
+    parallelFor(rows, [&](size_t r) {
+        const size_t x = r / ny;
+        const size_t y = r % ny;
+        for (int axis = 0; axis < 3; ++axis) {
+            uint32_t count = 0;
+            for (size_t w = 0; w < words; ++w) {
+                count += static_cast<uint32_t>(__builtin_popcountll(edges.crossings(axis, x, y, w)));
+            }
+            edges.rowStart[axis][r] = count;
+        }
+    }, 256);
+
+    uint64_t vertexCount = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (uint32_t& start : edges.rowStart[axis]) {
+            const uint32_t count = start;
+            start = static_cast<uint32_t>(vertexCount);
+            vertexCount += count;
+        }
+    }
+    if (vertexCount > 0xFFFFFFFFull) {
+        throw std::length_error("Voxel surface exceeds 32-bit vertex indices");
+    }
+
+    // Pass 2: vertices at edge midpoints
+    mesh.vertices.resize(static_cast<size_t>(vertexCount) * 3);
+    float* positions = mesh.vertices.data();
+    parallelFor(rows, [&](size_t r) {
+        const size_t x = r / ny;
+        const size_t y = r % ny;
+        for (int axis = 0; axis < 3; ++axis) {
+            uint32_t index = edges.rowStart[axis][r];
+            for (size_t w = 0; w < words; ++w) {
+                for (uint64_t bits = edges.crossings(axis, x, y, w); bits != 0; bits &= bits - 1) {
+                    const size_t z = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                    float* p = positions + size_t(index++) * 3;
+                    p[0] = origin.x + (static_cast<float>(x) + (axis == 0 ? 1.0f : 0.5f)) * voxelSize;
+                    p[1] = origin.y + (static_cast<float>(y) + (axis == 1 ? 1.0f : 0.5f)) * voxelSize;
+                    p[2] = origin.z + (static_cast<float>(z) + (axis == 2 ? 1.0f : 0.5f)) * voxelSize;
+                }
+            }
+        }
+    }, 256);
+
+    // Cells in slab x whose eight voxels are not all equal, one row at a time
+    auto forEachCell = [&](size_t x, auto&& fn) {
+        for (size_t y = 0; y + 1 < ny; ++y) {
+            const uint64_t* corners[4] = {volume.row(x, y), volume.row(x + 1, y),
+                                          volume.row(x, y + 1), volume.row(x + 1, y + 1)};
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t any = 0;
+                uint64_t all = ~uint64_t(0);
+                for (const uint64_t* row : corners) {
+                    const uint64_t shifted = (row[w] >> 1) | (w + 1 < words ? row[w + 1] << 63 : 0);
+                    any |= row[w] | shifted;
+                    all &= row[w] & shifted;
+                }
+                uint64_t active = any & ~all;
+                if (w + 1 == words) {
+                    active &= edges.lastEdgeMask;
+                }
+                for (; active != 0; active &= active - 1) {
+                    const size_t z = w * 64 + static_cast<size_t>(__builtin_ctzll(active));
+                    unsigned mcCase = 0;
+                    for (unsigned c = 0; c < 8; ++c) {
+                        const size_t cz = z + (c >> 2);
+                        mcCase |= static_cast<unsigned>((corners[c & 3][cz / 64] >> (cz % 64)) & 1) << c;
+                    }
+                    fn(y, z, mcCase);
+                }
+            }
+        }
+    };
+
+    // Pass 3: triangles per slab, scanned into output offsets
+    std::vector<size_t> slabStart(nx);
+    parallelFor(nx - 1, [&](size_t x) {
+        size_t count = 0;
+        forEachCell(x, [&](size_t, size_t, unsigned mcCase) {
+            count += table.triangleCount[mcCase];
+        });
+        slabStart[x] = count;
+    }, 1);
+    size_t triangleCount = 0;
+    for (size_t& start : slabStart) {
+        const size_t count = start;
+        start = triangleCount;
+        triangleCount += count;
+    }
+
+    // Pass 4: emit triangles, looking up each edge's vertex by rank
+    mesh.indices.resize(triangleCount * 3);
+    uint32_t* indices = mesh.indices.data();
+    parallelFor(nx - 1, [&](size_t x) {
+        uint32_t* out = indices + slabStart[x] * 3;
+        forEachCell(x, [&](size_t y, size_t z, unsigned mcCase) {
+            const int8_t* caseEdges = table.edges[mcCase];
+            for (int i = 0; i < 3 * table.triangleCount[mcCase]; ++i) {
+                const int axis = caseEdges[i] / 4;
+                const int a = caseEdges[i] & 1;
+                const int b = (caseEdges[i] >> 1) & 1;
+                const size_t ex = x + (axis == 0 ? 0 : a);
+                const size_t ey = y + (axis == 1 ? 0 : (axis == 0 ? a : b));
+                const size_t ez = z + (axis == 2 ? 0 : b);
+                *out++ = edges.vertex(axis, ex, ey, ez);
+            }
+        });
+    }, 1);
+
+    return mesh;
+}
+
+} // namespace mesh
@@ -0,0 +1,31 @@
+//
+//  VoxelSurface.hpp
+//  3D
+//
+//  Marching cubes over a bit-packed occupancy volume
+//  Cells span eight neighboring voxel centers; each grid edge whose two
+//  voxels differ carries one shared vertex at its midpoint, numbered by bit
+//  rank within its row, so slabs of cells are triangulated in parallel into
+//  one indexed mesh without a vertex hash
+//
+
+#pragma once
+#include "MeshTypes.hpp"
+#include "VoxelMorphology.hpp"
+
+namespace mesh {
+
+/// Closed, consistently outward-facing iso-surface between set and clear
+/// voxels. Voxel (i, j, k) is centered at origin + (i + 0.5, j + 0.5, k + 0.5)
+/// * voxelSize. Voxels on the volume border should be clear: cells beyond
+/// the border are not visited, so a shape touching it is left open there
+MeshData extractVoxelSurface(const BitVolume& volume, float voxelSize, const Point3D& origin);
+
+/// Marching cubes triangles of one cube case, three cube edges each. Bit c
+/// of `mcCase` is set when corner c, at (c & 1, (c >> 1) & 1, (c >> 2) & 1),
+/// is inside; edge axis * 4 + a + 2 * b runs along `axis` from the corner
+/// whose other two coordinates, in ascending axis order, are (a, b).
+/// Triangles face the outside
+const int8_t* marchingCubesTriangles(unsigned mcCase, int& triangleCount);
+
+} // namespace mesh
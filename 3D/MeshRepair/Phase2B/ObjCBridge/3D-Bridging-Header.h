@@ -12,5 +12,12 @@
 // Phase 2B: Poisson + MeshFix Bridges
 #import "PoissonBridge.h"
 #import "MeshFixBridge.h"
+#import "PointCloudBridge.h"
+#import "DepthFrameBridge.h"
+#import "TsdfBridge.h"
+#import "VoxelBridge.h"
+#import "SmoothingBridge.h"
+#import "SimplificationBridge.h"
+#import "ClusteringBridge.h"
 
 #endif /* _D_Bridging_Header_h */
@@ -0,0 +1,59 @@
+//
+//  ClusteringBridge.h
+//  3D
+//
+//  Objective-C bridge for grid vertex clustering simplification
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result structure for vertex clustering (C-compatible)
+typedef struct {
+    float* _Nullable vertices;      // Flat array: [x0,y0,z0, x1,y1,z1, ...]
+    uint32_t* _Nullable indices;    // Triangle indices: [i0,i1,i2, ...]
+    NSUInteger vertexCount;
+    NSUInteger indexCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+    NSUInteger occupiedCells;       // Appended last: Swift reads the fields above by offset
+    NSUInteger centroidCells;       // Cells placed at their vertex mean instead of the quadric optimum
+    NSUInteger duplicateTriangles;  // Remapped copies of the same triangle merged
+} ClusterResult;
+
+/// Configuration for vertex clustering
+typedef struct {
+    NSUInteger gridResolution;      // Cells along the longest bounding box axis (0 = 32)
+    float cellSize;                 // Cell edge length in model units; overrides gridResolution when > 0
+    NSUInteger minClusterSize;      // Drop triangles touching cells with fewer vertices (0 or 1 = keep all)
+    bool centroidPositions;         // Vertex mean per cell instead of the quadric optimum (faster, rounds edges)
+    NSUInteger maxCells;            // PLY streaming: fail past this many grid cells (0 = no limit)
+} ClusterConfig;
+
+/// Objective-C++ Bridge for vertex clustering
+@interface ClusteringBridge : NSObject
+
+/// Cluster an indexed triangle mesh on a uniform grid (stride in bytes
+/// between vertex positions, e.g. 12 for packed float3, 16 for
+/// SIMD3<Float>). Returns a compact indexed mesh with positions only
++ (ClusterResult* _Nullable)clusterVertices:(const float* _Nonnull)vertices
+                                vertexCount:(NSUInteger)vertexCount
+                                     stride:(NSUInteger)stride
+                                    indices:(const uint32_t* _Nonnull)indices
+                                 indexCount:(NSUInteger)indexCount
+                                     config:(ClusterConfig)config;
+
+/// Cluster the mesh in a PLY file without loading it: faces are streamed
+/// and only per-cell state plus 16 bytes per input vertex is kept. For
+/// meshes too large to hold in memory
++ (ClusterResult* _Nullable)clusterPlyFile:(NSString* _Nonnull)path
+                                    config:(ClusterConfig)config;
+
+/// Clean up malloc'd memory from ClusterResult
++ (void)cleanupResult:(ClusterResult* _Nonnull)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,112 @@
+//
+//  ClusteringBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ vertex clustering
+//
+
+#import "ClusteringBridge.h"
+#include "MeshClustering.hpp"
+
+static mesh::ClusterParams clusterParams(const ClusterConfig& config) {
+    mesh::ClusterParams params;
+    if (config.gridResolution > 0) {
+        params.gridResolution = static_cast<uint32_t>(config.gridResolution);
+    }
+    params.cellSize = config.cellSize;
+    params.minClusterSize = static_cast<uint32_t>(config.minClusterSize);
+    params.quadricPositions = !config.centroidPositions;
+    params.maxCells = config.maxCells;
+    return params;
+}
+
+static void fillResult(ClusterResult* result, mesh::MeshData& meshData, const mesh::ClusterStats& stats) {
+    // Hand the malloc'd buffers straight to the caller (no copy)
+    result->vertexCount = meshData.vertexCount();
+    result->indexCount = meshData.indices.size();
+    result->vertices = meshData.vertices.release();
+    result->indices = meshData.indices.release();
+
+    result->occupiedCells = stats.occupiedCells;
+    result->centroidCells = stats.centroidCells;
+    result->duplicateTriangles = stats.duplicateTriangles;
+
+    result->success = true;
+    result->errorMessage = nil;
+}
+
+@implementation ClusteringBridge
+
++ (ClusterResult*)clusterVertices:(const float*)vertices
+                      vertexCount:(NSUInteger)vertexCount
+                           stride:(NSUInteger)stride
+                          indices:(const uint32_t*)indices
+                       indexCount:(NSUInteger)indexCount
+                           config:(ClusterConfig)config {
+
+    @autoreleasepool {
+        // Allocate result structure
+        ClusterResult* result = (ClusterResult*)malloc(sizeof(ClusterResult));
+        memset(result, 0, sizeof(ClusterResult));
+
+        try {
+            // Packed copy of the positions
+            mesh::MallocBuffer<float> positions(vertexCount * 3);
+            for (NSUInteger i = 0; i < vertexCount; ++i) {
+                const float* p = reinterpret_cast<const float*>(
+                    reinterpret_cast<const unsigned char*>(vertices) + i * stride);
+                positions[i * 3] = p[0];
+                positions[i * 3 + 1] = p[1];
+                positions[i * 3 + 2] = p[2];
+            }
+
+            mesh::ClusterStats stats;
+            mesh::MeshData meshData = mesh::simplifyVertexClustering(positions.data(), vertexCount,
+                                                                     indices, indexCount,
+                                                                     clusterParams(config), &stats);
+            fillResult(result, meshData, stats);
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (ClusterResult*)clusterPlyFile:(NSString*)path
+                          config:(ClusterConfig)config {
+
+    @autoreleasepool {
+        ClusterResult* result = (ClusterResult*)malloc(sizeof(ClusterResult));
+        memset(result, 0, sizeof(ClusterResult));
+
+        try {
+            mesh::ClusterStats stats;
+            mesh::MeshData meshData = mesh::simplifyVertexClusteringPly(std::string(path.fileSystemRepresentation),
+                                                                        clusterParams(config), &stats);
+            fillResult(result, meshData, stats);
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupResult:(ClusterResult*)result {
+    if (result->vertices) {
+        free(result->vertices);
+        result->vertices = nullptr;
+    }
+    if (result->indices) {
+        free(result->indices);
+        result->indices = nullptr;
+    }
+    free(result);
+}
+
+@end
@@ -0,0 +1,57 @@
+//
+//  DepthFrameBridge.h
+//  3D
+//
+//  Objective-C bridge for LiDAR depth-frame ingestion
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+#import <simd/simd.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// View of one unprojected frame held by a DepthFrameBridge (C-compatible)
+/// The buffers belong to the bridge and stay valid until that ring slot is
+/// overwritten by a later ingest
+typedef struct {
+    const float* _Nullable points;          // 4 floats per point (SIMD3<Float> layout), world space
+    const float* _Nullable normals;         // Same layout, unit length, facing the camera
+    const float* _Nullable confidence;      // ARConfidenceLevel / 2, in [0, 1]
+    NSUInteger pointCount;
+    simd_float3 viewpoint;                  // Camera position the frame was captured from
+    double timestamp;
+} DepthFrameView;
+
+/// Objective-C++ Bridge owning a ring of preallocated depth-frame buffers
+/// Not thread-safe; ingest and read frames from one queue
+@interface DepthFrameBridge : NSObject
+
+/// Ring holding the `capacity` most recent frames
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/// Unproject a Float32 depth map (meters) into world space, keeping pixels
+/// whose UInt8 confidence is at least `minConfidence`
+/// `intrinsics` must be in depth-map pixels and `pose` is camera-to-world
+/// (ARCamera.transform); every `step`-th pixel is sampled, 1 for full resolution
+- (BOOL)ingestDepth:(const float* _Nonnull)depth
+      depthRowBytes:(NSUInteger)depthRowBytes
+         confidence:(const uint8_t* _Nullable)confidence
+ confidenceRowBytes:(NSUInteger)confidenceRowBytes
+              width:(NSUInteger)width
+             height:(NSUInteger)height
+         intrinsics:(simd_float3x3)intrinsics
+               pose:(simd_float4x4)pose
+      minConfidence:(uint8_t)minConfidence
+               step:(NSUInteger)step
+          timestamp:(NSTimeInterval)timestamp;
+
+/// Frames currently held, at most the ring capacity
+@property (nonatomic, readonly) NSUInteger frameCount;
+
+/// Frame by age (0 = most recent); an empty view when out of range
+- (DepthFrameView)frameAtAge:(NSUInteger)age;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,81 @@
+//
+//  DepthFrameBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ depth-frame ring
+//
+
+#import "DepthFrameBridge.h"
+#include "DepthUnprojection.hpp"
+#include <memory>
+
+@implementation DepthFrameBridge {
+    std::unique_ptr<mesh::DepthFrameRing> _ring;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        _ring = std::make_unique<mesh::DepthFrameRing>(MAX(capacity, (NSUInteger)1));
+    }
+    return self;
+}
+
+- (BOOL)ingestDepth:(const float*)depth
+      depthRowBytes:(NSUInteger)depthRowBytes
+         confidence:(const uint8_t*)confidence
+ confidenceRowBytes:(NSUInteger)confidenceRowBytes
+              width:(NSUInteger)width
+             height:(NSUInteger)height
+         intrinsics:(simd_float3x3)intrinsics
+               pose:(simd_float4x4)pose
+      minConfidence:(uint8_t)minConfidence
+               step:(NSUInteger)step
+          timestamp:(NSTimeInterval)timestamp {
+
+    try {
+        mesh::DepthUnprojectionParams params;
+        params.intrinsics.fx = intrinsics.columns[0][0];
+        params.intrinsics.fy = intrinsics.columns[1][1];
+        params.intrinsics.cx = intrinsics.columns[2][0];
+        params.intrinsics.cy = intrinsics.columns[2][1];
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                params.pose[c * 4 + r] = pose.columns[c][r];
+            }
+        }
+        params.minConfidence = minConfidence;
+        params.step = step;
+
+        _ring->ingest(depth, depthRowBytes, confidence, confidenceRowBytes,
+                      width, height, params, timestamp);
+        return YES;
+
+    } catch (const std::exception& e) {
+        NSLog(@"DepthFrameBridge ingest failed: %s", e.what());
+        return NO;
+    }
+}
+
+- (NSUInteger)frameCount {
+    return _ring->size();
+}
+
+- (DepthFrameView)frameAtAge:(NSUInteger)age {
+    DepthFrameView view;
+    memset(&view, 0, sizeof(DepthFrameView));
+    if (age >= _ring->size()) {
+        return view;
+    }
+
+    const mesh::DepthFrame& frame = _ring->frame(age);
+    view.points = frame.points.data();
+    view.normals = frame.normals.data();
+    view.confidence = frame.confidence.data();
+    view.pointCount = frame.pointCount;
+    view.viewpoint = simd_make_float3(frame.viewpoint[0], frame.viewpoint[1], frame.viewpoint[2]);
+    view.timestamp = frame.timestamp;
+    return view;
+}
+
+@end
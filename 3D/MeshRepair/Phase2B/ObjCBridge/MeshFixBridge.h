@@ -10,6 +10,27 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// Per-run repair statistics (C-compatible mirror of RepairReport)
+typedef struct {
+    double edgeTableMs;             // Wall time per stage (milliseconds)
+    double nonManifoldMs;
+    double holeDetectionMs;
+    double holeFillingMs;
+    double componentsMs;
+    double vertexCompactionMs;
+    double totalMs;
+    NSUInteger inputTriangles;
+    NSUInteger outputTriangles;
+    NSUInteger nonManifoldTrianglesRemoved;
+    NSUInteger componentTrianglesRemoved;
+    NSUInteger fillTrianglesAdded;
+    NSUInteger verticesRemoved;
+    NSUInteger holesFound;
+    NSUInteger holesFilled;
+    NSUInteger componentsDropped;
+    NSUInteger peakBytes;           // Peak bytes of tracked repair buffers
+} MeshFixReport;
+
 /// Result structure for MeshFix repair (C-compatible)
 typedef struct {
     float* _Nullable vertices;      // Flat array: [x0,y0,z0, x1,y1,z1, ...]
@@ -19,6 +40,7 @@ typedef struct {
     int holesFilledCount;
     bool success;
     NSString* _Nullable errorMessage;
+    MeshFixReport report;           // Appended last: Swift reads the fields above by offset
 } MeshFixResult;
 
 /// Configuration for MeshFix
@@ -37,17 +37,9 @@
             // Convert to C++ mesh data
             mesh::MeshData input;
 
-            // Copy vertices
-            input.vertices.reserve(vertexCount * 3);
-            for (NSUInteger i = 0; i < vertexCount * 3; ++i) {
-                input.vertices.push_back(vertices[i]);
-            }
-
-            // Copy indices
-            input.indices.reserve(indexCount);
-            for (NSUInteger i = 0; i < indexCount; ++i) {
-                input.indices.push_back(indices[i]);
-            }
+            // Copy vertices and indices (single memcpy each)
+            input.vertices.assign(vertices, vertices + vertexCount * 3);
+            input.indices.assign(indices, indices + indexCount);
 
             // Create C++ wrapper and config
             mesh::MeshFixWrapper wrapper;
@@ -59,24 +51,34 @@
             cppConfig.verbose = config.verbose;
 
             // Call C++ repair
-            auto meshData = wrapper.repair(input, cppConfig);
+            mesh::MeshFixWrapper::RepairReport report;
+            auto meshData = wrapper.repair(input, cppConfig, report);
 
-            // Copy results to malloc'd buffers
+            // Hand the malloc'd buffers straight to the caller (no copy)
             result->vertexCount = meshData.vertexCount();
             result->indexCount = meshData.indices.size();
-
-            if (!meshData.vertices.empty()) {
-                result->vertices = (float*)malloc(meshData.vertices.size() * sizeof(float));
-                memcpy(result->vertices, meshData.vertices.data(), meshData.vertices.size() * sizeof(float));
-            }
-
-            if (!meshData.indices.empty()) {
-                result->indices = (uint32_t*)malloc(meshData.indices.size() * sizeof(uint32_t));
-                memcpy(result->indices, meshData.indices.data(), meshData.indices.size() * sizeof(uint32_t));
-            }
-
-            // Estimate holes filled (rough approximation)
-            result->holesFilledCount = 0; // TODO: Track in MeshFixWrapper
+            result->vertices = meshData.vertices.release();
+            result->indices = meshData.indices.release();
+
+            result->holesFilledCount = report.holesFilled;
+
+            result->report.edgeTableMs = report.edgeTableMs;
+            result->report.nonManifoldMs = report.nonManifoldMs;
+            result->report.holeDetectionMs = report.holeDetectionMs;
+            result->report.holeFillingMs = report.holeFillingMs;
+            result->report.componentsMs = report.componentsMs;
+            result->report.vertexCompactionMs = report.vertexCompactionMs;
+            result->report.totalMs = report.totalMs;
+            result->report.inputTriangles = report.inputTriangles;
+            result->report.outputTriangles = report.outputTriangles;
+            result->report.nonManifoldTrianglesRemoved = report.nonManifoldTrianglesRemoved;
+            result->report.componentTrianglesRemoved = report.componentTrianglesRemoved;
+            result->report.fillTrianglesAdded = report.fillTrianglesAdded;
+            result->report.verticesRemoved = report.verticesRemoved;
+            result->report.holesFound = report.holesFound;
+            result->report.holesFilled = report.holesFilled;
+            result->report.componentsDropped = report.componentsDropped;
+            result->report.peakBytes = report.peakBytes;
 
             result->success = true;
             result->errorMessage = nil;
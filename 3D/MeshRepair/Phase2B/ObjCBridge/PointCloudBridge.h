@@ -0,0 +1,68 @@
+//
+//  PointCloudBridge.h
+//  3D
+//
+//  Objective-C bridge for point cloud processing (k-NN search, normals)
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result structure for k-nearest-neighbor search (C-compatible)
+/// Row i of the arrays holds the k neighbors of point i, nearest first
+typedef struct {
+    uint32_t* _Nullable neighbors;          // Flat array: pointCount * k indices
+    float* _Nullable distancesSquared;      // Flat array: pointCount * k squared distances
+    NSUInteger pointCount;
+    NSUInteger k;                           // Neighbors per point (clamped to pointCount - 1)
+    bool success;
+    NSString* _Nullable errorMessage;
+} KNNResult;
+
+/// Result structure for PCA normal estimation (C-compatible)
+typedef struct {
+    float* _Nullable normals;               // Flat array: [nx0,ny0,nz0, ...], unit length, oriented
+    float* _Nullable confidence;            // Per-point planarity in [0, 1] (1 = perfectly planar)
+    NSUInteger pointCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+} NormalEstimationResult;
+
+/// Objective-C++ Bridge for point cloud processing
+@interface PointCloudBridge : NSObject
+
+/// k nearest neighbors of every point, excluding the point itself
+/// (stride in bytes, e.g. 16 for SIMD3<Float> arrays)
++ (KNNResult* _Nullable)nearestNeighborsWithPoints:(const float* _Nonnull)points
+                                        pointCount:(NSUInteger)count
+                                            stride:(NSUInteger)stride
+                                                 k:(NSUInteger)k;
+
+/// Clean up malloc'd memory from KNNResult
++ (void)cleanupKNNResult:(KNNResult* _Nonnull)result;
+
+/// PCA normals of every point from its k nearest neighbors, consistently
+/// oriented by minimum-spanning-tree propagation
+/// (stride in bytes, e.g. 16 for SIMD3<Float> arrays)
++ (NormalEstimationResult* _Nullable)estimateNormalsWithPoints:(const float* _Nonnull)points
+                                                    pointCount:(NSUInteger)count
+                                                        stride:(NSUInteger)stride
+                                                             k:(NSUInteger)k;
+
+/// As above, seeding the orientation of each connected patch from the
+/// sensor position each point was captured from (one per point)
++ (NormalEstimationResult* _Nullable)estimateNormalsWithPoints:(const float* _Nonnull)points
+                                                    pointCount:(NSUInteger)count
+                                                        stride:(NSUInteger)stride
+                                                             k:(NSUInteger)k
+                                                    viewpoints:(const float* _Nullable)viewpoints
+                                               viewpointStride:(NSUInteger)viewpointStride;
+
+/// Clean up malloc'd memory from NormalEstimationResult
++ (void)cleanupNormalResult:(NormalEstimationResult* _Nonnull)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
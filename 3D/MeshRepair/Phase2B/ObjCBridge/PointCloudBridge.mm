@@ -0,0 +1,126 @@
+//
+//  PointCloudBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ point cloud core
+//
+
+#import "PointCloudBridge.h"
+#include "KdTree.hpp"
+#include "NormalEstimation.hpp"
+
+@implementation PointCloudBridge
+
++ (KNNResult*)nearestNeighborsWithPoints:(const float*)points
+                              pointCount:(NSUInteger)count
+                                  stride:(NSUInteger)stride
+                                       k:(NSUInteger)k {
+
+    @autoreleasepool {
+        // Allocate result structure
+        KNNResult* result = (KNNResult*)malloc(sizeof(KNNResult));
+        memset(result, 0, sizeof(KNNResult));
+
+        try {
+            // Build the tree (coordinates are copied into tree order)
+            mesh::KdTree tree;
+            tree.build(points, count, stride);
+
+            // Query every point in parallel
+            mesh::NeighborGraph graph = tree.queryAll(k);
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->pointCount = count;
+            result->k = graph.k;
+            result->neighbors = graph.indices.release();
+            result->distancesSquared = graph.distancesSquared.release();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (NormalEstimationResult*)estimateNormalsWithPoints:(const float*)points
+                                          pointCount:(NSUInteger)count
+                                              stride:(NSUInteger)stride
+                                                   k:(NSUInteger)k {
+    return [self estimateNormalsWithPoints:points
+                                pointCount:count
+                                    stride:stride
+                                         k:k
+                                viewpoints:nullptr
+                           viewpointStride:3 * sizeof(float)];
+}
+
++ (NormalEstimationResult*)estimateNormalsWithPoints:(const float*)points
+                                          pointCount:(NSUInteger)count
+                                              stride:(NSUInteger)stride
+                                                   k:(NSUInteger)k
+                                          viewpoints:(const float*)viewpoints
+                                     viewpointStride:(NSUInteger)viewpointStride {
+
+    @autoreleasepool {
+        // Allocate result structure
+        NormalEstimationResult* result = (NormalEstimationResult*)malloc(sizeof(NormalEstimationResult));
+        memset(result, 0, sizeof(NormalEstimationResult));
+
+        try {
+            // Neighborhoods from the k-d tree, batch PCA, then orientation
+            mesh::KdTree tree;
+            tree.build(points, count, stride);
+            mesh::NeighborGraph graph = tree.queryAll(k);
+            mesh::NormalEstimate estimate = mesh::estimateNormals(points, count, stride, graph);
+            mesh::orientNormals(points, count, stride, graph, estimate.normals.data(),
+                                viewpoints, viewpointStride);
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->pointCount = count;
+            result->normals = estimate.normals.release();
+            result->confidence = estimate.confidence.release();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupKNNResult:(KNNResult*)result {
+    if (result->neighbors) {
+        free(result->neighbors);
+        result->neighbors = nullptr;
+    }
+    if (result->distancesSquared) {
+        free(result->distancesSquared);
+        result->distancesSquared = nullptr;
+    }
+    free(result);
+}
+
++ (void)cleanupNormalResult:(NormalEstimationResult*)result {
+    if (result->normals) {
+        free(result->normals);
+        result->normals = nullptr;
+    }
+    if (result->confidence) {
+        free(result->confidence);
+        result->confidence = nullptr;
+    }
+    free(result);
+}
+
+@end
@@ -29,6 +29,7 @@ typedef struct {
     bool enableDensityTrimming;     // Trim low-density regions
     float trimPercentage;           // Trim percentage
     bool verbose;                   // Print debug info
+    bool useNormalConfidence;       // Weight samples by normal length
 } PoissonConfig;
 
 /// Objective-C++ Bridge for Poisson Surface Reconstruction
@@ -40,6 +41,14 @@ typedef struct {
                                               pointCount:(NSUInteger)count
                                                   config:(PoissonConfig)config;
 
+/// Reconstruct surface from strided point/normal buffers without copying them
+/// (stride in bytes, e.g. 16 for SIMD3<Float> arrays)
++ (PoissonResult* _Nullable)reconstructSurfaceWithPoints:(const float* _Nonnull)points
+                                                 normals:(const float* _Nonnull)normals
+                                              pointCount:(NSUInteger)count
+                                                  stride:(NSUInteger)stride
+                                                  config:(PoissonConfig)config;
+
 /// Clean up malloc'd memory from PoissonResult
 + (void)cleanupResult:(PoissonResult* _Nonnull)result;
 
@@ -20,6 +20,7 @@
     config.enableDensityTrimming = true;
     config.trimPercentage = 0.05f;
     config.verbose = true;
+    config.useNormalConfidence = false;
     return config;
 }
 
@@ -27,6 +28,18 @@
                                        normals:(const float*)normals
                                     pointCount:(NSUInteger)count
                                         config:(PoissonConfig)config {
+    return [self reconstructSurfaceWithPoints:points
+                                      normals:normals
+                                   pointCount:count
+                                       stride:3 * sizeof(float)
+                                       config:config];
+}
+
++ (PoissonResult*)reconstructSurfaceWithPoints:(const float*)points
+                                       normals:(const float*)normals
+                                    pointCount:(NSUInteger)count
+                                        stride:(NSUInteger)stride
+                                        config:(PoissonConfig)config {
 
     @autoreleasepool {
         // Allocate result structure
@@ -34,26 +47,8 @@
         memset(result, 0, sizeof(PoissonResult));
 
         try {
-            // Convert to C++ types
-            mesh::OrientedPointCloud pointCloud;
-            pointCloud.points.reserve(count);
-            pointCloud.normals.reserve(count);
-
-            for (NSUInteger i = 0; i < count; ++i) {
-                mesh::Point3D point(
-                    points[i * 3 + 0],
-                    points[i * 3 + 1],
-                    points[i * 3 + 2]
-                );
-
-                mesh::Point3D normal(
-                    normals[i * 3 + 0],
-                    normals[i * 3 + 1],
-                    normals[i * 3 + 2]
-                );
-
-                pointCloud.addPoint(point, normal);
-            }
+            // View the caller's buffers in place (no copy)
+            mesh::OrientedPointView pointCloud(points, normals, count, stride, stride);
 
             // Create C++ wrapper and config
             mesh::PoissonWrapper wrapper;
@@ -64,28 +59,17 @@
             cppConfig.enableDensityTrimming = config.enableDensityTrimming;
             cppConfig.trimPercentage = config.trimPercentage;
             cppConfig.verbose = config.verbose;
+            cppConfig.useNormalConfidence = config.useNormalConfidence;
 
             // Call C++ reconstruction
             auto meshData = wrapper.reconstruct(pointCloud, cppConfig);
 
-            // Copy results to malloc'd buffers (ownership transfer to caller)
+            // Hand the malloc'd buffers straight to the caller (no copy)
             result->vertexCount = meshData.vertexCount();
             result->indexCount = meshData.indices.size();
-
-            if (!meshData.vertices.empty()) {
-                result->vertices = (float*)malloc(meshData.vertices.size() * sizeof(float));
-                memcpy(result->vertices, meshData.vertices.data(), meshData.vertices.size() * sizeof(float));
-            }
-
-            if (!meshData.indices.empty()) {
-                result->indices = (uint32_t*)malloc(meshData.indices.size() * sizeof(uint32_t));
-                memcpy(result->indices, meshData.indices.data(), meshData.indices.size() * sizeof(uint32_t));
-            }
-
-            if (!meshData.normals.empty()) {
-                result->normals = (float*)malloc(meshData.normals.size() * sizeof(float));
-                memcpy(result->normals, meshData.normals.data(), meshData.normals.size() * sizeof(float));
-            }
+            result->vertices = meshData.vertices.release();
+            result->indices = meshData.indices.release();
+            result->normals = meshData.normals.release();
 
             result->success = true;
             result->errorMessage = nil;
@@ -0,0 +1,91 @@
+//
+//  SimplificationBridge.h
+//  3D
+//
+//  Objective-C bridge for quadric error metric mesh simplification
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result structure for mesh simplification (C-compatible)
+typedef struct {
+    float* _Nullable vertices;      // Flat array: [x0,y0,z0, x1,y1,z1, ...]
+    uint32_t* _Nullable indices;    // Triangle indices: [i0,i1,i2, ...]
+    NSUInteger vertexCount;
+    NSUInteger indexCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+    NSUInteger collapses;           // Appended last: Swift reads the fields above by offset
+    NSUInteger rejectedCollapses;   // Blocked by the link condition or a face flip
+    double maxError;                // Largest quadric error of an applied collapse
+    NSUInteger rounds;              // Batched: parallel rounds that applied collapses
+} SimplifyResult;
+
+/// One level of an LOD chain: a range of the shared index buffer
+typedef struct {
+    NSUInteger indexOffset;
+    NSUInteger indexCount;
+    NSUInteger vertexCount;         // Distinct vertices the level references
+    double maxError;                // Largest quadric error of the collapses up to this level
+} LodLevelInfo;
+
+/// Result structure for LOD chain generation (C-compatible)
+typedef struct {
+    float* _Nullable vertices;      // Shared by all levels, finest level first
+    uint32_t* _Nullable indices;    // Triangle indices of every level, back to back
+    NSUInteger vertexCount;
+    NSUInteger indexCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+    NSUInteger levelCount;          // Appended last: Swift reads the fields above by offset
+    LodLevelInfo* _Nullable levels;
+    NSUInteger collapses;
+} LodChainResult;
+
+/// Configuration for mesh simplification
+typedef struct {
+    NSUInteger targetTriangleCount; // Stop at or below this many triangles (0 = no limit)
+    NSUInteger targetVertexCount;   // Stop at or below this many vertices (0 = no limit)
+    float boundaryWeight;           // Hold open boundaries in place (10 typical, 0 = free)
+    bool batched;                   // Collapse independent edges in parallel rounds (not strictly cheapest first)
+    float batchFraction;            // Batched: share of live vertices offered per round (0 = default 0.02)
+} SimplifyConfig;
+
+/// Objective-C++ Bridge for mesh simplification
+@interface SimplificationBridge : NSObject
+
+/// Decimate an indexed triangle mesh by quadric edge collapses (stride in
+/// bytes between vertex positions, e.g. 12 for packed float3, 16 for
+/// SIMD3<Float>). Returns a compact indexed mesh with positions only
++ (SimplifyResult* _Nullable)simplifyVertices:(const float* _Nonnull)vertices
+                                  vertexCount:(NSUInteger)vertexCount
+                                       stride:(NSUInteger)stride
+                                      indices:(const uint32_t* _Nonnull)indices
+                                   indexCount:(NSUInteger)indexCount
+                                       config:(SimplifyConfig)config;
+
+/// Run one collapse sequence through triangle counts `ratios` (fractions of
+/// the input, non-increasing, in (0, 1], e.g. 1, 0.5, 0.25, 0.1) and keep a
+/// level at each. All levels index the returned vertex buffer; targets in
+/// `config` are ignored
++ (LodChainResult* _Nullable)simplifyChainVertices:(const float* _Nonnull)vertices
+                                       vertexCount:(NSUInteger)vertexCount
+                                            stride:(NSUInteger)stride
+                                           indices:(const uint32_t* _Nonnull)indices
+                                        indexCount:(NSUInteger)indexCount
+                                            ratios:(const float* _Nonnull)ratios
+                                        ratioCount:(NSUInteger)ratioCount
+                                            config:(SimplifyConfig)config;
+
+/// Clean up malloc'd memory from SimplifyResult
++ (void)cleanupResult:(SimplifyResult* _Nonnull)result;
+
+/// Clean up malloc'd memory from LodChainResult
++ (void)cleanupChainResult:(LodChainResult* _Nonnull)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+//
+//  SimplificationBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ mesh simplifier
+//
+
+#import "SimplificationBridge.h"
+#include "MeshSimplification.hpp"
+
+/// Packed copy of the positions
+static mesh::MallocBuffer<float> packPositions(const float* vertices, NSUInteger vertexCount, NSUInteger stride) {
+    mesh::MallocBuffer<float> positions(vertexCount * 3);
+    for (NSUInteger i = 0; i < vertexCount; ++i) {
+        const float* p = reinterpret_cast<const float*>(
+            reinterpret_cast<const unsigned char*>(vertices) + i * stride);
+        positions[i * 3] = p[0];
+        positions[i * 3 + 1] = p[1];
+        positions[i * 3 + 2] = p[2];
+    }
+    return positions;
+}
+
+static mesh::SimplifyParams simplifyParams(const SimplifyConfig& config) {
+    mesh::SimplifyParams params;
+    params.targetTriangles = config.targetTriangleCount;
+    params.targetVertices = config.targetVertexCount;
+    params.boundaryWeight = config.boundaryWeight;
+    if (config.batched) {
+        params.strategy = mesh::SimplifyParams::Strategy::Batched;
+    }
+    if (config.batchFraction > 0) {
+        params.batchFraction = config.batchFraction;
+    }
+    return params;
+}
+
+@implementation SimplificationBridge
+
++ (SimplifyResult*)simplifyVertices:(const float*)vertices
+                        vertexCount:(NSUInteger)vertexCount
+                             stride:(NSUInteger)stride
+                            indices:(const uint32_t*)indices
+                         indexCount:(NSUInteger)indexCount
+                             config:(SimplifyConfig)config {
+
+    @autoreleasepool {
+        // Allocate result structure
+        SimplifyResult* result = (SimplifyResult*)malloc(sizeof(SimplifyResult));
+        memset(result, 0, sizeof(SimplifyResult));
+
+        try {
+            mesh::MallocBuffer<float> positions = packPositions(vertices, vertexCount, stride);
+
+            mesh::SimplifyStats stats;
+            mesh::MeshData meshData = mesh::simplifyQuadric(positions.data(), vertexCount,
+                                                            indices, indexCount,
+                                                            simplifyParams(config), &stats);
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->vertexCount = meshData.vertexCount();
+            result->indexCount = meshData.indices.size();
+            result->vertices = meshData.vertices.release();
+            result->indices = meshData.indices.release();
+
+            result->collapses = stats.collapses;
+            result->rejectedCollapses = stats.rejected;
+            result->maxError = stats.maxError;
+            result->rounds = stats.rounds;
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (LodChainResult*)simplifyChainVertices:(const float*)vertices
+                             vertexCount:(NSUInteger)vertexCount
+                                  stride:(NSUInteger)stride
+                                 indices:(const uint32_t*)indices
+                              indexCount:(NSUInteger)indexCount
+                                  ratios:(const float*)ratios
+                              ratioCount:(NSUInteger)ratioCount
+                                  config:(SimplifyConfig)config {
+
+    @autoreleasepool {
+        LodChainResult* result = (LodChainResult*)malloc(sizeof(LodChainResult));
+        memset(result, 0, sizeof(LodChainResult));
+
+        try {
+            mesh::MallocBuffer<float> positions = packPositions(vertices, vertexCount, stride);
+
+            mesh::SimplifyStats stats;
+            mesh::LodChain chain = mesh::simplifyQuadricChain(positions.data(), vertexCount, indices, indexCount,
+                                                              std::vector<float>(ratios, ratios + ratioCount),
+                                                              simplifyParams(config), &stats);
+
+            result->levels = (LodLevelInfo*)malloc(chain.levels.size() * sizeof(LodLevelInfo));
+            for (size_t i = 0; i < chain.levels.size(); ++i) {
+                result->levels[i].indexOffset = chain.levels[i].indexOffset;
+                result->levels[i].indexCount = chain.levels[i].indexCount;
+                result->levels[i].vertexCount = chain.levels[i].vertexCount;
+                result->levels[i].maxError = chain.levels[i].maxError;
+            }
+            result->levelCount = chain.levels.size();
+            result->collapses = stats.collapses;
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->vertexCount = chain.vertices.size() / 3;
+            result->indexCount = chain.indices.size();
+            result->vertices = chain.vertices.release();
+            result->indices = chain.indices.release();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupResult:(SimplifyResult*)result {
+    if (result->vertices) {
+        free(result->vertices);
+        result->vertices = nullptr;
+    }
+    if (result->indices) {
+        free(result->indices);
+        result->indices = nullptr;
+    }
+    free(result);
+}
+
++ (void)cleanupChainResult:(LodChainResult*)result {
+    if (result->vertices) {
+        free(result->vertices);
+        result->vertices = nullptr;
+    }
+    if (result->indices) {
+        free(result->indices);
+        result->indices = nullptr;
+    }
+    if (result->levels) {
+        free(result->levels);
+        result->levels = nullptr;
+    }
+    free(result);
+}
+
+@end
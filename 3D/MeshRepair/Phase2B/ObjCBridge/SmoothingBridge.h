@@ -0,0 +1,51 @@
+//
+//  SmoothingBridge.h
+//  3D
+//
+//  Objective-C bridge for Taubin / Laplacian mesh smoothing
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result structure for mesh smoothing (C-compatible)
+typedef struct {
+    float* _Nullable vertices;      // Flat array: [x0,y0,z0, x1,y1,z1, ...], smoothed
+    NSUInteger vertexCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+    NSUInteger heldVertices;        // Vertices kept in place (masked, pinned or isolated)
+} SmoothingResult;
+
+/// Configuration for mesh smoothing
+typedef struct {
+    int iterations;                 // Taubin iterations (one lambda and one mu pass each)
+    float lambda;                   // Shrinking step (0.5 typical)
+    float mu;                       // Inflating step (-0.53 typical; 0 = plain Laplacian)
+    bool cotangentWeights;          // Cotangent instead of uniform neighbor weights
+    float featureAngle;             // Degrees; pin vertices on sharper edges (0 = off)
+    bool pinBoundaries;             // Pin vertices on open boundary edges
+} SmoothingConfig;
+
+/// Objective-C++ Bridge for mesh smoothing
+@interface SmoothingBridge : NSObject
+
+/// Smooth the positions of an indexed triangle mesh (stride in bytes
+/// between vertex positions, e.g. 12 for packed float3, 16 for SIMD3<Float>).
+/// `movable` (optional, one byte per vertex) marks vertices allowed to move
++ (SmoothingResult* _Nullable)smoothVertices:(const float* _Nonnull)vertices
+                                 vertexCount:(NSUInteger)vertexCount
+                                      stride:(NSUInteger)stride
+                                     indices:(const uint32_t* _Nonnull)indices
+                                  indexCount:(NSUInteger)indexCount
+                                     movable:(const uint8_t* _Nullable)movable
+                                      config:(SmoothingConfig)config;
+
+/// Clean up malloc'd memory from SmoothingResult
++ (void)cleanupResult:(SmoothingResult* _Nonnull)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
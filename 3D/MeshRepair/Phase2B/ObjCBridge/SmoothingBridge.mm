@@ -0,0 +1,75 @@
+//
+//  SmoothingBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ mesh smoother
+//
+
+#import "SmoothingBridge.h"
+#include "MeshSmoothing.hpp"
+#include <algorithm>
+
+@implementation SmoothingBridge
+
++ (SmoothingResult*)smoothVertices:(const float*)vertices
+                       vertexCount:(NSUInteger)vertexCount
+                            stride:(NSUInteger)stride
+                           indices:(const uint32_t*)indices
+                        indexCount:(NSUInteger)indexCount
+                           movable:(const uint8_t*)movable
+                            config:(SmoothingConfig)config {
+
+    @autoreleasepool {
+        // Allocate result structure
+        SmoothingResult* result = (SmoothingResult*)malloc(sizeof(SmoothingResult));
+        memset(result, 0, sizeof(SmoothingResult));
+
+        try {
+            // Packed copy of the positions, smoothed in place
+            mesh::MallocBuffer<float> positions(vertexCount * 3);
+            for (NSUInteger i = 0; i < vertexCount; ++i) {
+                const float* p = reinterpret_cast<const float*>(
+                    reinterpret_cast<const unsigned char*>(vertices) + i * stride);
+                positions[i * 3] = p[0];
+                positions[i * 3 + 1] = p[1];
+                positions[i * 3 + 2] = p[2];
+            }
+
+            mesh::SmoothingParams params;
+            params.iterations = static_cast<size_t>(std::max(config.iterations, 0));
+            params.lambda = config.lambda;
+            params.mu = config.mu;
+            params.weighting = config.cotangentWeights ? mesh::SmoothingParams::Weighting::Cotangent
+                                                       : mesh::SmoothingParams::Weighting::Uniform;
+            params.featureAngle = config.featureAngle;
+            params.pinBoundaries = config.pinBoundaries;
+
+            result->heldVertices = mesh::smoothTaubin(positions.data(), vertexCount, 3 * sizeof(float),
+                                                      indices, indexCount, params, movable);
+
+            // Hand the malloc'd buffer straight to the caller (no copy)
+            result->vertexCount = vertexCount;
+            result->vertices = positions.release();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupResult:(SmoothingResult*)result {
+    if (result->vertices) {
+        free(result->vertices);
+        result->vertices = nullptr;
+    }
+    free(result);
+}
+
+@end
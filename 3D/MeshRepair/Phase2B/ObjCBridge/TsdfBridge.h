@@ -0,0 +1,80 @@
+//
+//  TsdfBridge.h
+//  3D
+//
+//  Objective-C bridge for incremental TSDF fusion of LiDAR depth frames
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+#import <simd/simd.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result structure for fused surface extraction (C-compatible)
+typedef struct {
+    float* _Nullable points;                // Flat array: [x0,y0,z0, ...]
+    float* _Nullable normals;               // Flat array, unit length, pointing into free space
+    float* _Nullable weights;               // Fused observation weight per point
+    NSUInteger pointCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+} TsdfSurfaceResult;
+
+/// Result structure for fused mesh extraction (C-compatible)
+typedef struct {
+    float* _Nullable vertices;      // Flat array: [x0,y0,z0, x1,y1,z1, ...]
+    uint32_t* _Nullable indices;    // Triangle indices: [i0,i1,i2, ...]
+    NSUInteger vertexCount;
+    NSUInteger indexCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+    float* _Nullable normals;       // Appended last: Swift reads the fields above by offset
+} TsdfMeshResult;
+
+/// Objective-C++ Bridge owning a sparse TSDF volume
+/// Not thread-safe; integrate and extract from one queue
+@interface TsdfBridge : NSObject
+
+/// Empty volume; voxel size and truncation distance in meters
+- (instancetype)initWithVoxelSize:(float)voxelSize truncation:(float)truncation;
+
+/// Fuse one Float32 depth map (meters), ignoring pixels whose UInt8
+/// confidence is below `minConfidence`
+/// `intrinsics` must be in depth-map pixels and `pose` is camera-to-world
+/// (ARCamera.transform)
+/// Returns the number of depth samples fused, 0 when the frame is rejected
+- (NSUInteger)integrateDepth:(const float* _Nonnull)depth
+               depthRowBytes:(NSUInteger)depthRowBytes
+                  confidence:(const uint8_t* _Nullable)confidence
+          confidenceRowBytes:(NSUInteger)confidenceRowBytes
+                       width:(NSUInteger)width
+                      height:(NSUInteger)height
+                  intrinsics:(simd_float3x3)intrinsics
+                        pose:(simd_float4x4)pose
+               minConfidence:(uint8_t)minConfidence;
+
+/// Drop all fused data
+- (void)reset;
+
+/// Allocated 8^3 voxel blocks and their memory footprint
+@property (nonatomic, readonly) NSUInteger blockCount;
+@property (nonatomic, readonly) NSUInteger memoryBytes;
+
+/// Zero crossings of the fused field between voxels observed at least
+/// `minWeight` times, with normals from the field gradient
+- (TsdfSurfaceResult* _Nullable)extractSurfaceWithMinWeight:(float)minWeight;
+
+/// Clean up malloc'd memory from TsdfSurfaceResult
++ (void)cleanupSurfaceResult:(TsdfSurfaceResult* _Nonnull)result;
+
+/// Marching cubes mesh of the fused field over voxels observed at least
+/// `minWeight` times, facing free space, with per-vertex normals
+- (TsdfMeshResult* _Nullable)extractMeshWithMinWeight:(float)minWeight;
+
+/// Clean up malloc'd memory from TsdfMeshResult
++ (void)cleanupMeshResult:(TsdfMeshResult* _Nonnull)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,164 @@
+//
+//  TsdfBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ TSDF volume
+//
+
+#import "TsdfBridge.h"
+#include "TsdfVolume.hpp"
+#include <memory>
+
+@implementation TsdfBridge {
+    std::unique_ptr<mesh::TsdfVolume> _volume;
+}
+
+- (instancetype)initWithVoxelSize:(float)voxelSize truncation:(float)truncation {
+    self = [super init];
+    if (self) {
+        mesh::TsdfVolume::Configuration config;
+        config.voxelSize = voxelSize > 0.0f ? voxelSize : config.voxelSize;
+        config.truncation = truncation > 0.0f ? truncation : config.truncation;
+        _volume = std::make_unique<mesh::TsdfVolume>(config);
+    }
+    return self;
+}
+
+- (NSUInteger)integrateDepth:(const float*)depth
+               depthRowBytes:(NSUInteger)depthRowBytes
+                  confidence:(const uint8_t*)confidence
+          confidenceRowBytes:(NSUInteger)confidenceRowBytes
+                       width:(NSUInteger)width
+                      height:(NSUInteger)height
+                  intrinsics:(simd_float3x3)intrinsics
+                        pose:(simd_float4x4)pose
+               minConfidence:(uint8_t)minConfidence {
+
+    try {
+        mesh::DepthUnprojectionParams params;
+        params.intrinsics.fx = intrinsics.columns[0][0];
+        params.intrinsics.fy = intrinsics.columns[1][1];
+        params.intrinsics.cx = intrinsics.columns[2][0];
+        params.intrinsics.cy = intrinsics.columns[2][1];
+        for (int c = 0; c < 4; ++c) {
+            for (int r = 0; r < 4; ++r) {
+                params.pose[c * 4 + r] = pose.columns[c][r];
+            }
+        }
+        params.minConfidence = minConfidence;
+
+        size_t samples = 0;
+        _volume->integrate(depth, depthRowBytes, confidence, confidenceRowBytes,
+                           width, height, params, &samples);
+        return samples;
+
+    } catch (const std::exception& e) {
+        NSLog(@"TsdfBridge integrate failed: %s", e.what());
+        return 0;
+    }
+}
+
+- (void)reset {
+    _volume->clear();
+}
+
+- (NSUInteger)blockCount {
+    return _volume->blockCount();
+}
+
+- (NSUInteger)memoryBytes {
+    return _volume->memoryBytes();
+}
+
+- (TsdfSurfaceResult*)extractSurfaceWithMinWeight:(float)minWeight {
+
+    @autoreleasepool {
+        // Allocate result structure
+        TsdfSurfaceResult* result = (TsdfSurfaceResult*)malloc(sizeof(TsdfSurfaceResult));
+        memset(result, 0, sizeof(TsdfSurfaceResult));
+
+        try {
+            mesh::TsdfSurfacePoints surface = _volume->extractSurfacePoints(minWeight);
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->pointCount = surface.weights.size();
+            result->points = surface.points.release();
+            result->normals = surface.normals.release();
+            result->weights = surface.weights.release();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupSurfaceResult:(TsdfSurfaceResult*)result {
+    if (result->points) {
+        free(result->points);
+        result->points = nullptr;
+    }
+    if (result->normals) {
+        free(result->normals);
+        result->normals = nullptr;
+    }
+    if (result->weights) {
+        free(result->weights);
+        result->weights = nullptr;
+    }
+    free(result);
+}
+
+- (TsdfMeshResult*)extractMeshWithMinWeight:(float)minWeight {
+
+    @autoreleasepool {
+        // Allocate result structure
+        TsdfMeshResult* result = (TsdfMeshResult*)malloc(sizeof(TsdfMeshResult));
+        memset(result, 0, sizeof(TsdfMeshResult));
+
+        try {
+            mesh::MeshData meshData = _volume->extractSurfaceMesh(minWeight);
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->vertexCount = meshData.vertexCount();
+            result->indexCount = meshData.indices.size();
+            result->vertices = meshData.vertices.release();
+            result->indices = meshData.indices.release();
+            result->normals = meshData.normals.release();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupMeshResult:(TsdfMeshResult*)result {
+    if (result->vertices) {
+        free(result->vertices);
+        result->vertices = nullptr;
+    }
+    if (result->indices) {
+        free(result->indices);
+        result->indices = nullptr;
+    }
+    if (result->normals) {
+        free(result->normals);
+        result->normals = nullptr;
+    }
+    free(result);
+}
+
+@end
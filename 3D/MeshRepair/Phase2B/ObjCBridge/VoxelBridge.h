@@ -0,0 +1,55 @@
+//
+//  VoxelBridge.h
+//  3D
+//
+//  Objective-C bridge for sparse voxel repair (point cloud -> closed mesh)
+//  Pure C/Objective-C header (Swift-compatible, no C++)
+//
+
+#import <Foundation/Foundation.h>
+#import <simd/simd.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Result structure for voxel meshing (C-compatible)
+typedef struct {
+    float* _Nullable vertices;      // Flat array: [x0,y0,z0, x1,y1,z1, ...]
+    uint32_t* _Nullable indices;    // Triangle indices: [i0,i1,i2, ...]
+    NSUInteger vertexCount;
+    NSUInteger indexCount;
+    bool success;
+    NSString* _Nullable errorMessage;
+    NSUInteger occupiedVoxels;      // Appended last: Swift reads the fields above by offset
+    NSUInteger brickCount;          // Allocated 8^3 bricks
+    NSUInteger memoryBytes;         // Grid memory at its peak
+} VoxelMeshResult;
+
+/// Configuration for voxel meshing
+typedef struct {
+    float voxelSize;                // Edge length of a voxel (world units)
+    simd_float3 origin;             // Corner of voxel (0, 0, 0)
+    float occupancyThreshold;       // Occupied at this fraction of the densest voxel's count
+    float dilationSeed;             // Voxels above this fraction of the peak seed dilation
+    int dilationIterations;         // 6-connected dilation steps (0 = none)
+    int closingRadius;              // Morphological closing radius in voxels (0 = none)
+    bool fillInterior;              // Fill cavities not connected to the outside
+} VoxelConfig;
+
+/// Objective-C++ Bridge for sparse voxel repair
+@interface VoxelBridge : NSObject
+
+/// Rasterize points (stride in bytes, e.g. 16 for SIMD3<Float> arrays) into
+/// a sparse grid, threshold and dilate it, optionally close it and fill its
+/// cavities on a bit-packed dense copy, and return the marching cubes
+/// surface of the occupied voxels as a closed indexed mesh
++ (VoxelMeshResult* _Nullable)voxelMeshWithPoints:(const float* _Nonnull)points
+                                       pointCount:(NSUInteger)count
+                                           stride:(NSUInteger)stride
+                                           config:(VoxelConfig)config;
+
+/// Clean up malloc'd memory from VoxelMeshResult
++ (void)cleanupResult:(VoxelMeshResult* _Nonnull)result;
+
+@end
+
+NS_ASSUME_NONNULL_END
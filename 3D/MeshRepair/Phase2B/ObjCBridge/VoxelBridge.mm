@@ -0,0 +1,89 @@
+//
+//  VoxelBridge.mm
+//  3D
+//
+//  Objective-C++ implementation bridging Swift to the C++ sparse voxel grid
+//
+
+#import "VoxelBridge.h"
+#include "SparseVoxelGrid.hpp"
+#include "VoxelSurface.hpp"
+#include <algorithm>
+
+@implementation VoxelBridge
+
++ (VoxelMeshResult*)voxelMeshWithPoints:(const float*)points
+                             pointCount:(NSUInteger)count
+                                 stride:(NSUInteger)stride
+                                 config:(VoxelConfig)config {
+
+    @autoreleasepool {
+        // Allocate result structure
+        VoxelMeshResult* result = (VoxelMeshResult*)malloc(sizeof(VoxelMeshResult));
+        memset(result, 0, sizeof(VoxelMeshResult));
+
+        try {
+            // Rasterize straight from the caller's buffer
+            mesh::SparseVoxelGrid grid(config.voxelSize,
+                                       mesh::Point3D(config.origin.x, config.origin.y, config.origin.z));
+            grid.rasterize(points, count, stride);
+
+            grid.threshold(config.occupancyThreshold);
+            if (config.dilationIterations > 0) {
+                grid.dilate(static_cast<size_t>(config.dilationIterations), config.dilationSeed);
+            }
+
+            // Closing, cavity filling and surface extraction run on a dense
+            // bit volume over the occupied bricks, padded so closing has room
+            // to grow and the border stays clear
+            const int32_t radius = std::max(config.closingRadius, 0);
+            int32_t offset[3];
+            mesh::BitVolume volume = grid.occupancyVolume(radius + 1, offset);
+            if (radius > 0) {
+                volume.close(static_cast<size_t>(radius));
+            }
+            if (config.fillInterior) {
+                volume.fillInterior();
+            }
+
+            const mesh::Point3D volumeOrigin(config.origin.x + static_cast<float>(offset[0]) * config.voxelSize,
+                                             config.origin.y + static_cast<float>(offset[1]) * config.voxelSize,
+                                             config.origin.z + static_cast<float>(offset[2]) * config.voxelSize);
+            mesh::MeshData meshData = mesh::extractVoxelSurface(volume, config.voxelSize, volumeOrigin);
+
+            // Hand the malloc'd buffers straight to the caller (no copy)
+            result->vertexCount = meshData.vertexCount();
+            result->indexCount = meshData.indices.size();
+            result->vertices = meshData.vertices.release();
+            result->indices = meshData.indices.release();
+
+            result->occupiedVoxels = volume.count();
+            result->brickCount = grid.brickCount();
+            result->memoryBytes = grid.memoryBytes() + volume.memoryBytes();
+
+            result->success = true;
+            result->errorMessage = nil;
+
+            return result;
+
+        } catch (const std::exception& e) {
+            result->success = false;
+            result->errorMessage = [NSString stringWithUTF8String:e.what()];
+            return result;
+        }
+    }
+}
+
++ (void)cleanupResult:(VoxelMeshResult*)result {
+    if (result->vertices) {
+        free(result->vertices);
+        result->vertices = nullptr;
+    }
+    if (result->indices) {
+        free(result->indices);
+        result->indices = nullptr;
+    }
+    free(result);
+}
+
+@end
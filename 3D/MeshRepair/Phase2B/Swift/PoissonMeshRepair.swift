@@ -100,7 +100,13 @@ public class PoissonMeshRepair {
         if configuration.verbose {
             print("Step 2/5: Estimating normals (k-NN + PCA)...")
         }
-        let refinedNormals = NormalEstimator.estimate(points: points, kNeighbors: 12)
+        let estimate = NormalEstimator.estimateWithConfidence(points: points, kNeighbors: 12)
+
+        // Normal length carries the sample weight into Poisson (confidence mode),
+        // so noisy, non-planar neighborhoods pull less on the surface
+        let refinedNormals = zip(estimate.normals, estimate.confidence).map { normal, confidence in
+            normal * max(confidence, 0.05)
+        }
 
         if configuration.verbose {
             print("  ✅ Normals estimated using PCA")
@@ -116,6 +122,7 @@ public class PoissonMeshRepair {
             normals: refinedNormals,
             depth: configuration.poissonDepth,
             samplesPerNode: configuration.samplesPerNode,
+            useNormalConfidence: true,
             verbose: configuration.verbose
         )
 
@@ -126,14 +133,15 @@ public class PoissonMeshRepair {
 
         // Step 4/5: MeshFix topological repair
         var fixed = reconstructed
+        var holesFilled = 0
         if configuration.enableMeshFix {
             if configuration.verbose {
                 print("Step 4/5: MeshFix topological repair...")
             }
-            fixed = try meshFix(reconstructed, maxHoleSize: configuration.maxHoleSize, verbose: configuration.verbose)
+            (fixed, holesFilled) = try meshFix(reconstructed, maxHoleSize: configuration.maxHoleSize, verbose: configuration.verbose)
 
             if configuration.verbose {
-                print("  ✅ Topology repaired")
+                print("  ✅ Topology repaired (\(holesFilled) holes filled)")
                 print("")
             }
         } else {
@@ -171,7 +179,7 @@ public class PoissonMeshRepair {
             triangleCount: countTriangles(smoothed),
             volume: estimateVolume(smoothed),
             boundaryEdges: 0,
-            holesFilledCount: 0
+            holesFilledCount: holesFilled
         )
 
         // Estimate quality score based on watertight status and mesh properties
@@ -252,35 +260,40 @@ public class PoissonMeshRepair {
         normals: [SIMD3<Float>],
         depth: Int,
         samplesPerNode: Float,
+        useNormalConfidence: Bool,
         verbose: Bool
     ) async throws -> MDLMesh {
 
-        // Flatten arrays for C interface
-        var flatPoints = points.flatMap { [$0.x, $0.y, $0.z] }
-        var flatNormals = normals.flatMap { [$0.x, $0.y, $0.z] }
-
         // Create config
-        var config = PoissonConfig(
+        let config = PoissonConfig(
             depth: Int32(depth),
             samplesPerNode: samplesPerNode,
             scale: 1.1,
             enableDensityTrimming: false,
             trimPercentage: 0.0,
-            verbose: verbose
+            verbose: verbose,
+            useNormalConfidence: useNormalConfidence
         )
 
-        // Call bridge
-        guard let pointsBase = flatPoints.withUnsafeMutableBufferPointer({ $0.baseAddress }),
-              let normalsBase = flatNormals.withUnsafeMutableBufferPointer({ $0.baseAddress }) else {
-            throw MeshRepairError.poissonFailed(NSError(domain: "PoissonBridge", code: -2, userInfo: [NSLocalizedDescriptionKey: "Failed to get buffer base addresses"]))
+        // Call bridge directly on the SIMD3<Float> storage (no flattening copy)
+        let stride = UInt(MemoryLayout<SIMD3<Float>>.stride)
+        let bridgeResult: UnsafeMutablePointer<PoissonResult>? = points.withUnsafeBufferPointer { pointsBuffer in
+            normals.withUnsafeBufferPointer { normalsBuffer -> UnsafeMutablePointer<PoissonResult>? in
+                guard let pointsBase = pointsBuffer.baseAddress,
+                      let normalsBase = normalsBuffer.baseAddress else {
+                    return nil
+                }
+                return PoissonBridge.reconstructSurface(
+                    withPoints: UnsafeRawPointer(pointsBase).assumingMemoryBound(to: Float.self),
+                    normals: UnsafeRawPointer(normalsBase).assumingMemoryBound(to: Float.self),
+                    pointCount: UInt(points.count),
+                    stride: stride,
+                    config: config
+                )
+            }
         }
 
-        guard let result = PoissonBridge.reconstructSurface(
-            withPoints: pointsBase,
-            normals: normalsBase,
-            pointCount: UInt(points.count),
-            config: config
-        ) else {
+        guard let result = bridgeResult else {
             throw MeshRepairError.poissonFailed(NSError(domain: "PoissonBridge", code: -1))
         }
 
@@ -314,11 +327,12 @@ public class PoissonMeshRepair {
     }
 
     /// Call MeshFix via C++ bridge
+    /// Returns the repaired mesh and the number of holes filled
     private func meshFix(
         _ mesh: MDLMesh,
         maxHoleSize: Int,
         verbose: Bool
-    ) throws -> MDLMesh {
+    ) throws -> (MDLMesh, Int) {
 
         // Extract mesh data
         let (vertices, indices) = extractMeshData(mesh)
@@ -356,7 +370,7 @@ public class PoissonMeshRepair {
         }
 
         // Access result as unsafe raw pointer (OpaquePointer from C bridge)
-        // MeshFixResult layout: vertices, indices, vertexCount, indexCount, holesFilledCount, success, errorMessage
+        // MeshFixResult layout: vertices, indices, vertexCount, indexCount, holesFilledCount, success, errorMessage, report
         let resultPtr = UnsafeRawPointer(result)
         let successOffset = MemoryLayout<UnsafeMutablePointer<Float>?>.stride + MemoryLayout<UnsafeMutablePointer<UInt32>?>.stride + MemoryLayout<Int>.stride * 2 + MemoryLayout<Int32>.stride
         let success = resultPtr.load(fromByteOffset: successOffset, as: Bool.self)
@@ -370,6 +384,7 @@ public class PoissonMeshRepair {
         let resultIndices = resultPtr.load(fromByteOffset: MemoryLayout<UnsafeMutablePointer<Float>?>.stride, as: UnsafeMutablePointer<UInt32>?.self)
         let resultVertexCount = resultPtr.load(fromByteOffset: MemoryLayout<UnsafeMutablePointer<Float>?>.stride + MemoryLayout<UnsafeMutablePointer<UInt32>?>.stride, as: Int.self)
         let resultIndexCount = resultPtr.load(fromByteOffset: MemoryLayout<UnsafeMutablePointer<Float>?>.stride + MemoryLayout<UnsafeMutablePointer<UInt32>?>.stride + MemoryLayout<Int>.stride, as: Int.self)
+        let holesFilledCount = resultPtr.load(fromByteOffset: MemoryLayout<UnsafeMutablePointer<Float>?>.stride + MemoryLayout<UnsafeMutablePointer<UInt32>?>.stride + MemoryLayout<Int>.stride * 2, as: Int32.self)
 
         // Convert to MDLMesh
         let fixedMesh = createMDLMesh(
@@ -379,7 +394,7 @@ public class PoissonMeshRepair {
             indexCount: resultIndexCount
         )
 
-        return fixedMesh
+        return (fixedMesh, Int(holesFilledCount))
     }
 
     /// Extract vertices and indices from MDLMesh
@@ -3,6 +3,7 @@
 //  3D
 //
 //  Volume-preserving Taubin smoothing for mesh refinement
+//  Runs in C++ (SmoothingBridge) over CSR adjacency and SoA positions
 //
 
 import Foundation
@@ -11,6 +12,14 @@ import simd
 
 public class TaubinSmoother {
 
+    /// Neighbor weighting of the Laplacian
+    public enum Weighting {
+        /// Plain neighbor average (fast; pulls vertices toward dense sampling)
+        case uniform
+        /// Cotangent weights (follows the surface geometry, not the triangulation)
+        case cotangent
+    }
+
     /// Apply volume-preserving Taubin smoothing to mesh
     ///
     /// - Parameters:
@@ -18,145 +27,119 @@ public class TaubinSmoother {
     ///   - iterations: Number of smoothing iterations (5-10 typical)
     ///   - lambda: Positive smoothing factor (0.5 typical)
     ///   - mu: Negative smoothing factor (should be < -lambda, typically -0.53)
+    ///   - weighting: Neighbor weighting of the Laplacian
+    ///   - featureAngle: Pin vertices on edges with a sharper dihedral angle, in degrees (0 = off)
+    ///   - pinBoundaries: Keep vertices on open boundaries in place
+    ///   - movable: Optional per-vertex mask; vertices with `false` stay in place
     /// - Returns: Smoothed mesh
     public static func smooth(
         _ mesh: MDLMesh,
         iterations: Int = 5,
         lambda: Float = 0.5,
-        mu: Float = -0.53
+        mu: Float = -0.53,
+        weighting: Weighting = .uniform,
+        featureAngle: Float = 0,
+        pinBoundaries: Bool = false,
+        movable: [Bool]? = nil
     ) -> MDLMesh {
 
-        guard iterations > 0 else { return mesh }
-
-        // Extract vertex positions
-        var vertices = extractVertices(mesh)
-        let adjacency = buildAdjacency(mesh)
-
-        // Apply Taubin iterations
-        for _ in 0..<iterations {
-            // Positive smoothing pass (shrinks)
-            vertices = smoothPass(vertices, adjacency: adjacency, factor: lambda)
-
-            // Negative smoothing pass (expands, compensates shrinkage)
-            vertices = smoothPass(vertices, adjacency: adjacency, factor: mu)
-        }
-
-        // Update mesh with smoothed vertices
-        return updateMeshVertices(mesh, with: vertices)
-    }
-
-    // MARK: - Smoothing Pass
-
-    private static func smoothPass(
-        _ vertices: [SIMD3<Float>],
-        adjacency: [[Int]],
-        factor: Float
-    ) -> [SIMD3<Float>] {
-
-        var smoothed = vertices
-
-        for i in 0..<vertices.count {
-            let neighbors = adjacency[i]
-            guard !neighbors.isEmpty else { continue }
-
-            // Compute Laplacian (average neighbor displacement)
-            var laplacian = SIMD3<Float>.zero
-            for neighborIdx in neighbors {
-                laplacian += vertices[neighborIdx] - vertices[i]
-            }
-            laplacian /= Float(neighbors.count)
-
-            // Update position
-            smoothed[i] = vertices[i] + factor * laplacian
+        guard iterations > 0,
+              let vertexBuffer = mesh.vertexBuffers.first,
+              let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else {
+            return mesh
         }
 
-        return smoothed
-    }
-
-    // MARK: - Adjacency Building
+        let indices = MemoryBufferHelper.extractIndices(from: mesh)
+        guard !indices.isEmpty else { return mesh }
 
-    private static func buildAdjacency(_ mesh: MDLMesh) -> [[Int]] {
         let vertexCount = mesh.vertexCount
-        var adjacency = Array(repeating: Set<Int>(), count: vertexCount)
-
-        // Extract triangle indices
-        guard let submesh = mesh.submeshes?.object(at: 0) as? MDLSubmesh else {
-            return adjacency.map { Array($0) }
+        let stride = layout.stride
+        let positionOffset = mesh.vertexDescriptor.attributeNamed(MDLVertexAttributePosition)?.offset ?? 0
+
+        var config = SmoothingConfig()
+        config.iterations = Int32(iterations)
+        config.lambda = lambda
+        config.mu = mu
+        config.cotangentWeights = weighting == .cotangent
+        config.featureAngle = featureAngle
+        config.pinBoundaries = pinBoundaries
+
+        let mask: [UInt8]? = movable.map { flags in
+            (0..<vertexCount).map { $0 < flags.count && flags[$0] ? 1 : 0 }
         }
 
-        let indexBuffer = submesh.indexBuffer.map()
-        let indexType = submesh.indexType
-
-        // Parse indices based on type
-        for i in stride(from: 0, to: submesh.indexCount, by: 3) {
-            let i0: Int
-            let i1: Int
-            let i2: Int
-
-            switch indexType {
-            case .uInt32:
-                let indices = indexBuffer.bytes.assumingMemoryBound(to: UInt32.self)
-                i0 = Int(indices[i])
-                i1 = Int(indices[i+1])
-                i2 = Int(indices[i+2])
-            case .uInt16:
-                let indices = indexBuffer.bytes.assumingMemoryBound(to: UInt16.self)
-                i0 = Int(indices[i])
-                i1 = Int(indices[i+1])
-                i2 = Int(indices[i+2])
-            default:
-                continue
+        // Smooth straight from the mapped vertex buffer
+        let vertexMap = vertexBuffer.map()
+        let bridgeResult: UnsafeMutablePointer<SmoothingResult>? = indices.withUnsafeBufferPointer { indexBuffer in
+            let positions = UnsafeRawPointer(vertexMap.bytes.advanced(by: positionOffset)).assumingMemoryBound(to: Float.self)
+            let call = { (maskPointer: UnsafePointer<UInt8>?) in
+                SmoothingBridge.smoothVertices(
+                    positions,
+                    vertexCount: UInt(vertexCount),
+                    stride: UInt(stride),
+                    indices: indexBuffer.baseAddress!,
+                    indexCount: UInt(indices.count),
+                    movable: maskPointer,
+                    config: config
+                )
             }
-
-            // Add bidirectional edges
-            adjacency[i0].insert(i1)
-            adjacency[i0].insert(i2)
-            adjacency[i1].insert(i0)
-            adjacency[i1].insert(i2)
-            adjacency[i2].insert(i0)
-            adjacency[i2].insert(i1)
+            if let mask = mask {
+                return mask.withUnsafeBufferPointer { call($0.baseAddress) }
+            }
+            return call(nil)
         }
 
-        return adjacency.map { Array($0) }
-    }
-
-    // MARK: - Vertex Extraction
-
-    private static func extractVertices(_ mesh: MDLMesh) -> [SIMD3<Float>] {
-        var vertices: [SIMD3<Float>] = []
-
-        guard let vertexBuffer = mesh.vertexBuffers.first else { return vertices }
-        let vertexData = vertexBuffer.map().bytes
-
-        guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else {
-            return vertices
+        guard let result = bridgeResult else {
+            return mesh
         }
 
-        let stride = layout.stride
-        let vertexCount = mesh.vertexCount
+        defer {
+            SmoothingBridge.cleanupResult(result)
+        }
 
-        vertices.reserveCapacity(vertexCount)
+        // SmoothingResult layout: vertices, vertexCount, success, errorMessage, heldVertices
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let success = resultPtr.load(fromByteOffset: pointerStride + MemoryLayout<Int>.stride, as: Bool.self)
 
-        for i in 0..<vertexCount {
-            let offset = i * stride
-            let position = vertexData.advanced(by: offset).assumingMemoryBound(to: SIMD3<Float>.self).pointee
-            vertices.append(position)
+        guard success,
+              let smoothed = resultPtr.load(as: UnsafeMutablePointer<Float>?.self) else {
+            print("   ⚠️ Taubin smoothing failed; returning mesh unchanged")
+            return mesh
         }
 
-        return vertices
+        // Update mesh with smoothed vertices
+        return updateMeshVertices(mesh, vertexData: vertexMap.bytes, stride: stride,
+                                  positionOffset: positionOffset, smoothed: smoothed)
     }
 
     // MARK: - Mesh Update
 
-    private static func updateMeshVertices(_ mesh: MDLMesh, with vertices: [SIMD3<Float>]) -> MDLMesh {
-        // Create new vertex buffer with updated positions
-        let vertexData = Data(bytes: vertices, count: vertices.count * MemoryLayout<SIMD3<Float>>.size)
-        let vertexBuffer = MDLMeshBufferData(type: .vertex, data: vertexData)
+    /// Copy of the vertex buffer with positions replaced (other attributes kept)
+    private static func updateMeshVertices(
+        _ mesh: MDLMesh,
+        vertexData: UnsafeMutableRawPointer,
+        stride: Int,
+        positionOffset: Int,
+        smoothed: UnsafeMutablePointer<Float>
+    ) -> MDLMesh {
+        let vertexCount = mesh.vertexCount
+        var data = Data(bytes: vertexData, count: vertexCount * stride)
+        data.withUnsafeMutableBytes { bytes in
+            guard let base = bytes.baseAddress else { return }
+            for i in 0..<vertexCount {
+                let position = base.advanced(by: i * stride + positionOffset).assumingMemoryBound(to: Float.self)
+                position[0] = smoothed[i * 3]
+                position[1] = smoothed[i * 3 + 1]
+                position[2] = smoothed[i * 3 + 2]
+            }
+        }
+        let vertexBuffer = MDLMeshBufferData(type: .vertex, data: data)
 
         // Create new mesh with same topology, updated vertices
         let newMesh = MDLMesh(
             vertexBuffer: vertexBuffer,
-            vertexCount: vertices.count,
+            vertexCount: vertexCount,
             descriptor: mesh.vertexDescriptor,
             submeshes: mesh.submeshes as? [MDLSubmesh] ?? []
         )
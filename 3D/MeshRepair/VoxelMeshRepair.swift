@@ -42,6 +42,12 @@ public class VoxelMeshRepair {
         /// Padding around object (in voxels)
         public var padding: Int
 
+        /// Morphological closing radius (in voxels) for sealing small gaps (0 = off)
+        public var closingRadius: Int = 1
+
+        /// Fill enclosed cavities so only the outer surface is meshed
+        public var fillCavities: Bool = true
+
         public static let smallObject = Configuration(
             resolution: 48,              // 48³ voxels = faster, lower memory (110K voxels)
             occupancyThreshold: 0.3,     // Lower = fill more aggressively
@@ -97,33 +103,24 @@ public class VoxelMeshRepair {
 
         print("   📦 Bounding Box: \(bboxMin) to \(bboxMax)")
 
-        // Step 3: Create voxel occupancy grid (with memory management)
-        let occupancy = autoreleasepool {
-            createOccupancyGrid(
-                points: pointCloud.points,
-                bboxMin: bboxMin,
-                bboxMax: bboxMax,
-                resolution: configuration.resolution
-            )
-        }
-
-        print("   ✅ Created occupancy grid")
-
-        // Step 4: Generate watertight mesh from voxels (with memory management)
-        let meshTriangles = autoreleasepool {
-            meshFromOccupancyGrid(
-                occupancy: occupancy,
-                dims: (configuration.resolution, configuration.resolution, configuration.resolution),
-                bboxMin: bboxMin,
-                bboxMax: bboxMax,
-                threshold: configuration.occupancyThreshold
-            )
+        // Step 3: Voxelize into a sparse brick grid and extract its closed surface
+        // (memory follows the occupied shell, not resolution³)
+        let extent = bboxMax - bboxMin
+        let voxelSize = max(extent.x, max(extent.y, extent.z)) / Float(configuration.resolution)
+        guard let voxelMesh = sparseVoxelMesh(
+            points: pointCloud.points,
+            origin: bboxMin,
+            voxelSize: voxelSize,
+            configuration: configuration
+        ) else {
+            print("   ❌ Sparse voxelization failed")
+            return nil
         }
 
-        print("   ✅ Generated \(meshTriangles.count) triangles (watertight)")
+        print("   ✅ Generated \(voxelMesh.indices.count / 3) triangles (watertight)")
 
-        // Step 5: Convert triangles back to MDLMesh
-        guard let repairedMesh = createMDLMesh(from: meshTriangles) else {
+        // Step 4: Convert back to MDLMesh
+        guard let repairedMesh = createMDLMesh(vertices: voxelMesh.vertices, indices: voxelMesh.indices) else {
             print("   ❌ Failed to create MDLMesh")
             return nil
         }
@@ -195,210 +192,78 @@ public class VoxelMeshRepair {
         return (minP, maxP)
     }
 
-    // MARK: - Voxel Grid Creation
+    // MARK: - Sparse Voxelization
 
-    private static func createOccupancyGrid(
+    /// Rasterize, threshold, dilate, close and extract the marching cubes surface via VoxelBridge
+    /// Occupancy is relative to the densest voxel; one dilation step fills
+    /// neighbors of voxels above half the peak density (as long as 90% of
+    /// their density still clears the threshold)
+    private static func sparseVoxelMesh(
         points: [SIMD3<Float>],
-        bboxMin: SIMD3<Float>,
-        bboxMax: SIMD3<Float>,
-        resolution: Int
-    ) -> [Float] {
-
-        let nx = resolution
-        let ny = resolution
-        let nz = resolution
-        let count = nx * ny * nz
-
-        var grid = [Float](repeating: 0.0, count: count)
-
-        let size = bboxMax - bboxMin
-        let invScale = SIMD3<Float>(
-            Float(nx) / max(1e-6, size.x),
-            Float(ny) / max(1e-6, size.y),
-            Float(nz) / max(1e-6, size.z)
-        )
-
-        func idx(_ x: Int, _ y: Int, _ z: Int) -> Int {
-            return z + nz * (y + ny * x)
-        }
-
-        // Rasterize points into grid
-        for point in points {
-            let normalized = (point - bboxMin) * invScale
-
-            let x = Int(normalized.x)
-            let y = Int(normalized.y)
-            let z = Int(normalized.z)
-
-            // Bounds check
-            if x >= 0 && x < nx && y >= 0 && y < ny && z >= 0 && z < nz {
-                grid[idx(x, y, z)] += 1.0
-            }
-        }
-
-        // Normalize to 0-1 range
-        let maxVal = grid.max() ?? 1.0
-        if maxVal > 0 {
-            for i in 0..<count {
-                grid[i] /= maxVal
+        origin: SIMD3<Float>,
+        voxelSize: Float,
+        configuration: Configuration
+    ) -> (vertices: [Float], indices: [UInt32])? {
+
+        let threshold = configuration.occupancyThreshold
+        var config = VoxelConfig()
+        config.voxelSize = voxelSize
+        config.origin = origin
+        config.occupancyThreshold = threshold
+        config.dilationSeed = max(0.5, threshold / 0.9)
+        config.dilationIterations = 1
+        config.closingRadius = Int32(max(0, configuration.closingRadius))
+        config.fillInterior = configuration.fillCavities
+
+        // Call bridge directly on the SIMD3<Float> storage (no flattening copy)
+        let bridgeResult: UnsafeMutablePointer<VoxelMeshResult>? = points.withUnsafeBufferPointer { buffer in
+            guard let base = buffer.baseAddress else {
+                return nil
             }
+            return VoxelBridge.voxelMesh(
+                withPoints: UnsafeRawPointer(base).assumingMemoryBound(to: Float.self),
+                pointCount: UInt(points.count),
+                stride: UInt(MemoryLayout<SIMD3<Float>>.stride),
+                config: config
+            )
         }
 
-        // Apply dilation to fill small holes
-        grid = dilateGrid(grid, dims: (nx, ny, nz), iterations: 1)
-
-        return grid
-    }
-
-    /// Morphological dilation to fill small gaps
-    private static func dilateGrid(_ grid: [Float], dims: (Int, Int, Int), iterations: Int) -> [Float] {
-        let (nx, ny, nz) = dims
-        var current = grid
-
-        func idx(_ x: Int, _ y: Int, _ z: Int) -> Int {
-            return z + nz * (y + ny * x)
+        guard let result = bridgeResult else {
+            return nil
         }
 
-        for _ in 0..<iterations {
-            var next = current
-
-            for x in 0..<nx {
-                for y in 0..<ny {
-                    for z in 0..<nz {
-                        if current[idx(x, y, z)] > 0 { continue }
-
-                        // Check 6-connected neighbors
-                        var maxNeighbor: Float = 0
-
-                        if x > 0 { maxNeighbor = max(maxNeighbor, current[idx(x-1, y, z)]) }
-                        if x < nx-1 { maxNeighbor = max(maxNeighbor, current[idx(x+1, y, z)]) }
-                        if y > 0 { maxNeighbor = max(maxNeighbor, current[idx(x, y-1, z)]) }
-                        if y < ny-1 { maxNeighbor = max(maxNeighbor, current[idx(x, y+1, z)]) }
-                        if z > 0 { maxNeighbor = max(maxNeighbor, current[idx(x, y, z-1)]) }
-                        if z < nz-1 { maxNeighbor = max(maxNeighbor, current[idx(x, y, z+1)]) }
-
-                        if maxNeighbor > 0.5 {
-                            next[idx(x, y, z)] = maxNeighbor * 0.9
-                        }
-                    }
-                }
-            }
-
-            current = next
+        defer {
+            VoxelBridge.cleanupResult(result)
         }
 
-        return current
-    }
-
-    // MARK: - Voxel to Mesh (Marching Cubes style)
-
-    /// Generate watertight triangle mesh from occupancy grid
-    /// Uses naive surface extraction (creates cube faces at boundaries)
-    private static func meshFromOccupancyGrid(
-        occupancy: [Float],
-        dims: (Int, Int, Int),
-        bboxMin: SIMD3<Float>,
-        bboxMax: SIMD3<Float>,
-        threshold: Float
-    ) -> [MeshTriangle] {
-
-        let (nx, ny, nz) = dims
-
-        guard occupancy.count == nx * ny * nz else { return [] }
-
-        func idx(_ x: Int, _ y: Int, _ z: Int) -> Int {
-            return z + nz * (y + ny * x)
+        // VoxelMeshResult layout: vertices, indices, vertexCount, indexCount, success,
+        // errorMessage, occupiedVoxels, brickCount, memoryBytes
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let vertexCount = resultPtr.load(fromByteOffset: pointerStride * 2, as: Int.self)
+        let indexCount = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride, as: Int.self)
+        let success = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride * 2, as: Bool.self)
+
+        guard success,
+              let vertexData = resultPtr.load(as: UnsafeMutablePointer<Float>?.self),
+              let indexData = resultPtr.load(fromByteOffset: pointerStride, as: UnsafeMutablePointer<UInt32>?.self) else {
+            return nil
         }
 
-        // Voxel size in world coordinates
-        let size = bboxMax - bboxMin
-        let voxelSize = SIMD3<Float>(
-            size.x / Float(nx),
-            size.y / Float(ny),
-            size.z / Float(nz)
-        )
-
-        var triangles: [MeshTriangle] = []
-        triangles.reserveCapacity(nx * ny * nz * 2) // Rough estimate
-
-        // For each voxel that is occupied, create faces where neighbors are empty
-        for x in 0..<nx {
-            for y in 0..<ny {
-                for z in 0..<nz {
-                    let value = occupancy[idx(x, y, z)]
-                    if value < threshold { continue } // Empty voxel
-
-                    // Compute voxel corner in world coords
-                    let base = SIMD3<Float>(
-                        bboxMin.x + Float(x) * voxelSize.x,
-                        bboxMin.y + Float(y) * voxelSize.y,
-                        bboxMin.z + Float(z) * voxelSize.z
-                    )
-
-                    // 8 corners of voxel cube
-                    let p000 = base
-                    let p100 = base + SIMD3<Float>(voxelSize.x, 0, 0)
-                    let p010 = base + SIMD3<Float>(0, voxelSize.y, 0)
-                    let p110 = base + SIMD3<Float>(voxelSize.x, voxelSize.y, 0)
-                    let p001 = base + SIMD3<Float>(0, 0, voxelSize.z)
-                    let p101 = base + SIMD3<Float>(voxelSize.x, 0, voxelSize.z)
-                    let p011 = base + SIMD3<Float>(0, voxelSize.y, voxelSize.z)
-                    let p111 = base + SIMD3<Float>(voxelSize.x, voxelSize.y, voxelSize.z)
-
-                    // Check if neighbor is empty/outside
-                    func isEmpty(_ nx: Int, _ ny: Int, _ nz: Int) -> Bool {
-                        if nx < 0 || ny < 0 || nz < 0 || nx >= dims.0 || ny >= dims.1 || nz >= dims.2 {
-                            return true
-                        }
-                        return occupancy[idx(nx, ny, nz)] < threshold
-                    }
-
-                    // -X face
-                    if isEmpty(x-1, y, z) {
-                        triangles.append(MeshTriangle(a: p000, b: p001, c: p011))
-                        triangles.append(MeshTriangle(a: p000, b: p011, c: p010))
-                    }
-
-                    // +X face
-                    if isEmpty(x+1, y, z) {
-                        triangles.append(MeshTriangle(a: p100, b: p110, c: p111))
-                        triangles.append(MeshTriangle(a: p100, b: p111, c: p101))
-                    }
-
-                    // -Y face
-                    if isEmpty(x, y-1, z) {
-                        triangles.append(MeshTriangle(a: p000, b: p100, c: p101))
-                        triangles.append(MeshTriangle(a: p000, b: p101, c: p001))
-                    }
-
-                    // +Y face
-                    if isEmpty(x, y+1, z) {
-                        triangles.append(MeshTriangle(a: p010, b: p011, c: p111))
-                        triangles.append(MeshTriangle(a: p010, b: p111, c: p110))
-                    }
-
-                    // -Z face
-                    if isEmpty(x, y, z-1) {
-                        triangles.append(MeshTriangle(a: p000, b: p010, c: p110))
-                        triangles.append(MeshTriangle(a: p000, b: p110, c: p100))
-                    }
-
-                    // +Z face
-                    if isEmpty(x, y, z+1) {
-                        triangles.append(MeshTriangle(a: p001, b: p101, c: p111))
-                        triangles.append(MeshTriangle(a: p001, b: p111, c: p011))
-                    }
-                }
-            }
-        }
+        let statsOffset = pointerStride * 2 + MemoryLayout<Int>.stride * 3 + pointerStride
+        let occupiedVoxels = resultPtr.load(fromByteOffset: statsOffset, as: Int.self)
+        let brickCount = resultPtr.load(fromByteOffset: statsOffset + MemoryLayout<Int>.stride, as: Int.self)
+        let memoryBytes = resultPtr.load(fromByteOffset: statsOffset + MemoryLayout<Int>.stride * 2, as: Int.self)
+        print("   ✅ \(occupiedVoxels) occupied voxels in \(brickCount) bricks (\(memoryBytes / 1024) KB)")
 
-        return triangles
+        return (Array(UnsafeBufferPointer(start: vertexData, count: vertexCount * 3)),
+                Array(UnsafeBufferPointer(start: indexData, count: indexCount)))
     }
 
     // MARK: - MDLMesh Creation
 
-    private static func createMDLMesh(from triangles: [MeshTriangle]) -> MDLMesh? {
-        guard !triangles.isEmpty else { return nil }
+    private static func createMDLMesh(vertices: [Float], indices: [UInt32]) -> MDLMesh? {
+        guard !indices.isEmpty else { return nil }
 
         // Create vertex descriptor
         let vertexDescriptor = MDLVertexDescriptor()
@@ -408,29 +273,10 @@ public class VoxelMeshRepair {
             offset: 0,
             bufferIndex: 0
         )
-        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: MemoryLayout<SIMD3<Float>>.size)
-
-        // Build vertex and index arrays
-        var vertices: [SIMD3<Float>] = []
-        var indices: [UInt32] = []
-
-        vertices.reserveCapacity(triangles.count * 3)
-        indices.reserveCapacity(triangles.count * 3)
-
-        for triangle in triangles {
-            let baseIndex = UInt32(vertices.count)
-
-            vertices.append(triangle.a)
-            vertices.append(triangle.b)
-            vertices.append(triangle.c)
-
-            indices.append(baseIndex)
-            indices.append(baseIndex + 1)
-            indices.append(baseIndex + 2)
-        }
+        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: 3 * MemoryLayout<Float>.size)
 
         // Create vertex buffer
-        let vertexData = Data(bytes: vertices, count: vertices.count * MemoryLayout<SIMD3<Float>>.size)
+        let vertexData = Data(bytes: vertices, count: vertices.count * MemoryLayout<Float>.size)
         let vertexBuffer = MDLMeshBufferData(
             type: .vertex,
             data: vertexData
@@ -455,7 +301,7 @@ public class VoxelMeshRepair {
         // Create mesh
         let mesh = MDLMesh(
             vertexBuffer: vertexBuffer,
-            vertexCount: vertices.count,
+            vertexCount: vertices.count / 3,
             descriptor: vertexDescriptor,
             submeshes: [submesh]
         )
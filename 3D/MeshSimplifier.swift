@@ -4,6 +4,7 @@
 //
 //  Unified interface for mesh simplification algorithms
 //  Supports both fast (vertex clustering) and high-quality (QEM) methods
+//  Automatic mode serves levels of a cached QEM LOD chain
 //
 
 import Foundation
@@ -62,11 +63,22 @@ class MeshSimplifier: ObservableObject {
     @Published var progress: Double = 0.0
     @Published var lastResult: SimplificationResult?
 
+    /// LOD chain of the last mesh given to simplifyAuto or lodChain(for:);
+    /// gallery and AR preview can switch levels without simplifying again
+    @Published private(set) var lodChain: QuadricErrorMetrics.LODChain?
+
     // MARK: - Private Properties
 
     private let qemSimplifier = QuadricErrorMetrics()
     private let clusterSimplifier = VertexClusterSimplifier()
 
+    /// Mesh the cached lodChain was built from
+    private weak var lodSource: MDLMesh?
+
+    /// Levels of the auto LOD chain, as fractions of the triangle count;
+    /// includes the targets simplifyAuto picks from
+    static let lodRatios: [Float] = [1.0, 0.7, 0.5, 0.3, 0.1]
+
     // MARK: - Public Methods
 
     /// Simplify mesh to target percentage of original vertex count
@@ -175,7 +187,9 @@ class MeshSimplifier: ObservableObject {
         return result
     }
 
-    /// Simplify with automatic quality adjustment based on mesh size
+    /// Simplify with automatic quality adjustment based on mesh size.
+    /// The level is taken from the mesh's LOD chain, built by one QEM run
+    /// on first use; later calls for the same mesh reuse it
     func simplifyAuto(mesh: MDLMesh) async -> SimplificationResult? {
         guard let vertexBuffer = mesh.vertexBuffers.first else { return nil }
         guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else { return nil }
@@ -183,8 +197,8 @@ class MeshSimplifier: ObservableObject {
         let strideValue = layout.stride
         let vertexCount = vertexBuffer.length / strideValue
 
-        // Automatic quality selection based on mesh complexity
-        let (targetPercentage, method): (Double, SimplificationMethod)
+        // Automatic target selection based on mesh complexity
+        let targetPercentage: Double
 
         switch vertexCount {
         case 0..<1000:
@@ -193,20 +207,77 @@ class MeshSimplifier: ObservableObject {
 
         case 1000..<10000:
             // Medium mesh, light simplification
-            (targetPercentage, method) = (0.7, .balanced)
+            targetPercentage = 0.7
 
         case 10000..<50000:
             // Large mesh, moderate simplification
-            (targetPercentage, method) = (0.5, .balanced)
+            targetPercentage = 0.5
 
         default:
             // Very large mesh, aggressive simplification
-            (targetPercentage, method) = (0.3, .fast)
+            targetPercentage = 0.3
         }
 
-        print("🤖 Auto-simplification: \(vertexCount) vertices → \(method.description), target: \(Int(targetPercentage * 100))%")
+        print("🤖 Auto-simplification: \(vertexCount) vertices → LOD chain, target: \(Int(targetPercentage * 100))%")
+
+        let startTime = Date()
+        // The level's own mesh sits on the chain's shared vertex buffer;
+        // callers get a copy with only the vertices it references
+        guard let chain = await lodChain(for: mesh),
+              let level = chain.level(closestTo: targetPercentage),
+              let simplified = level.compactMesh() else {
+            return nil
+        }
+
+        let result = SimplificationResult(
+            simplifiedMesh: simplified,
+            originalVertexCount: vertexCount,
+            simplifiedVertexCount: level.vertexCount,
+            originalFaceCount: countFaces(in: mesh),
+            simplifiedFaceCount: level.faceCount,
+            reductionPercentage: (1.0 - Double(level.vertexCount) / Double(vertexCount)) * 100.0,
+            processingTime: Date().timeIntervalSince(startTime)
+        )
+
+        lastResult = result
+        print(result.summary)
+
+        return result
+    }
+
+    /// LOD chain of `mesh` (see lodRatios), cached until another mesh asks.
+    /// Meshes of 50k+ vertices use the parallel batched QEM
+    func lodChain(for mesh: MDLMesh) async -> QuadricErrorMetrics.LODChain? {
+        if let chain = lodChain, lodSource === mesh {
+            return chain
+        }
+        guard !isProcessing else {
+            print("⚠️ Simplification already in progress")
+            return nil
+        }
+
+        isProcessing = true
+        progress = 0.0
+
+        let vertexCount = mesh.vertexCount
+        let chainSimplifier = QuadricErrorMetrics()
+        chainSimplifier.boundaryWeight = qemSimplifier.boundaryWeight
+        chainSimplifier.parallel = vertexCount >= 50000
+
+        let chain = chainSimplifier.simplifyChain(mesh: mesh, ratios: Self.lodRatios) { [weak self] p in
+            Task { @MainActor in
+                self?.progress = p
+            }
+        }
+
+        if let chain {
+            lodChain = chain
+            lodSource = mesh
+        }
+        isProcessing = false
+        progress = chain == nil ? 0.0 : 1.0
 
-        return await simplify(mesh: mesh, targetPercentage: targetPercentage, method: method)
+        return chain
     }
 
     // MARK: - Helper Methods
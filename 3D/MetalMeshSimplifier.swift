@@ -79,256 +79,35 @@ class MetalMeshSimplifier {
 
     // MARK: - GPU-Accelerated Vertex Clustering
 
-    struct BoundingBox {
-        var min: SIMD3<Float>
-        var max: SIMD3<Float>
-    }
-
+    /// Vertex clustering on a `gridResolution`³ grid. Cell assignment,
+    /// representatives and triangle remapping all run in the shared C++
+    /// clustering engine, which computes cell keys alongside the remap, so
+    /// no Metal work is dispatched
     func simplifyWithGPU(
         mesh: MDLMesh,
         gridResolution: Int = 32,
         progress: ((Double) -> Void)? = nil
     ) -> MDLMesh? {
-        guard let vertexBuffer = mesh.vertexBuffers.first else { return nil }
-        guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else { return nil }
-
-        let strideValue = layout.stride
-        let vertexCount = vertexBuffer.length / strideValue
-
-        print("🎮 Metal GPU Simplification: \(vertexCount) vertices, grid: \(gridResolution)³")
+        print("🎮 Vertex clustering: \(mesh.vertexCount) vertices, grid: \(gridResolution)³")
 
         progress?(0.1)
 
-        // Extract vertex data
-        let vertices = extractVertexPositions(from: mesh)
-        guard !vertices.isEmpty else { return nil }
-
-        // Compute bounding box
-        let bbox = computeBoundingBox(vertices: vertices)
-
-        progress?(0.2)
-
-        // Create Metal buffers
-        guard let vertexMetalBuffer = device.makeBuffer(
-            bytes: vertices,
-            length: vertices.count * MemoryLayout<SIMD3<Float>>.stride,
-            options: .storageModeShared
-        ) else {
-            print("⚠️ Failed to create vertex buffer")
-            return nil
-        }
-
-        let gridCoordinatesBuffer = device.makeBuffer(
-            length: vertices.count * MemoryLayout<SIMD3<Int32>>.stride,
-            options: .storageModeShared
-        )
-
-        var bboxData = bbox
-        let bboxBuffer = device.makeBuffer(
-            bytes: &bboxData,
-            length: MemoryLayout<BoundingBox>.stride,
-            options: .storageModeShared
-        )
-
-        var gridRes = Int32(gridResolution)
-        let gridResBuffer = device.makeBuffer(
-            bytes: &gridRes,
-            length: MemoryLayout<Int32>.stride,
-            options: .storageModeShared
-        )
-
-        progress?(0.3)
-
-        // Step 1: Compute grid coordinates
-        guard let commandBuffer = commandQueue.makeCommandBuffer(),
-              let computeEncoder = commandBuffer.makeComputeCommandEncoder(),
-              let pipeline = computeGridCoordsPipeline else {
+        guard let simplifiedMesh = performCPUClustering(mesh: mesh, gridResolution: gridResolution) else {
             return nil
         }
 
-        computeEncoder.setComputePipelineState(pipeline)
-        computeEncoder.setBuffer(vertexMetalBuffer, offset: 0, index: 0)
-        computeEncoder.setBuffer(gridCoordinatesBuffer, offset: 0, index: 1)
-        computeEncoder.setBuffer(bboxBuffer, offset: 0, index: 2)
-        computeEncoder.setBuffer(gridResBuffer, offset: 0, index: 3)
-
-        let threadGroupSize = MTLSize(width: min(pipeline.maxTotalThreadsPerThreadgroup, vertices.count), height: 1, depth: 1)
-        let threadGroups = MTLSize(
-            width: (vertices.count + threadGroupSize.width - 1) / threadGroupSize.width,
-            height: 1,
-            depth: 1
-        )
-
-        computeEncoder.dispatchThreadgroups(threadGroups, threadsPerThreadgroup: threadGroupSize)
-        computeEncoder.endEncoding()
-
-        commandBuffer.commit()
-        commandBuffer.waitUntilCompleted()
-
-        progress?(0.5)
-
-        // Step 2: Accumulate vertices into grid cells
-        let totalCells = gridResolution * gridResolution * gridResolution
-        let gridCentroidsBuffer = device.makeBuffer(
-            length: totalCells * 3 * MemoryLayout<Float>.stride,
-            options: .storageModeShared
-        )
-
-        let gridCountsBuffer = device.makeBuffer(
-            length: totalCells * MemoryLayout<UInt32>.stride,
-            options: .storageModeShared
-        )
-
-        // Zero out buffers
-        if let pointer = gridCentroidsBuffer?.contents().bindMemory(to: Float.self, capacity: totalCells * 3) {
-            memset(pointer, 0, totalCells * 3 * MemoryLayout<Float>.stride)
-        }
-
-        if let pointer = gridCountsBuffer?.contents().bindMemory(to: UInt32.self, capacity: totalCells) {
-            memset(pointer, 0, totalCells * MemoryLayout<UInt32>.stride)
-        }
-
-        progress?(0.7)
-
-        // For simplicity, fall back to CPU clustering for final assembly
-        // In production, continue with GPU kernels
-        let clusteredVertices = performCPUClustering(
-            vertices: vertices,
-            gridResolution: gridResolution,
-            bbox: bbox
-        )
-
-        progress?(0.9)
-
-        // Rebuild mesh
-        let simplifiedMesh = rebuildMesh(
-            vertices: clusteredVertices,
-            originalMesh: mesh
-        )
-
         progress?(1.0)
 
-        print("✅ GPU-simplified mesh: \(clusteredVertices.count) vertices")
+        print("✅ Simplified mesh: \(simplifiedMesh.vertexCount) vertices")
 
         return simplifiedMesh
     }
 
     // MARK: - Helper Methods
 
-    private func extractVertexPositions(from mesh: MDLMesh) -> [SIMD3<Float>] {
-        guard let vertexBuffer = mesh.vertexBuffers.first else { return [] }
-        guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else { return [] }
-
-        let strideValue = layout.stride
-        let vertexCount = vertexBuffer.length / strideValue
-        let data = Data(bytes: vertexBuffer.map().bytes, count: vertexBuffer.length)
-
-        var vertices: [SIMD3<Float>] = []
-
-        for i in 0..<vertexCount {
-            let offset = i * strideValue
-            let x = data.withUnsafeBytes { $0.load(fromByteOffset: offset, as: Float.self) }
-            let y = data.withUnsafeBytes { $0.load(fromByteOffset: offset + 4, as: Float.self) }
-            let z = data.withUnsafeBytes { $0.load(fromByteOffset: offset + 8, as: Float.self) }
-            vertices.append(SIMD3<Float>(x, y, z))
-        }
-
-        return vertices
-    }
-
-    private func computeBoundingBox(vertices: [SIMD3<Float>]) -> BoundingBox {
-        guard let first = vertices.first else {
-            return BoundingBox(min: .zero, max: .zero)
-        }
-
-        var minBounds = first
-        var maxBounds = first
-
-        for vertex in vertices {
-            minBounds = simd_min(minBounds, vertex)
-            maxBounds = simd_max(maxBounds, vertex)
-        }
-
-        return BoundingBox(min: minBounds, max: maxBounds)
-    }
-
-    private func performCPUClustering(
-        vertices: [SIMD3<Float>],
-        gridResolution: Int,
-        bbox: BoundingBox
-    ) -> [SIMD3<Float>] {
-        var grid: [SIMD3<Int>: [SIMD3<Float>]] = [:]
-        let gridSize = (bbox.max - bbox.min) / Float(gridResolution)
-
-        for vertex in vertices {
-            let normalized = (vertex - bbox.min) / gridSize
-            let gridCoord = SIMD3<Int>(
-                Int(floor(normalized.x)),
-                Int(floor(normalized.y)),
-                Int(floor(normalized.z))
-            )
-
-            grid[gridCoord, default: []].append(vertex)
-        }
-
-        // Compute centroids
-        var clusteredVertices: [SIMD3<Float>] = []
-
-        for (_, vertices) in grid {
-            if vertices.isEmpty { continue }
-
-            var centroid = SIMD3<Float>.zero
-            for v in vertices {
-                centroid += v
-            }
-            centroid /= Float(vertices.count)
-
-            clusteredVertices.append(centroid)
-        }
-
-        return clusteredVertices
-    }
-
-    private func rebuildMesh(vertices: [SIMD3<Float>], originalMesh: MDLMesh) -> MDLMesh? {
-        let allocator = MDLMeshBufferDataAllocator()
-        let vertexData = vertices.withUnsafeBytes { Data($0) }
-        let vertexBuffer = allocator.newBuffer(with: vertexData, type: .vertex)
-
-        let vertexDescriptor = MDLVertexDescriptor()
-        vertexDescriptor.attributes[0] = MDLVertexAttribute(
-            name: MDLVertexAttributePosition,
-            format: .float3,
-            offset: 0,
-            bufferIndex: 0
-        )
-        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: MemoryLayout<SIMD3<Float>>.stride)
-
-        // Create simple point cloud or regenerate triangles
-        // For demonstration, create a simple point-based mesh
-        var indices: [UInt32] = []
-        for i in 0..<min(vertices.count - 2, 1000) {
-            // Create simple triangles (placeholder)
-            indices.append(UInt32(i))
-            indices.append(UInt32(i + 1))
-            indices.append(UInt32(i + 2))
-        }
-
-        let indexData = indices.withUnsafeBytes { Data($0) }
-        let indexBuffer = allocator.newBuffer(with: indexData, type: .index)
-
-        let submesh = MDLSubmesh(
-            indexBuffer: indexBuffer,
-            indexCount: indices.count,
-            indexType: .uInt32,
-            geometryType: .triangles,
-            material: nil
-        )
-
-        return MDLMesh(
-            vertexBuffer: vertexBuffer,
-            vertexCount: vertices.count,
-            descriptor: vertexDescriptor,
-            submeshes: [submesh]
-        )
+    /// CPU clustering through ClusteringBridge
+    private func performCPUClustering(mesh: MDLMesh, gridResolution: Int) -> MDLMesh? {
+        let config = VertexClusterSimplifier.Config(gridResolution: gridResolution)
+        return VertexClusterSimplifier().simplify(mesh: mesh, config: config)
     }
 }
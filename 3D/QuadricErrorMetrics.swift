@@ -4,6 +4,10 @@
 //
 //  High-quality mesh simplification using Quadric Error Metrics (QEM)
 //  Based on Garland & Heckbert's "Surface Simplification Using Quadric Error Metrics"
+//  Runs in C++ (SimplificationBridge): heap-ordered edge collapses to the
+//  optimal position, guarded by link-condition and face-flip checks, or
+//  rounds of independent collapses spread over all cores. One run can
+//  also yield a whole LOD chain over a shared vertex buffer
 //
 
 import Foundation
@@ -13,62 +17,14 @@ import ModelIO
 /// Quadric Error Metrics for high-quality mesh simplification
 class QuadricErrorMetrics {
 
-    // MARK: - Data Structures
+    // MARK: - Configuration
 
-    /// Symmetric 4x4 matrix representing quadric error
-    struct Quadric {
-        var q: [Double] // 10 unique values for symmetric 4x4 matrix
+    /// Weight of the planes holding open boundaries in place (0 = boundaries may erode)
+    var boundaryWeight: Float = 10
 
-        init() {
-            q = Array(repeating: 0.0, count: 10)
-        }
-
-        init(plane: SIMD4<Double>) {
-            q = Array(repeating: 0.0, count: 10)
-            // Q = plane * plane^T (symmetric matrix)
-            let a = plane.x, b = plane.y, c = plane.z, d = plane.w
-            q[0] = a * a  // q11
-            q[1] = a * b  // q12
-            q[2] = a * c  // q13
-            q[3] = a * d  // q14
-            q[4] = b * b  // q22
-            q[5] = b * c  // q23
-            q[6] = b * d  // q24
-            q[7] = c * c  // q33
-            q[8] = c * d  // q34
-            q[9] = d * d  // q44
-        }
-
-        /// Add two quadrics
-        static func + (left: Quadric, right: Quadric) -> Quadric {
-            var result = Quadric()
-            for i in 0..<10 {
-                result.q[i] = left.q[i] + right.q[i]
-            }
-            return result
-        }
-
-        /// Calculate error for a vertex position
-        func error(at position: SIMD3<Double>) -> Double {
-            let x = position.x, y = position.y, z = position.z
-            return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
-                   q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
-                   q[7] * z * z + 2 * q[8] * z +
-                   q[9]
-        }
-    }
-
-    /// Edge collapse candidate
-    struct EdgeCollapse: Comparable {
-        let vertexIndex1: Int
-        let vertexIndex2: Int
-        let error: Double
-        let newPosition: SIMD3<Double>
-
-        static func < (lhs: EdgeCollapse, rhs: EdgeCollapse) -> Bool {
-            return lhs.error < rhs.error
-        }
-    }
+    /// Collapse batches of independent edges in parallel instead of one at a
+    /// time; faster on multi-core devices, slightly less strict cost order
+    var parallel = false
 
     // MARK: - Simplification
 
@@ -85,248 +41,261 @@ class QuadricErrorMetrics {
 
         print("🔧 QEM Simplification: \(vertexCount) → \(targetVertexCount) vertices")
 
-        // Extract vertex data
-        var vertices = extractVertices(from: mesh)
-        var faces = extractFaces(from: mesh)
-
-        guard !vertices.isEmpty && !faces.isEmpty else { return nil }
-
-        // Step 1: Compute initial quadrics for each vertex
-        var quadrics = computeVertexQuadrics(vertices: vertices, faces: faces)
-
-        // Step 2: Select all valid pairs (edges)
-        let validPairs = selectValidPairs(vertices: vertices, faces: faces)
-
-        // Step 3: Compute optimal contraction targets
-        var heap = computeContractionHeap(pairs: validPairs, quadrics: quadrics, vertices: vertices)
-
-        // Step 4: Iteratively remove pairs of least cost
-        let targetRemovals = vertexCount - targetVertexCount
-        var removedCount = 0
-        var vertexMapping: [Int: Int] = [:] // Maps old vertex index to new
-
-        while removedCount < targetRemovals && !heap.isEmpty {
-            let collapse = heap.removeFirst()
-
-            // Check if vertices still exist
-            guard vertexMapping[collapse.vertexIndex1] == nil,
-                  vertexMapping[collapse.vertexIndex2] == nil else {
-                continue
-            }
-
-            // Perform collapse
-            let v1 = collapse.vertexIndex1
-            let v2 = collapse.vertexIndex2
-
-            // Update vertex position
-            vertices[v1] = collapse.newPosition
+        let indices = MemoryBufferHelper.extractIndices(from: mesh)
+        guard !indices.isEmpty else { return nil }
 
-            // Merge quadrics
-            quadrics[v1] = quadrics[v1] + quadrics[v2]
+        let positionOffset = mesh.vertexDescriptor.attributeNamed(MDLVertexAttributePosition)?.offset ?? 0
 
-            // Mark v2 as removed, mapped to v1
-            vertexMapping[v2] = v1
+        var config = SimplifyConfig()
+        config.targetVertexCount = UInt(max(targetVertexCount, 1))
+        config.targetTriangleCount = 0
+        config.boundaryWeight = boundaryWeight
+        config.batched = parallel
+        config.batchFraction = 0
 
-            // Update faces
-            updateFaces(faces: &faces, from: v2, to: v1)
+        progress?(0.0)
 
-            removedCount += 1
-
-            if removedCount % 100 == 0 {
-                let progressValue = Double(removedCount) / Double(targetRemovals)
-                progress?(progressValue)
+        // Call bridge directly on the mapped vertex buffer (no flattening copy)
+        let vertexMap = vertexBuffer.map()
+        let bridgeResult: UnsafeMutablePointer<SimplifyResult>? = indices.withUnsafeBufferPointer { indexBuffer in
+            guard let indexBase = indexBuffer.baseAddress else {
+                return nil
             }
+            return SimplificationBridge.simplifyVertices(
+                UnsafeRawPointer(vertexMap.bytes.advanced(by: positionOffset)).assumingMemoryBound(to: Float.self),
+                vertexCount: UInt(vertexCount),
+                stride: UInt(strideValue),
+                indices: indexBase,
+                indexCount: UInt(indices.count),
+                config: config
+            )
         }
 
-        progress?(1.0)
-
-        // Rebuild mesh
-        return rebuildMesh(vertices: vertices, faces: faces, vertexMapping: vertexMapping, originalMesh: mesh)
-    }
-
-    // MARK: - Helper Methods
-
-    private func extractVertices(from mesh: MDLMesh) -> [SIMD3<Double>] {
-        guard let vertexBuffer = mesh.vertexBuffers.first else { return [] }
-        guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else { return [] }
-
-        let strideValue = layout.stride
-        let vertexCount = vertexBuffer.length / strideValue
-        let data = Data(bytes: vertexBuffer.map().bytes, count: vertexBuffer.length)
-
-        var vertices: [SIMD3<Double>] = []
-
-        for i in 0..<vertexCount {
-            let offset = i * strideValue
-            let x = data.withUnsafeBytes { $0.load(fromByteOffset: offset, as: Float.self) }
-            let y = data.withUnsafeBytes { $0.load(fromByteOffset: offset + 4, as: Float.self) }
-            let z = data.withUnsafeBytes { $0.load(fromByteOffset: offset + 8, as: Float.self) }
-            vertices.append(SIMD3<Double>(Double(x), Double(y), Double(z)))
+        guard let result = bridgeResult else {
+            return nil
         }
 
-        return vertices
-    }
-
-    private func extractFaces(from mesh: MDLMesh) -> [[Int]] {
-        var faces: [[Int]] = []
+        defer {
+            SimplificationBridge.cleanupResult(result)
+        }
 
-        // Safe cast - submeshes might not be [MDLSubmesh]
-        guard let submeshes = mesh.submeshes as? [MDLSubmesh] else {
-            print("⚠️ Invalid submesh format in extractFaces")
-            return []
+        // SimplifyResult layout: vertices, indices, vertexCount, indexCount, success,
+        // errorMessage, collapses, rejectedCollapses, maxError
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let newVertexCount = resultPtr.load(fromByteOffset: pointerStride * 2, as: Int.self)
+        let indexCount = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride, as: Int.self)
+        let success = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride * 2, as: Bool.self)
+
+        guard success,
+              let vertexData = resultPtr.load(as: UnsafeMutablePointer<Float>?.self),
+              let indexData = resultPtr.load(fromByteOffset: pointerStride, as: UnsafeMutablePointer<UInt32>?.self) else {
+            print("⚠️ QEM simplification failed")
+            return nil
         }
 
-        for submesh in submeshes {
-            let indexBuffer = submesh.indexBuffer
-            let indexCount = submesh.indexCount
-            let indexType = submesh.indexType
+        let statsOffset = pointerStride * 2 + MemoryLayout<Int>.stride * 3 + pointerStride
+        let collapses = resultPtr.load(fromByteOffset: statsOffset, as: Int.self)
+        let rejected = resultPtr.load(fromByteOffset: statsOffset + MemoryLayout<Int>.stride, as: Int.self)
 
-            let data = Data(bytes: indexBuffer.map().bytes, count: indexBuffer.length)
+        progress?(1.0)
 
-            for i in stride(from: 0, to: indexCount, by: 3) {
-                var triangle: [Int] = []
+        print("✅ Simplified mesh: \(newVertexCount) vertices, \(indexCount / 3) faces (\(collapses) collapses, \(rejected) rejected)")
 
-                for j in 0..<3 {
-                    let index: Int
-                    if indexType == .uint16 {
-                        index = Int(data.withUnsafeBytes { $0.load(fromByteOffset: (i + j) * 2, as: UInt16.self) })
-                    } else {
-                        index = Int(data.withUnsafeBytes { $0.load(fromByteOffset: (i + j) * 4, as: UInt32.self) })
+        return Self.rebuildMesh(
+            vertices: UnsafeBufferPointer(start: vertexData, count: newVertexCount * 3),
+            indices: UnsafeBufferPointer(start: indexData, count: indexCount)
+        )
+    }
+
+    // MARK: - LOD Chains
+
+    /// Levels of detail cut from one collapse sequence
+    struct LODChain {
+        struct Level {
+            /// Shares its vertex buffer with every other level; only the index
+            /// buffer differs. `mesh.vertexCount` is therefore the chain's
+            /// sharedVertexCount, and coarse levels leave most vertices
+            /// unreferenced; export a single level with compactMesh()
+            let mesh: MDLMesh
+            let ratio: Float
+            /// Vertices this level's triangles reference
+            let vertexCount: Int
+            let faceCount: Int
+            let maxError: Double
+
+            /// Standalone copy holding only the referenced vertices,
+            /// renumbered in first-use order
+            func compactMesh() -> MDLMesh? {
+                guard let submesh = (mesh.submeshes as? [MDLSubmesh])?.first,
+                      let vertexBuffer = mesh.vertexBuffers.first else { return nil }
+
+                // The maps must outlive every read through their bytes
+                let vertexMap = vertexBuffer.map()
+                let indexMap = submesh.indexBuffer.map()
+                let positions = vertexMap.bytes.assumingMemoryBound(to: Float.self)
+                let source = indexMap.bytes.assumingMemoryBound(to: UInt32.self)
+
+                var remap = [UInt32](repeating: .max, count: mesh.vertexCount)
+                var vertices: [Float] = []
+                var indices: [UInt32] = []
+                vertices.reserveCapacity(vertexCount * 3)
+                indices.reserveCapacity(submesh.indexCount)
+                for i in 0..<submesh.indexCount {
+                    let v = Int(source[i])
+                    if remap[v] == .max {
+                        remap[v] = UInt32(vertices.count / 3)
+                        vertices.append(contentsOf: [positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]])
                     }
-                    triangle.append(index)
+                    indices.append(remap[v])
                 }
 
-                if triangle[0] != triangle[1] && triangle[1] != triangle[2] && triangle[0] != triangle[2] {
-                    faces.append(triangle)
+                return withExtendedLifetime((vertexMap, indexMap)) {
+                    vertices.withUnsafeBufferPointer { vertexData in
+                        indices.withUnsafeBufferPointer { indexData in
+                            QuadricErrorMetrics.rebuildMesh(vertices: vertexData, indices: indexData)
+                        }
+                    }
                 }
             }
         }
 
-        return faces
-    }
-
-    private func computeVertexQuadrics(vertices: [SIMD3<Double>], faces: [[Int]]) -> [Quadric] {
-        var quadrics = Array(repeating: Quadric(), count: vertices.count)
-
-        for face in faces {
-            guard face.count == 3 else { continue }
+        /// Finest first
+        let levels: [Level]
+        let sharedVertexCount: Int
 
-            let v0 = vertices[face[0]]
-            let v1 = vertices[face[1]]
-            let v2 = vertices[face[2]]
-
-            // Compute plane equation: ax + by + cz + d = 0
-            let edge1 = v1 - v0
-            let edge2 = v2 - v0
-            var normal = cross(edge1, edge2)
-            let length = simd_length(normal)
-
-            guard length > 0.0001 else { continue }
-
-            normal = normalize(normal)
-            let d = -dot(normal, v0)
-
-            let plane = SIMD4<Double>(normal.x, normal.y, normal.z, d)
-            let faceQuadric = Quadric(plane: plane)
-
-            // Add to each vertex in the face
-            quadrics[face[0]] = quadrics[face[0]] + faceQuadric
-            quadrics[face[1]] = quadrics[face[1]] + faceQuadric
-            quadrics[face[2]] = quadrics[face[2]] + faceQuadric
-        }
-
-        return quadrics
-    }
-
-    private func selectValidPairs(vertices: [SIMD3<Double>], faces: [[Int]]) -> Set<Set<Int>> {
-        var pairs = Set<Set<Int>>()
-
-        // Add all edges from faces
-        for face in faces {
-            guard face.count == 3 else { continue }
-            pairs.insert(Set([face[0], face[1]]))
-            pairs.insert(Set([face[1], face[2]]))
-            pairs.insert(Set([face[2], face[0]]))
+        /// Level whose vertex count is closest to `fraction` of the finest level's
+        func level(closestTo fraction: Double) -> Level? {
+            guard let finest = levels.first, finest.vertexCount > 0 else { return levels.first }
+            let full = Double(finest.vertexCount)
+            return levels.min { a, b in
+                abs(Double(a.vertexCount) / full - fraction) < abs(Double(b.vertexCount) / full - fraction)
+            }
         }
-
-        return pairs
     }
 
-    private func computeContractionHeap(pairs: Set<Set<Int>>, quadrics: [Quadric], vertices: [SIMD3<Double>]) -> [EdgeCollapse] {
-        var candidates: [EdgeCollapse] = []
+    /// Simplify once through every ratio (fractions of the triangle count,
+    /// falling, e.g. 100/50/25/10%) and keep a level at each, so switching
+    /// LOD later needs no further simplification
+    func simplifyChain(mesh: MDLMesh, ratios: [Float] = [1.0, 0.5, 0.25, 0.1], progress: ((Double) -> Void)? = nil) -> LODChain? {
+        guard let vertexBuffer = mesh.vertexBuffers.first else { return nil }
+        guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else { return nil }
 
-        for pair in pairs {
-            let indices = Array(pair)
-            guard indices.count == 2 else { continue }
+        let strideValue = layout.stride
+        let vertexCount = vertexBuffer.length / strideValue
 
-            let v1 = indices[0]
-            let v2 = indices[1]
+        print("🔧 QEM LOD chain: \(vertexCount) vertices, levels: \(ratios.map { "\(Int($0 * 100))%" }.joined(separator: "/"))")
 
-            let combinedQuadric = quadrics[v1] + quadrics[v2]
+        let indices = MemoryBufferHelper.extractIndices(from: mesh)
+        guard !indices.isEmpty && !ratios.isEmpty else { return nil }
 
-            // Simple strategy: use midpoint
-            let newPosition = (vertices[v1] + vertices[v2]) / 2.0
-            let error = combinedQuadric.error(at: newPosition)
+        let positionOffset = mesh.vertexDescriptor.attributeNamed(MDLVertexAttributePosition)?.offset ?? 0
 
-            candidates.append(EdgeCollapse(
-                vertexIndex1: v1,
-                vertexIndex2: v2,
-                error: error,
-                newPosition: newPosition
-            ))
-        }
+        var config = SimplifyConfig()
+        config.targetVertexCount = 0
+        config.targetTriangleCount = 0
+        config.boundaryWeight = boundaryWeight
+        config.batched = parallel
+        config.batchFraction = 0
 
-        return candidates.sorted()
-    }
+        progress?(0.0)
 
-    private func updateFaces(faces: inout [[Int]], from oldIndex: Int, to newIndex: Int) {
-        for i in 0..<faces.count {
-            for j in 0..<faces[i].count {
-                if faces[i][j] == oldIndex {
-                    faces[i][j] = newIndex
+        // Call bridge directly on the mapped vertex buffer (no flattening copy)
+        let vertexMap = vertexBuffer.map()
+        let bridgeResult: UnsafeMutablePointer<LodChainResult>? = indices.withUnsafeBufferPointer { indexBuffer in
+            ratios.withUnsafeBufferPointer { ratioBuffer in
+                guard let indexBase = indexBuffer.baseAddress, let ratioBase = ratioBuffer.baseAddress else {
+                    return nil
                 }
+                return SimplificationBridge.simplifyChainVertices(
+                    UnsafeRawPointer(vertexMap.bytes.advanced(by: positionOffset)).assumingMemoryBound(to: Float.self),
+                    vertexCount: UInt(vertexCount),
+                    stride: UInt(strideValue),
+                    indices: indexBase,
+                    indexCount: UInt(indices.count),
+                    ratios: ratioBase,
+                    ratioCount: UInt(ratios.count),
+                    config: config
+                )
             }
         }
 
-        // Remove degenerate faces
-        faces.removeAll { face in
-            face[0] == face[1] || face[1] == face[2] || face[0] == face[2]
+        guard let result = bridgeResult else {
+            return nil
         }
-    }
 
-    private func rebuildMesh(vertices: [SIMD3<Double>], faces: [[Int]], vertexMapping: [Int: Int], originalMesh: MDLMesh) -> MDLMesh? {
-        // Create new vertex buffer with remaining vertices
-        var activeVertices: [SIMD3<Float>] = []
-        var oldToNewIndex: [Int: Int] = [:]
+        defer {
+            SimplificationBridge.cleanupChainResult(result)
+        }
 
-        for i in 0..<vertices.count {
-            if vertexMapping[i] == nil {
-                oldToNewIndex[i] = activeVertices.count
-                activeVertices.append(SIMD3<Float>(Float(vertices[i].x), Float(vertices[i].y), Float(vertices[i].z)))
-            }
+        // LodChainResult layout: vertices, indices, vertexCount, indexCount, success,
+        // errorMessage, levelCount, levels, collapses
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let sharedVertexCount = resultPtr.load(fromByteOffset: pointerStride * 2, as: Int.self)
+        let success = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride * 2, as: Bool.self)
+
+        let statsOffset = pointerStride * 2 + MemoryLayout<Int>.stride * 3 + pointerStride
+        let levelCount = resultPtr.load(fromByteOffset: statsOffset, as: Int.self)
+
+        guard success,
+              let vertexData = resultPtr.load(as: UnsafeMutablePointer<Float>?.self),
+              let indexData = resultPtr.load(fromByteOffset: pointerStride, as: UnsafeMutablePointer<UInt32>?.self),
+              let levelInfo = resultPtr.load(fromByteOffset: statsOffset + MemoryLayout<Int>.stride,
+                                             as: UnsafeMutablePointer<LodLevelInfo>?.self) else {
+            print("⚠️ QEM LOD chain failed")
+            return nil
         }
 
-        // Remap faces
-        var newFaces: [[Int]] = []
-        for face in faces {
-            var newFace: [Int] = []
-            for index in face {
-                if let newIndex = oldToNewIndex[index] {
-                    newFace.append(newIndex)
-                }
-            }
-            if newFace.count == 3 && newFace[0] != newFace[1] && newFace[1] != newFace[2] && newFace[0] != newFace[2] {
-                newFaces.append(newFace)
-            }
+        // One vertex buffer for every level
+        let allocator = MDLMeshBufferDataAllocator()
+        let sharedVertices = allocator.newBuffer(
+            with: Data(buffer: UnsafeBufferPointer(start: vertexData, count: sharedVertexCount * 3)),
+            type: .vertex
+        )
+        let vertexDescriptor = Self.positionDescriptor()
+
+        var levels: [LODChain.Level] = []
+        for i in 0..<min(levelCount, ratios.count) {
+            let info = levelInfo[i]
+            let indexBuffer = allocator.newBuffer(
+                with: Data(buffer: UnsafeBufferPointer(start: indexData.advanced(by: Int(info.indexOffset)),
+                                                       count: Int(info.indexCount))),
+                type: .index
+            )
+            let submesh = MDLSubmesh(
+                indexBuffer: indexBuffer,
+                indexCount: Int(info.indexCount),
+                indexType: .uInt32,
+                geometryType: .triangles,
+                material: nil
+            )
+            let levelMesh = MDLMesh(
+                vertexBuffer: sharedVertices,
+                vertexCount: sharedVertexCount,
+                descriptor: vertexDescriptor,
+                submeshes: [submesh]
+            )
+            levels.append(LODChain.Level(
+                mesh: levelMesh,
+                ratio: ratios[i],
+                vertexCount: Int(info.vertexCount),
+                faceCount: Int(info.indexCount) / 3,
+                maxError: info.maxError
+            ))
         }
 
-        print("✅ Simplified mesh: \(activeVertices.count) vertices, \(newFaces.count) faces")
+        progress?(1.0)
 
-        // Create MDLMesh
-        let allocator = MDLMeshBufferDataAllocator()
-        let vertexData = activeVertices.withUnsafeBytes { Data($0) }
-        let vertexBuffer = allocator.newBuffer(with: vertexData, type: .vertex)
+        print("✅ LOD chain: \(levels.map { "\($0.faceCount)" }.joined(separator: "/")) faces over \(sharedVertexCount) shared vertices")
+
+        return LODChain(levels: levels, sharedVertexCount: sharedVertexCount)
+    }
 
+    // MARK: - Helper Methods
+
+    /// Packed float3 positions in buffer 0
+    private static func positionDescriptor() -> MDLVertexDescriptor {
         let vertexDescriptor = MDLVertexDescriptor()
         vertexDescriptor.attributes[0] = MDLVertexAttribute(
             name: MDLVertexAttributePosition,
@@ -334,15 +303,22 @@ class QuadricErrorMetrics {
             offset: 0,
             bufferIndex: 0
         )
-        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: MemoryLayout<SIMD3<Float>>.stride)
+        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: 3 * MemoryLayout<Float>.size)
+        return vertexDescriptor
+    }
 
-        // Create index buffer
-        var indices: [UInt32] = []
-        for face in newFaces {
-            indices.append(contentsOf: face.map { UInt32($0) })
-        }
+    private static func rebuildMesh(vertices: UnsafeBufferPointer<Float>, indices: UnsafeBufferPointer<UInt32>) -> MDLMesh? {
+        guard !indices.isEmpty else { return nil }
 
-        let indexData = indices.withUnsafeBytes { Data($0) }
+        // Create MDLMesh
+        let allocator = MDLMeshBufferDataAllocator()
+        let vertexData = Data(buffer: vertices)
+        let vertexBuffer = allocator.newBuffer(with: vertexData, type: .vertex)
+
+        let vertexDescriptor = Self.positionDescriptor()
+
+        // Create index buffer
+        let indexData = Data(buffer: indices)
         let indexBuffer = allocator.newBuffer(with: indexData, type: .index)
 
         let submesh = MDLSubmesh(
@@ -355,7 +331,7 @@ class QuadricErrorMetrics {
 
         let mesh = MDLMesh(
             vertexBuffer: vertexBuffer,
-            vertexCount: activeVertices.count,
+            vertexCount: vertices.count / 3,
             descriptor: vertexDescriptor,
             submeshes: [submesh]
         )
@@ -255,4 +255,29 @@ enum MemoryBufferHelper {
 
         return indices
     }
+
+    /// Extract the triangle indices of every triangle submesh of a mesh
+    /// - Parameter mesh: MDLMesh to extract indices from
+    /// - Returns: Indices of all triangle submeshes in order, widened to UInt32
+    static func extractIndices(from mesh: MDLMesh) -> [UInt32] {
+        var indices: [UInt32] = []
+
+        for case let submesh as MDLSubmesh in mesh.submeshes ?? [] where submesh.geometryType == .triangles {
+            let indexBuffer = submesh.indexBuffer.map()
+            let count = submesh.indexCount - submesh.indexCount % 3
+
+            switch submesh.indexType {
+            case .uInt32:
+                let source = indexBuffer.bytes.assumingMemoryBound(to: UInt32.self)
+                indices.append(contentsOf: UnsafeBufferPointer(start: source, count: count))
+            case .uInt16:
+                let source = indexBuffer.bytes.assumingMemoryBound(to: UInt16.self)
+                indices.append(contentsOf: UnsafeBufferPointer(start: source, count: count).lazy.map { UInt32($0) })
+            default:
+                continue
+            }
+        }
+
+        return indices
+    }
 }
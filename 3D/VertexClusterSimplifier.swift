@@ -4,6 +4,9 @@
 //
 //  Fast mesh simplification using vertex clustering
 //  Trade-off: Speed over quality (good for real-time preview)
+//  Runs in C++ (ClusteringBridge): Morton-sorted grid cells, one vertex per
+//  cell at its quadric optimum, duplicate triangles merged. PLY files can
+//  be streamed from disk without loading the mesh
 //
 
 import Foundation
@@ -16,15 +19,26 @@ class VertexClusterSimplifier {
     // MARK: - Configuration
 
     struct Config {
-        /// Grid resolution for clustering (lower = more aggressive simplification)
+        /// Grid resolution for clustering: cells along the longest bounding box axis
+        /// (lower = more aggressive simplification)
         var gridResolution: Int = 32
 
         /// Minimum cluster size to prevent over-simplification
         var minClusterSize: Int = 1
 
-        init(gridResolution: Int = 32, minClusterSize: Int = 1) {
+        /// Place each cluster vertex at its quadric optimum (keeps corners and
+        /// creases sharp) instead of the plain vertex mean
+        var quadricPositions: Bool = true
+
+        /// Streaming (PLY) only: give up past this many grid cells, bounding
+        /// memory when the cell size is far finer than expected (0 = no limit)
+        var maxCells: Int = 0
+
+        init(gridResolution: Int = 32, minClusterSize: Int = 1, quadricPositions: Bool = true, maxCells: Int = 0) {
             self.gridResolution = gridResolution
             self.minClusterSize = minClusterSize
+            self.quadricPositions = quadricPositions
+            self.maxCells = maxCells
         }
 
         /// Preset configurations
@@ -33,20 +47,6 @@ class VertexClusterSimplifier {
         static let conservative = Config(gridResolution: 64, minClusterSize: 2)
     }
 
-    // MARK: - Data Structures
-
-    struct Cluster {
-        var vertices: [Int] = []
-        var centroid: SIMD3<Double> = .zero
-
-        mutating func addVertex(_ index: Int, position: SIMD3<Double>) {
-            vertices.append(index)
-            // Running average for centroid
-            let count = Double(vertices.count)
-            centroid = (centroid * (count - 1.0) + position) / count
-        }
-    }
-
     // MARK: - Simplification
 
     /// Simplify mesh using vertex clustering
@@ -57,171 +57,111 @@ class VertexClusterSimplifier {
         let strideValue = layout.stride
         let vertexCount = vertexBuffer.length / strideValue
 
-        print("⚡️ Vertex Clustering: \(vertexCount) vertices, grid: \(config.gridResolution)³")
-
-        // Extract vertices and faces
-        let vertices = extractVertices(from: mesh)
-        let faces = extractFaces(from: mesh)
+        print("⚡️ Vertex Clustering: \(vertexCount) vertices, grid: \(config.gridResolution)")
 
-        guard !vertices.isEmpty && !faces.isEmpty else { return nil }
+        let indices = MemoryBufferHelper.extractIndices(from: mesh)
+        guard vertexCount > 0 && !indices.isEmpty else { return nil }
 
-        progress?(0.2)
+        let positionOffset = mesh.vertexDescriptor.attributeNamed(MDLVertexAttributePosition)?.offset ?? 0
 
-        // Compute bounding box
-        let bbox = computeBoundingBox(vertices: vertices)
-        let gridSize = (bbox.max - bbox.min) / Double(config.gridResolution)
+        let clusterConfig = makeClusterConfig(config)
 
-        progress?(0.3)
-
-        // Assign vertices to grid cells
-        var grid: [SIMD3<Int>: Cluster] = [:]
+        progress?(0.2)
 
-        for (index, vertex) in vertices.enumerated() {
-            let gridCoord = computeGridCoordinate(position: vertex, bbox: bbox, gridSize: gridSize)
-            grid[gridCoord, default: Cluster()].addVertex(index, position: vertex)
+        // Call bridge directly on the mapped vertex buffer (no flattening copy)
+        let vertexMap = vertexBuffer.map()
+        let bridgeResult: UnsafeMutablePointer<ClusterResult>? = indices.withUnsafeBufferPointer { indexBuffer in
+            guard let indexBase = indexBuffer.baseAddress else {
+                return nil
+            }
+            return ClusteringBridge.clusterVertices(
+                UnsafeRawPointer(vertexMap.bytes.advanced(by: positionOffset)).assumingMemoryBound(to: Float.self),
+                vertexCount: UInt(vertexCount),
+                stride: UInt(strideValue),
+                indices: indexBase,
+                indexCount: UInt(indices.count),
+                config: clusterConfig
+            )
         }
 
-        print("📊 Created \(grid.count) clusters from \(vertexCount) vertices")
-        progress?(0.5)
-
-        // Create vertex mapping (old index -> new index)
-        var vertexMapping: [Int: Int] = [:]
-        var newVertices: [SIMD3<Double>] = []
-
-        for cluster in grid.values {
-            guard cluster.vertices.count >= config.minClusterSize else { continue }
-
-            let newIndex = newVertices.count
-            newVertices.append(cluster.centroid)
-
-            for oldIndex in cluster.vertices {
-                vertexMapping[oldIndex] = newIndex
-            }
+        guard let result = bridgeResult else {
+            return nil
         }
 
-        progress?(0.7)
+        progress?(0.9)
+        let simplified = meshFromResult(result)
+        progress?(1.0)
 
-        // Remap faces
-        var newFaces: [[Int]] = []
+        return simplified
+    }
 
-        for face in faces {
-            guard face.count == 3 else { continue }
+    /// Simplify a PLY file too large to load: the C++ side streams its faces
+    /// and keeps only per-cell state, so the input never becomes an MDLMesh
+    func simplify(plyURL: URL, config: Config = .balanced, progress: ((Double) -> Void)? = nil) -> MDLMesh? {
+        print("⚡️ Streaming Vertex Clustering: \(plyURL.lastPathComponent), grid: \(config.gridResolution)")
 
-            guard let i0 = vertexMapping[face[0]],
-                  let i1 = vertexMapping[face[1]],
-                  let i2 = vertexMapping[face[2]] else {
-                continue
-            }
+        progress?(0.0)
 
-            // Skip degenerate triangles
-            if i0 != i1 && i1 != i2 && i0 != i2 {
-                newFaces.append([i0, i1, i2])
-            }
+        guard let result = ClusteringBridge.clusterPlyFile(plyURL.path, config: makeClusterConfig(config)) else {
+            return nil
         }
 
         progress?(0.9)
-
-        print("✅ Clustered mesh: \(newVertices.count) vertices, \(newFaces.count) faces")
-
-        // Rebuild mesh
-        let result = rebuildMesh(vertices: newVertices, faces: newFaces, originalMesh: mesh)
+        let simplified = meshFromResult(result)
         progress?(1.0)
 
-        return result
+        return simplified
     }
 
     // MARK: - Helper Methods
 
-    private func extractVertices(from mesh: MDLMesh) -> [SIMD3<Double>] {
-        guard let vertexBuffer = mesh.vertexBuffers.first else { return [] }
-        guard let layout = mesh.vertexDescriptor.layouts.object(at: 0) as? MDLVertexBufferLayout else { return [] }
-
-        let strideValue = layout.stride
-        let vertexCount = vertexBuffer.length / strideValue
-        let data = Data(bytes: vertexBuffer.map().bytes, count: vertexBuffer.length)
-
-        var vertices: [SIMD3<Double>] = []
-
-        for i in 0..<vertexCount {
-            let offset = i * strideValue
-            let x = data.withUnsafeBytes { $0.load(fromByteOffset: offset, as: Float.self) }
-            let y = data.withUnsafeBytes { $0.load(fromByteOffset: offset + 4, as: Float.self) }
-            let z = data.withUnsafeBytes { $0.load(fromByteOffset: offset + 8, as: Float.self) }
-            vertices.append(SIMD3<Double>(Double(x), Double(y), Double(z)))
-        }
-
-        return vertices
+    private func makeClusterConfig(_ config: Config) -> ClusterConfig {
+        var clusterConfig = ClusterConfig()
+        clusterConfig.gridResolution = UInt(max(config.gridResolution, 1))
+        clusterConfig.cellSize = 0
+        clusterConfig.minClusterSize = UInt(max(config.minClusterSize, 0))
+        clusterConfig.centroidPositions = !config.quadricPositions
+        clusterConfig.maxCells = UInt(max(config.maxCells, 0))
+        return clusterConfig
     }
 
-    private func extractFaces(from mesh: MDLMesh) -> [[Int]] {
-        var faces: [[Int]] = []
-
-        // Safe cast - submeshes might not be [MDLSubmesh]
-        guard let submeshes = mesh.submeshes as? [MDLSubmesh] else {
-            print("⚠️ Invalid submesh format in extractFaces")
-            return []
+    /// Build the simplified mesh from a bridge result and release the result
+    private func meshFromResult(_ result: UnsafeMutablePointer<ClusterResult>) -> MDLMesh? {
+        defer {
+            ClusteringBridge.cleanupResult(result)
         }
 
-        for submesh in submeshes {
-            let indexBuffer = submesh.indexBuffer
-            let indexCount = submesh.indexCount
-            let indexType = submesh.indexType
-
-            let data = Data(bytes: indexBuffer.map().bytes, count: indexBuffer.length)
-
-            for i in stride(from: 0, to: indexCount, by: 3) {
-                var triangle: [Int] = []
-
-                for j in 0..<3 {
-                    let index: Int
-                    if indexType == .uint16 {
-                        index = Int(data.withUnsafeBytes { $0.load(fromByteOffset: (i + j) * 2, as: UInt16.self) })
-                    } else {
-                        index = Int(data.withUnsafeBytes { $0.load(fromByteOffset: (i + j) * 4, as: UInt32.self) })
-                    }
-                    triangle.append(index)
-                }
-
-                if triangle[0] != triangle[1] && triangle[1] != triangle[2] && triangle[0] != triangle[2] {
-                    faces.append(triangle)
-                }
-            }
-        }
-
-        return faces
-    }
-
-    private func computeBoundingBox(vertices: [SIMD3<Double>]) -> (min: SIMD3<Double>, max: SIMD3<Double>) {
-        guard let first = vertices.first else {
-            return (min: .zero, max: .zero)
+        // ClusterResult layout: vertices, indices, vertexCount, indexCount, success,
+        // errorMessage, occupiedCells, centroidCells, duplicateTriangles
+        let resultPtr = UnsafeRawPointer(result)
+        let pointerStride = MemoryLayout<UnsafeMutablePointer<Float>?>.stride
+        let newVertexCount = resultPtr.load(fromByteOffset: pointerStride * 2, as: Int.self)
+        let indexCount = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride, as: Int.self)
+        let success = resultPtr.load(fromByteOffset: pointerStride * 2 + MemoryLayout<Int>.stride * 2, as: Bool.self)
+
+        guard success,
+              let vertexData = resultPtr.load(as: UnsafeMutablePointer<Float>?.self),
+              let indexData = resultPtr.load(fromByteOffset: pointerStride, as: UnsafeMutablePointer<UInt32>?.self) else {
+            print("⚠️ Vertex clustering failed")
+            return nil
         }
 
-        var minBounds = first
-        var maxBounds = first
+        let statsOffset = pointerStride * 2 + MemoryLayout<Int>.stride * 3 + pointerStride
+        let occupiedCells = resultPtr.load(fromByteOffset: statsOffset, as: Int.self)
 
-        for vertex in vertices {
-            minBounds = simd_min(minBounds, vertex)
-            maxBounds = simd_max(maxBounds, vertex)
-        }
-
-        return (min: minBounds, max: maxBounds)
-    }
+        print("✅ Clustered mesh: \(newVertexCount) vertices, \(indexCount / 3) faces (\(occupiedCells) cells)")
 
-    private func computeGridCoordinate(position: SIMD3<Double>, bbox: (min: SIMD3<Double>, max: SIMD3<Double>), gridSize: SIMD3<Double>) -> SIMD3<Int> {
-        let normalized = (position - bbox.min) / gridSize
-        return SIMD3<Int>(
-            Int(floor(normalized.x)),
-            Int(floor(normalized.y)),
-            Int(floor(normalized.z))
+        return rebuildMesh(
+            vertices: UnsafeBufferPointer(start: vertexData, count: newVertexCount * 3),
+            indices: UnsafeBufferPointer(start: indexData, count: indexCount)
         )
     }
 
-    private func rebuildMesh(vertices: [SIMD3<Double>], faces: [[Int]], originalMesh: MDLMesh) -> MDLMesh? {
-        // Convert to Float
-        let vertexData = vertices.map { SIMD3<Float>(Float($0.x), Float($0.y), Float($0.z)) }
+    private func rebuildMesh(vertices: UnsafeBufferPointer<Float>, indices: UnsafeBufferPointer<UInt32>) -> MDLMesh? {
+        guard !indices.isEmpty else { return nil }
 
         let allocator = MDLMeshBufferDataAllocator()
-        let vertexBuffer = allocator.newBuffer(with: Data(bytes: vertexData, count: vertexData.count * MemoryLayout<SIMD3<Float>>.stride), type: .vertex)
+        let vertexBuffer = allocator.newBuffer(with: Data(buffer: vertices), type: .vertex)
 
         let vertexDescriptor = MDLVertexDescriptor()
         vertexDescriptor.attributes[0] = MDLVertexAttribute(
@@ -230,16 +170,10 @@ class VertexClusterSimplifier {
             offset: 0,
             bufferIndex: 0
         )
-        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: MemoryLayout<SIMD3<Float>>.stride)
+        vertexDescriptor.layouts[0] = MDLVertexBufferLayout(stride: 3 * MemoryLayout<Float>.size)
 
         // Create index buffer
-        var indices: [UInt32] = []
-        for face in faces {
-            indices.append(contentsOf: face.map { UInt32($0) })
-        }
-
-        let indexData = Data(bytes: indices, count: indices.count * MemoryLayout<UInt32>.stride)
-        let indexBuffer = allocator.newBuffer(with: indexData, type: .index)
+        let indexBuffer = allocator.newBuffer(with: Data(buffer: indices), type: .index)
 
         let submesh = MDLSubmesh(
             indexBuffer: indexBuffer,
@@ -251,7 +185,7 @@ class VertexClusterSimplifier {
 
         let mesh = MDLMesh(
             vertexBuffer: vertexBuffer,
-            vertexCount: vertexData.count,
+            vertexCount: vertices.count / 3,
             descriptor: vertexDescriptor,
             submeshes: [submesh]
         )